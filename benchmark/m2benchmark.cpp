@@ -10,7 +10,14 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 #include "midi2/adt/plru_cache.hpp"
+#include "midi2/bytestream/bytestream_to_ump.hpp"
+#include "midi2/translator.hpp"
 
 template <std::unsigned_integral T, unsigned Sets, unsigned Ways>
 static void bm_plru_cache256(benchmark::State& state) {
@@ -19,31 +26,75 @@ static void bm_plru_cache256(benchmark::State& state) {
   for (auto _ : state) {
     auto key = (count / 8) % 1024;
     for (auto ctr = T{0}; ctr < T{8}; ++ctr) {
-      cache.access(key + ctr, [count]() { return std::to_string((count + 1e6) / 3.2) + "#"; });
+      cache.access(key + ctr, [count](T, std::size_t) { return std::to_string((count + 1e6) / 3.2) + "#"; });
     }
     ++count;
   }
 }
 
-// (*) NEON optimized
+// (*) NEON and x86 SIMD optimized
+// (x) x86 SIMD optimized
 BENCHMARK(bm_plru_cache256<std::uint16_t, 4, 4>);  // (*)
 BENCHMARK(bm_plru_cache256<std::uint16_t, 4, 8>);  // (*)
 
-BENCHMARK(bm_plru_cache256<std::uint32_t, 4, 4>);  // (*)
-BENCHMARK(bm_plru_cache256<std::uint32_t, 4, 8>);
-BENCHMARK(bm_plru_cache256<std::uint32_t, 4, 16>);
-BENCHMARK(bm_plru_cache256<std::uint32_t, 2, 16>);
+BENCHMARK(bm_plru_cache256<std::uint32_t, 4, 4>);   // (*)
+BENCHMARK(bm_plru_cache256<std::uint32_t, 4, 8>);   // (x)
+BENCHMARK(bm_plru_cache256<std::uint32_t, 4, 16>);  // (x)
+BENCHMARK(bm_plru_cache256<std::uint32_t, 2, 16>);  // (x)
 
 // 256 cache entries
 BENCHMARK(bm_plru_cache256<std::uint32_t, 128, 2>);
-BENCHMARK(bm_plru_cache256<std::uint32_t, 64, 4>);  // (*)
-BENCHMARK(bm_plru_cache256<std::uint32_t, 32, 8>);
-BENCHMARK(bm_plru_cache256<std::uint32_t, 16, 16>);
+BENCHMARK(bm_plru_cache256<std::uint32_t, 64, 4>);   // (*)
+BENCHMARK(bm_plru_cache256<std::uint32_t, 32, 8>);   // (x)
+BENCHMARK(bm_plru_cache256<std::uint32_t, 16, 16>);  // (x)
 
 // 256 cache entries
 BENCHMARK(bm_plru_cache256<std::uint16_t, 128, 2>);
-BENCHMARK(bm_plru_cache256<std::uint16_t, 64, 4>);  // (*)
-BENCHMARK(bm_plru_cache256<std::uint16_t, 32, 8>);  // (*)
-BENCHMARK(bm_plru_cache256<std::uint16_t, 16, 16>);
+BENCHMARK(bm_plru_cache256<std::uint16_t, 64, 4>);   // (*)
+BENCHMARK(bm_plru_cache256<std::uint16_t, 32, 8>);   // (*)
+BENCHMARK(bm_plru_cache256<std::uint16_t, 16, 16>);  // (x)
+
+namespace {
+
+/// A 512 KiB system exclusive dump.
+std::vector<std::byte> const& sysex_dump() {
+  static std::vector<std::byte> const bytes = [] {
+    std::vector<std::byte> result(512 * 1024);
+    result.front() = std::byte{0xF0};
+    for (auto index = std::size_t{1}; index < result.size() - 1U; ++index) {
+      result[index] = static_cast<std::byte>(index % 0x80U);
+    }
+    result.back() = std::byte{0xF7};
+    return result;
+  }();
+  return bytes;
+}
+
+}  // end anonymous namespace
+
+/// Translates a system exclusive dump to UMP one byte at a time with push() and pop().
+static void bm_to_ump_push(benchmark::State& state) {
+  auto const& input = sysex_dump();
+  std::vector<std::uint32_t> output(input.size());
+  for (auto _ : state) {
+    midi2::bytestream::to_ump bs2ump;
+    auto const r = midi2::details::translate_span(bs2ump, std::span{input}, std::span{output});
+    benchmark::DoNotOptimize(r.produced);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+/// Translates a system exclusive dump to UMP with to_ump::translate().
+static void bm_to_ump_translate(benchmark::State& state) {
+  auto const& input = sysex_dump();
+  std::vector<std::uint32_t> output(input.size());
+  for (auto _ : state) {
+    midi2::bytestream::to_ump bs2ump;
+    auto const r = midi2::translate(bs2ump, std::span{input}, std::span{output});
+    benchmark::DoNotOptimize(r.produced);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(bm_to_ump_push);
+BENCHMARK(bm_to_ump_translate);
 
 BENCHMARK_MAIN();
@@ -0,0 +1,245 @@
+//===-- Segment Arena ---------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file arena.hpp
+/// \brief Provides a fixed-capacity store for a number of independently growing buffers.
+
+#ifndef MIDI2_ADT_ARENA_HPP
+#define MIDI2_ADT_ARENA_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "midi2/adt/uinteger.hpp"
+
+namespace midi2::adt {
+
+/// \brief A fixed-capacity store of (at least) \p Size elements shared by \p Segments independently growing
+///   buffers.
+///
+/// The store is divided into blocks of \p BlockSize elements. Each segment is a linked list of blocks and appending
+/// to a segment fills its last block before taking another from the pool of free blocks, so elements that have been
+/// stored are never moved by append() whatever the order in which the segments grow. gather() makes a segment's
+/// blocks adjacent so that its contents can be viewed as a single span: it does so in place by exchanging blocks
+/// with their owners and costs time proportional to the size of that segment alone.
+///
+/// An append fails only if there are too few free blocks for it. Each non-empty segment occupies a whole number of
+/// blocks so the last block of each may be partly unused.
+///
+/// \tparam ElementType  The type of the elements held by the arena. Must be trivially copyable.
+/// \tparam Segments  The number of segments.
+/// \tparam Size  The total number of elements available to all of the segments. Rounded up to a whole number of
+///   blocks.
+/// \tparam BlockSize  The number of elements in each block.
+template <typename ElementType, std::size_t Segments, std::size_t Size, std::size_t BlockSize = 32>
+  requires(Segments > 0 && Size > 0 && BlockSize > 0 && std::is_trivially_copyable_v<ElementType>)
+class arena {
+public:
+  /// The type of elements contained in the arena
+  using value_type = ElementType;
+  /// Represents the size of the container
+  using size_type = std::size_t;
+
+  /// The number of elements in each block
+  static constexpr size_type block_size = BlockSize;
+  /// The number of blocks shared by the segments
+  static constexpr size_type blocks = (Size + BlockSize - 1U) / BlockSize;
+
+  constexpr arena() noexcept {
+    // Thread all of the blocks onto the free list.
+    for (auto b = std::size_t{0}; b < blocks; ++b) {
+      links_[b] = link{.prev = b == 0U ? nil : static_cast<block_index>(b - 1U),
+                       .next = static_cast<block_index>(b + 1U)};
+      owners_[b] = free_list;
+    }
+    lists_[free_list] = list{.head = 0, .tail = static_cast<block_index>(blocks - 1U), .size = 0};
+  }
+
+  /// \brief Appends \p values to segment \p segment.
+  /// \param segment  The index of the segment to which values are appended. Must be less than Segments.
+  /// \param values  The values to be appended.
+  /// \returns True if the values were appended, false if there was insufficient space. In the latter case the
+  ///   segment is unchanged.
+  constexpr bool append(std::size_t const segment, std::span<value_type const> const values) noexcept {
+    assert(segment < Segments);
+    auto& s = lists_[segment];
+    if (blocks_for(s.size + values.size()) - blocks_for(s.size) > free_blocks_) {
+      return false;
+    }
+    for (auto rest = values; !rest.empty();) {
+      auto const offset = static_cast<std::size_t>(s.size % BlockSize);
+      if (offset == 0U) {
+        // The segment is empty or its last block is full.
+        this->push_back(segment, this->pop_free());
+      }
+      auto const count = std::min(BlockSize - offset, rest.size());
+      std::ranges::copy(rest.first(count), this->block(s.tail) + static_cast<std::ptrdiff_t>(offset));
+      s.size = static_cast<size_index>(s.size + count);
+      rest = rest.subspan(count);
+    }
+    return true;
+  }
+  /// \brief Empties segment \p segment and returns its blocks to the arena.
+  constexpr void clear(std::size_t const segment) noexcept {
+    assert(segment < Segments);
+    auto& s = lists_[segment];
+    if (s.size == 0U) {
+      return;
+    }
+    for (auto b = s.head; b != nil; b = links_[b].next) {
+      owners_[b] = free_list;
+    }
+    auto& f = lists_[free_list];
+    if (f.head == nil) {
+      f.head = s.head;
+    } else {
+      links_[f.tail].next = s.head;
+      links_[s.head].prev = f.tail;
+    }
+    f.tail = s.tail;
+    free_blocks_ += blocks_for(s.size);
+    s = list{};
+  }
+  /// \brief Makes the blocks of segment \p segment adjacent and returns its contents.
+  ///
+  /// The blocks that belonged to the segment are exchanged with those occupying the positions that it needs, so the
+  /// cost is proportional to the size of segment \p segment. The span is invalidated by any subsequent call to
+  /// append() or gather().
+  [[nodiscard]] constexpr std::span<value_type const> gather(std::size_t const segment) noexcept {
+    assert(segment < Segments);
+    auto const& s = lists_[segment];
+    auto const count = blocks_for(s.size);
+    if (count == 0U) {
+      return {};
+    }
+    auto const first = std::min(static_cast<std::size_t>(s.head), blocks - count);
+    auto b = s.head;
+    for (auto target = first; target < first + count; ++target) {
+      if (b != target) {
+        this->exchange(b, static_cast<block_index>(target));
+      }
+      b = links_[target].next;
+    }
+    return std::span<value_type const>{arr_}.subspan(first * BlockSize, s.size);
+  }
+  /// \brief Returns the number of elements held by segment \p segment.
+  [[nodiscard]] constexpr size_type size(std::size_t const segment) const noexcept {
+    assert(segment < Segments);
+    return lists_[segment].size;
+  }
+  /// \brief Returns the total number of elements that may be held by all of the segments.
+  [[nodiscard]] static constexpr size_type capacity() noexcept { return blocks * BlockSize; }
+
+private:
+  /// An unsigned integer type which can represent any block index as well as nil.
+  using block_index = uinteger_t<static_cast<unsigned>(std::bit_width(blocks))>;
+  /// An unsigned integer type which can represent the number of elements in any segment.
+  using size_index = uinteger_t<static_cast<unsigned>(std::bit_width(blocks * BlockSize))>;
+  /// An unsigned integer type which can represent any segment number as well as free_list.
+  using owner_index = uinteger_t<static_cast<unsigned>(std::bit_width(Segments))>;
+
+  /// The block index used to mark the end of a list.
+  static constexpr auto nil = static_cast<block_index>(blocks);
+  /// The index in lists_ of the list of free blocks.
+  static constexpr auto free_list = static_cast<owner_index>(Segments);
+
+  struct link {
+    block_index prev = nil;
+    block_index next = nil;
+  };
+  struct list {
+    block_index head = nil;
+    block_index tail = nil;
+    /// The number of elements in a segment. Unused by the free list.
+    size_index size = 0;
+  };
+
+  [[nodiscard]] static constexpr std::size_t blocks_for(std::size_t const elements) noexcept {
+    return (elements + BlockSize - 1U) / BlockSize;
+  }
+  [[nodiscard]] constexpr auto block(block_index const b) noexcept {
+    return arr_.begin() + static_cast<std::ptrdiff_t>(b * BlockSize);
+  }
+
+  /// Removes the first block from the free list. There must be at least one free block.
+  constexpr block_index pop_free() noexcept {
+    assert(free_blocks_ > 0U);
+    auto& f = lists_[free_list];
+    auto const b = f.head;
+    f.head = links_[b].next;
+    if (f.head == nil) {
+      f.tail = nil;
+    } else {
+      links_[f.head].prev = nil;
+    }
+    --free_blocks_;
+    return b;
+  }
+  /// Adds block \p b, which must belong to no list, to the end of segment \p segment.
+  constexpr void push_back(std::size_t const segment, block_index const b) noexcept {
+    auto& s = lists_[segment];
+    links_[b] = link{.prev = s.tail, .next = nil};
+    if (s.tail == nil) {
+      s.head = b;
+    } else {
+      links_[s.tail].next = b;
+    }
+    s.tail = b;
+    owners_[b] = static_cast<owner_index>(segment);
+  }
+
+  /// Exchanges the contents of blocks \p x and \p y along with their places in their lists (which may be the same).
+  constexpr void exchange(block_index const x, block_index const y) noexcept {
+    std::swap_ranges(this->block(x), this->block(x) + static_cast<std::ptrdiff_t>(BlockSize), this->block(y));
+    // Every reference to x must become a reference to y and vice versa. The only blocks whose links can refer to
+    // either are x, y, and their neighbours. Each is visited once: relabeling a link twice would undo it.
+    auto const relabel = [x, y](block_index& b) {
+      if (b == x) {
+        b = y;
+      } else if (b == y) {
+        b = x;
+      }
+    };
+    std::array<block_index, 6> adjacent{x, y, links_[x].prev, links_[x].next, links_[y].prev, links_[y].next};
+    std::ranges::sort(adjacent);
+    auto const last = std::ranges::unique(adjacent).begin();
+    for (auto it = adjacent.begin(); it != last && *it != nil; ++it) {
+      relabel(links_[*it].prev);
+      relabel(links_[*it].next);
+    }
+    auto const ox = owners_[x];
+    auto const oy = owners_[y];
+    relabel(lists_[ox].head);
+    relabel(lists_[ox].tail);
+    if (oy != ox) {
+      relabel(lists_[oy].head);
+      relabel(lists_[oy].tail);
+    }
+    std::swap(links_[x], links_[y]);
+    std::swap(owners_[x], owners_[y]);
+  }
+
+  /// The segments followed by the free list.
+  std::array<list, Segments + 1> lists_{};
+  std::array<link, blocks> links_{};
+  /// The list to which each block belongs.
+  std::array<owner_index, blocks> owners_{};
+  std::size_t free_blocks_ = blocks;
+  std::array<value_type, blocks * BlockSize> arr_{};
+};
+
+}  // end namespace midi2::adt
+
+#endif  // MIDI2_ADT_ARENA_HPP
@@ -0,0 +1,143 @@
+//===-- Inplace Function ------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file inplace_function.hpp
+/// \brief A polymorphic function wrapper, similar to std::function<>, which never allocates memory.
+
+#ifndef MIDI2_ADT_INPLACE_FUNCTION_HPP
+#define MIDI2_ADT_INPLACE_FUNCTION_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace midi2::adt {
+
+template <typename Signature, std::size_t Capacity = 2 * sizeof(void*)> class inplace_function;
+
+/// \brief A polymorphic function wrapper, similar to std::function<>, whose target is always stored within the
+///   object itself.
+///
+/// A callable which is too large for \p Capacity bytes (or too strictly aligned) is rejected at compile time rather
+/// than moved to the heap. Each type of target has a single, statically allocated table of operations so an instance
+/// is just the storage and a pointer to that table.
+///
+/// An empty inplace_function whose result type is void refers to a table whose invoke operation does nothing.
+/// Calling it is therefore safe and midi2::adt::call() does so without first testing whether a target is present.
+/// There is no result to give from an empty function of any other result type, so calling one is an error.
+///
+/// \tparam R  The result type of the function.
+/// \tparam Args  The argument types of the function.
+/// \tparam Capacity  The number of bytes available for the target object.
+template <typename R, typename... Args, std::size_t Capacity> class inplace_function<R(Args...), Capacity> {
+public:
+  constexpr inplace_function() noexcept = default;
+  constexpr inplace_function(std::nullptr_t) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  template <typename Function>
+    requires(!std::is_same_v<std::remove_cvref_t<Function>, inplace_function> &&
+             std::is_invocable_r_v<R, std::decay_t<Function>&, Args...>)
+  inplace_function(Function&& f)  // NOLINT(google-explicit-constructor)
+      noexcept(std::is_nothrow_constructible_v<std::decay_t<Function>, Function>) {
+    using target = std::decay_t<Function>;
+    static_assert(sizeof(target) <= Capacity, "The callable is too large for this inplace_function");
+    static_assert(alignof(target) <= alignof(void*), "The callable is too strictly aligned for inplace_function");
+    static_assert(std::is_nothrow_move_constructible_v<target>, "The callable must be nothrow move constructible");
+    ::new (static_cast<void*>(&storage_)) target(std::forward<Function>(f));
+    ops_ = &ops_for<target>;
+  }
+
+  inplace_function(inplace_function const& other) : ops_{other.ops_} { ops_->copy(&storage_, &other.storage_); }
+  inplace_function(inplace_function&& other) noexcept : ops_{other.ops_} {
+    ops_->move(&storage_, &other.storage_);
+    other.reset();
+  }
+  ~inplace_function() noexcept { ops_->destroy(&storage_); }
+
+  inplace_function& operator=(inplace_function const& other) {
+    if (&other != this) {
+      inplace_function temp{other};
+      *this = std::move(temp);
+    }
+    return *this;
+  }
+  inplace_function& operator=(inplace_function&& other) noexcept {
+    if (&other != this) {
+      ops_->destroy(&storage_);
+      ops_ = other.ops_;
+      ops_->move(&storage_, &other.storage_);
+      other.reset();
+    }
+    return *this;
+  }
+  inplace_function& operator=(std::nullptr_t) noexcept {
+    this->reset();
+    return *this;
+  }
+
+  /// \returns True if the object holds a target.
+  explicit operator bool() const noexcept { return ops_ != &empty_ops; }
+
+  /// Invokes the target. If there is no target and R is void, nothing happens; otherwise there must be a target.
+  R operator()(Args... args) const { return ops_->invoke(&storage_, std::forward<Args>(args)...); }
+
+private:
+  struct operations {
+    R (*invoke)(void*, Args&&...);
+    void (*copy)(void*, void const*);
+    void (*move)(void*, void*) noexcept;
+    void (*destroy)(void*) noexcept;
+  };
+
+  template <typename Target>
+  static constexpr operations ops_for{
+      .invoke = [](void* const s, Args&&... args) -> R {
+        return std::invoke_r<R>(*static_cast<Target*>(s), std::forward<Args>(args)...);
+      },
+      .copy = [](void* const d, void const* const s) { ::new (d) Target(*static_cast<Target const*>(s)); },
+      .move = [](void* const d, void* const s) noexcept { ::new (d) Target(std::move(*static_cast<Target*>(s))); },
+      .destroy = [](void* const s) noexcept { static_cast<Target*>(s)->~Target(); },
+  };
+  static constexpr operations empty_ops{
+      .invoke = [](void*, Args&&...) -> R {
+        if constexpr (!std::is_void_v<R>) {
+          assert(false && "empty inplace_function called");
+          std::terminate();
+        }
+      },
+      .copy = [](void*, void const*) {},
+      .move = [](void*, void*) noexcept {},
+      .destroy = [](void*) noexcept {},
+  };
+
+  void reset() noexcept {
+    ops_->destroy(&storage_);
+    ops_ = &empty_ops;
+  }
+
+  operations const* ops_ = &empty_ops;
+  alignas(void*) mutable std::byte storage_[Capacity]{};
+};
+
+/// \brief Calls an inplace_function with the given arguments. Unlike midi2::call(), there is no need to test whether
+///   the function has a target first because an empty inplace_function with a void result does nothing.
+template <typename... Params, std::size_t Capacity, typename... Args>
+  requires(std::is_invocable_v<inplace_function<void(Params...), Capacity> const&, Args...>)
+inline void call(inplace_function<void(Params...), Capacity> const& function, Args&&... args) {
+  function(std::forward<Args>(args)...);
+}
+
+}  // end namespace midi2::adt
+
+#endif  // MIDI2_ADT_INPLACE_FUNCTION_HPP
@@ -29,13 +29,10 @@
 #include <iterator>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <type_traits>
 #include <utility>
 
-#if defined(__ARM_NEON) && __ARM_NEON
-#include <arm_neon.h>
-#endif  // __ARM_NEON
-
 #include "midi2/adt/uinteger.hpp"
 
 namespace midi2::adt {
@@ -49,6 +46,8 @@ template <typename T> struct aligned_storage {
   alignas(T) std::byte v[sizeof(T)];
 };
 
+/// The tree walks in touch() and oldest() assume a complete binary tree. plru_cache requires that the number of ways
+/// is a power of two.
 template <std::size_t Ways> class tree {
 public:
   /// Flip the access bits of the tree to indicate that \p way is the most recently used member.
@@ -86,6 +85,60 @@ private:
   std::bitset<Ways - 1U> bits_{};
 };
 
+/// A specialization of the PLRU tree for up to 16 ways. The access bits are held in a single unsigned integer so
+/// that touch() becomes a table lookup and a masked merge and oldest() a fixed-length walk with no data-dependent
+/// branches.
+template <std::size_t Ways>
+  requires(Ways > 1U && Ways <= 16U)
+class tree<Ways> {
+public:
+  /// Flip the access bits of the tree to indicate that \p way is the most recently used member.
+  constexpr void touch(std::size_t const way) noexcept {
+    assert(way < Ways && "Way index is too large");
+    bits_ = static_cast<bits_type>((bits_ & ~paths_[way].mask) | paths_[way].value);
+  }
+
+  /// Traverses the tree to find the index of the oldest member.
+  [[nodiscard]] constexpr std::size_t oldest() const noexcept {
+    auto node = std::size_t{0};
+    for (auto level = 0U; level < depth_; ++level) {
+      node = 2U * node + 1U + ((bits_ >> node) & 1U);
+    }
+    return node - (Ways - 1U);
+  }
+
+  /// Resets the access bits to their initial state.
+  constexpr void reset() { bits_ = 0; }
+
+private:
+  using bits_type = uinteger_t<Ways - 1U>;
+  static constexpr auto depth_ = static_cast<unsigned>(std::bit_width(Ways - 1U));
+
+  /// The tree nodes on the path from the root to a leaf and the values that touch() assigns to them.
+  struct path {
+    bits_type mask = 0;
+    bits_type value = 0;
+  };
+  /// Builds the table of paths for each of the ways. At each level the node's bit is set if \p way lies in the
+  /// left-hand sub-tree (so that oldest() will next head right).
+  static consteval std::array<path, Ways> make_paths() noexcept {
+    std::array<path, Ways> result{};
+    for (auto way = std::size_t{0}; way < Ways; ++way) {
+      auto node = std::size_t{0};
+      for (auto level = depth_; level > 0U; --level) {
+        auto const is_less = ((way >> (level - 1U)) & 1U) == 0U;
+        result[way].mask = static_cast<bits_type>(result[way].mask | (1U << node));
+        result[way].value = static_cast<bits_type>(result[way].value | (static_cast<unsigned>(is_less) << node));
+        node = 2U * node + 1U + static_cast<unsigned>(!is_less);
+      }
+    }
+    return result;
+  }
+  static constexpr auto paths_ = make_paths();
+
+  bits_type bits_ = 0;
+};
+
 /// \brief Used to store keys in the cache.
 ///
 /// We don't store the key directly in this struct: some of the bits are determined by the key's set so don't need to
@@ -125,72 +178,36 @@ template <std::unsigned_integral Key, unsigned SetBits, unsigned Ways> struct ma
   }
 };
 
-#if defined(__ARM_NEON) && __ARM_NEON
-template <std::unsigned_integral Key, unsigned SetBits>
-  requires(std::is_same_v<typename tagged_key<Key, SetBits>::value_type, std::uint16_t>)
-struct match_finder<Key, SetBits, 4> {
-  using tagged_key_type = tagged_key<Key, SetBits>;
-
-  static constexpr std::size_t find(tagged_key_type const new_tag,
-                                    std::array<tagged_key_type, 4> const& values) noexcept {
-    uint16x4_t const a = vdup_n_u16(new_tag.get());
-    uint16x4_t const b = vld1_u16(std::bit_cast<std::uint16_t const*>(values.data()));
-
-    uint16x4_t const cmp = vceq_u16(a, b);  // Compare lanes: 0xFFFF if equal
-    std::uint64_t const packed = vget_lane_u64(vreinterpret_u64_u16(cmp), 0);
-    std::uint64_t const nz_or = packed | (static_cast<std::uint64_t>(packed == 0) << 63);
-    return (static_cast<std::size_t>(static_cast<unsigned>(std::countr_zero(nz_or)) + 1U)) >> 3;
-  }
-};
-
-template <std::unsigned_integral Key, unsigned SetBits>
-  requires(std::is_same_v<typename tagged_key<Key, SetBits>::value_type, std::uint16_t>)
-struct match_finder<Key, SetBits, 8> {
-  using tagged_key_type = tagged_key<Key, SetBits>;
-
-  static constexpr std::size_t find(tagged_key_type const new_tag,
-                                    std::array<tagged_key_type, 8> const& values) noexcept {
-    uint16x8_t const a = vdupq_n_u16(new_tag.get());
-    uint16x8_t const b = vld1q_u16(std::bit_cast<std::uint16_t const*>(values.data()));
-
-    uint16x8_t const cmp = vceqq_u16(a, b);   // Compare lanes: 0xFFFF if equal
-    uint8x8_t const narrow = vmovn_u16(cmp);  // Narrow to 8-bit: 0xFF if equal, 0x00 if not
-    std::uint64_t const packed =
-        vget_lane_u64(vreinterpret_u64_u8(narrow), 0);  // Treat 8 lanes as a single 64-bit scalar
-
-    // Extract the matching lane by counting trailing groups of 8 bits. If packed is zero, no lane matched.
-    // For nonzero packed: ctz = 8*i (i = matching lane).
-    // For zero packed:    ctz = 63  -> (ctz+1)>>3 = 8  (no match).
-    std::uint64_t const nz_or = packed | (static_cast<std::uint64_t>(packed == 0) << 63);
-    return (static_cast<std::size_t>(static_cast<unsigned>(std::countr_zero(nz_or)) + 1U)) >> 3;
-  }
-};
-
-template <std::unsigned_integral Key, unsigned SetBits>
-  requires(std::is_same_v<typename tagged_key<Key, SetBits>::value_type, std::uint32_t>)
-struct match_finder<Key, SetBits, 4> {
+/// \brief Returns the index of the first element of \p lanes equal to \p tag or lanes.size() if there is none.
+///
+/// These are defined in plru_cache.cpp so that the vector instructions they use are chosen when the library is
+/// compiled and do not depend on the options used to compile each user of the cache.
+[[nodiscard]] std::size_t find_lane(std::uint16_t tag, std::span<std::uint16_t const> lanes) noexcept;
+[[nodiscard]] std::size_t find_lane(std::uint32_t tag, std::span<std::uint32_t const> lanes) noexcept;
+
+/// A specialization of match_finder for tagged keys with 16- or 32-bit lanes and 4, 8, or 16 ways. Outside of
+/// constant evaluation, the ways are compared with vector instructions where the library's target has them.
+template <std::unsigned_integral Key, unsigned SetBits, unsigned Ways>
+  requires((Ways == 4 || Ways == 8 || Ways == 16) &&
+           (std::is_same_v<typename tagged_key<Key, SetBits>::value_type, std::uint16_t> ||
+            std::is_same_v<typename tagged_key<Key, SetBits>::value_type, std::uint32_t>))
+struct match_finder<Key, SetBits, Ways> {
   using tagged_key_type = tagged_key<Key, SetBits>;
+  using value_type = tagged_key_type::value_type;
+  static_assert(sizeof(tagged_key_type) == sizeof(value_type));
 
+  /// \return The lane index [0..Ways) if a match is found, or Ways if no match
   static constexpr std::size_t find(tagged_key_type const new_tag,
-                                    std::array<tagged_key_type, 4> const& values) noexcept {
-    uint32x4_t const a = vdupq_n_u32(new_tag.get());
-    uint32x4_t const b = vld1q_u32(std::bit_cast<std::uint32_t const*>(values.data()));
-
-    uint32x4_t const cmp = vceqq_u32(a, b);    // Compare lanes: 0xFFFF if equal
-    uint16x4_t const narrow = vmovn_u32(cmp);  // Narrow to 8-bit: 0xFF if equal, 0x00 if not
-    std::uint64_t const packed =
-        vget_lane_u64(vreinterpret_u64_u16(narrow), 0);  // Treat 4b lanes as a single 64-bit scalar
-
-    // Extract the matching lane by counting trailing groups of 8 bits. If packed is zero, no lane matched.
-    // For nonzero packed: ctz = 8*i (i = matching lane).
-    // For zero packed:    ctz = 63  -> (ctz+1)>>3 = 8  (no match).
-    std::uint64_t const nz_or = packed | (static_cast<std::uint64_t>(packed == 0) << 63);
-    return (static_cast<unsigned>(std::countr_zero(nz_or)) + 1U) / 16U;
+                                    std::array<tagged_key_type, Ways> const& values) noexcept {
+    if consteval {
+      return static_cast<std::size_t>(std::ranges::find(values, new_tag) - values.begin());
+    } else {
+      return find_lane(new_tag.get(),
+                       std::span<value_type const, Ways>{std::bit_cast<value_type const*>(values.data()), Ways});
+    }
   }
 };
 
-#endif  // __ARM_NEON
-
 template <std::unsigned_integral Key, typename MappedType, unsigned SetBits, std::size_t Ways> class cache_set {
   using tagged_key_type = tagged_key<Key, SetBits>;
 
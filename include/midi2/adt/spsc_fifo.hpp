@@ -0,0 +1,184 @@
+//===-- SPSC FIFO -------------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file spsc_fifo.hpp
+/// \brief  Provides a wait-free single-producer/single-consumer FIFO.
+
+#ifndef MIDI2_SPSC_FIFO_HPP
+#define MIDI2_SPSC_FIFO_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#include "midi2/adt/uinteger.hpp"
+#include "midi2/utils.hpp"
+
+namespace midi2::adt {
+
+/// \brief A wait-free FIFO/circular buffer containing a maximum of \p Elements instances of type \p ElementType
+///        which may be shared between exactly one producer thread and one consumer thread.
+///
+/// Like fifo<>, full and empty are distinguished by using one more bit for the read and write indices than is needed
+/// to address the elements: the FIFO is empty when the indices are equal and full when they differ only in that
+/// extra "wrap" bit.
+///
+/// The producer owns the write index and the consumer the read index. Each is an atomic held on its own cache line
+/// together with that thread's cached copy of the other index, so a thread only touches the other side's cache line
+/// when its cached value suggests that the FIFO is full (producer) or empty (consumer). No member function allocates
+/// memory or blocks, making the container suitable for use in real-time callbacks.
+///
+/// push_back() may only be called by the producer and pop_front() only by the consumer. The observers empty(), full(),
+/// and size() may be called from either thread but their result is necessarily a snapshot.
+///
+/// \tparam ElementType The type of the elements held by this container. Must be trivially copyable and default
+///   constructible.
+/// \tparam Elements The number of elements in the FIFO. Must be a power of two.
+template <typename ElementType, std::size_t Elements>
+  requires(Elements > 1 && is_power_of_two(Elements) && std::is_trivially_copyable_v<ElementType> &&
+           std::is_default_constructible_v<ElementType>)
+class spsc_fifo {
+public:
+  /// The type of elements contained in the FIFO
+  using value_type = ElementType;
+  /// Represents the size of the container
+  using size_type = std::size_t;
+
+  constexpr spsc_fifo() noexcept = default;
+  spsc_fifo(spsc_fifo const&) = delete;
+  spsc_fifo(spsc_fifo&&) noexcept = delete;
+  ~spsc_fifo() noexcept = default;
+
+  spsc_fifo& operator=(spsc_fifo const&) = delete;
+  spsc_fifo& operator=(spsc_fifo&&) noexcept = delete;
+
+  /// \brief Inserts an element at the end. May only be called by the producer.
+  /// \param value  The value of the element to append.
+  /// \returns True if the element was appended, false if the container was full.
+  bool push_back(value_type const& value) noexcept {
+    return this->push_back(std::span<value_type const, 1>{&value, 1}) == 1U;
+  }
+  /// \brief Appends as many elements from \p values as there is space for. May only be called by the producer.
+  /// \param values  The values to append.
+  /// \returns The number of elements appended. This is the length of a prefix of \p values.
+  size_type push_back(std::span<value_type const> values) noexcept {
+    auto const w = producer_.index.load(std::memory_order_relaxed);
+    auto available = capacity(w, producer_.cache);
+    if (available < values.size()) {
+      // Refresh our view of the read index and try again.
+      producer_.cache = consumer_.index.load(std::memory_order_acquire);
+      available = capacity(w, producer_.cache);
+    }
+    auto const n = std::min(available, values.size());
+    copy_in(w, values.first(n));
+    producer_.index.store(static_cast<index_type>((w + n) & index_mask_), std::memory_order_release);
+    return n;
+  }
+
+  /// \brief Removes the first element of the container and returns it. May only be called by the consumer.
+  /// \returns The first element in the container or std::nullopt if the container was empty.
+  std::optional<value_type> pop_front() noexcept {
+    value_type result{};
+    if (this->pop_front(std::span<value_type, 1>{&result, 1}) == 0U) {
+      return std::nullopt;
+    }
+    return result;
+  }
+  /// \brief Removes elements from the front of the container and copies them to \p out. May only be called by the
+  ///        consumer.
+  /// \param out  The span to which removed elements are written.
+  /// \returns The number of elements removed. This is at most the size of \p out.
+  size_type pop_front(std::span<value_type> out) noexcept {
+    auto const r = consumer_.index.load(std::memory_order_relaxed);
+    auto available = distance(r, consumer_.cache);
+    if (available < out.size()) {
+      // Refresh our view of the write index and try again.
+      consumer_.cache = producer_.index.load(std::memory_order_acquire);
+      available = distance(r, consumer_.cache);
+    }
+    auto const n = std::min(available, out.size());
+    copy_out(r, out.first(n));
+    consumer_.index.store(static_cast<index_type>((r + n) & index_mask_), std::memory_order_release);
+    return n;
+  }
+
+  /// \brief Checks whether the container is empty.
+  /// \returns True if the container is empty, false otherwise.
+  [[nodiscard]] bool empty() const noexcept { return this->size() == 0U; }
+  /// \brief Checks whether the container is full.
+  /// \returns True if the container is full, false otherwise.
+  [[nodiscard]] bool full() const noexcept { return this->size() == Elements; }
+  /// \brief Returns the number of elements held by the container.
+  /// \returns The number of elements held by the container.
+  [[nodiscard]] size_type size() const noexcept {
+    auto const r = consumer_.index.load(std::memory_order_acquire);
+    return distance(r, producer_.index.load(std::memory_order_acquire));
+  }
+  /// \brief Returns the maximum possible number of elements.
+  /// \returns The maximum possible number of elements that can be held by the container.
+  [[nodiscard]] static constexpr size_type max_size() noexcept { return Elements; }
+
+private:
+  /// The number of bits required to represent the maximum index in the arr_ container.
+  static constexpr auto bits_ = static_cast<unsigned>(std::bit_width(Elements - 1U));
+  /// An unsigned integer type which can hold an index plus the extra "wrap" bit.
+  using index_type = uinteger_t<bits_ + 1U>;
+  static_assert(std::atomic<index_type>::is_always_lock_free);
+  static constexpr auto mask_ = std::size_t{Elements - 1U};
+  static constexpr auto index_mask_ = std::size_t{(Elements << 1U) - 1U};
+
+  /// A conservative estimate of the size of a cache line. std::hardware_destructive_interference_size is not used
+  /// because its value may vary between compilations and GCC warns about its use in headers.
+  static constexpr std::size_t cache_line_size = 64;
+
+  /// \returns The number of elements between read index \p r and write index \p w.
+  [[nodiscard]] static constexpr size_type distance(std::size_t const r, std::size_t const w) noexcept {
+    return (w - r) & index_mask_;
+  }
+  /// \returns The number of free slots given write index \p w and read index \p r.
+  [[nodiscard]] static constexpr size_type capacity(std::size_t const w, std::size_t const r) noexcept {
+    return Elements - distance(r, w);
+  }
+
+  /// Copies \p values into the array starting at index \p w. The copy is split in two if it wraps.
+  void copy_in(std::size_t const w, std::span<value_type const> values) noexcept {
+    auto const first = w & mask_;
+    auto const n1 = std::min(values.size(), Elements - first);
+    std::ranges::copy(values.first(n1), arr_.begin() + static_cast<std::ptrdiff_t>(first));
+    std::ranges::copy(values.subspan(n1), arr_.begin());
+  }
+  /// Copies elements starting at index \p r to \p out. The copy is split in two if it wraps.
+  void copy_out(std::size_t const r, std::span<value_type> out) const noexcept {
+    auto const first = r & mask_;
+    auto const n1 = std::min(out.size(), Elements - first);
+    auto const begin = arr_.begin() + static_cast<std::ptrdiff_t>(first);
+    std::ranges::copy(begin, begin + static_cast<std::ptrdiff_t>(n1), out.begin());
+    std::ranges::copy(arr_.begin(), arr_.begin() + static_cast<std::ptrdiff_t>(out.size() - n1),
+                      out.begin() + static_cast<std::ptrdiff_t>(n1));
+  }
+
+  /// The index owned by one side of the FIFO together with that side's cached copy of the other side's index.
+  struct alignas(cache_line_size) side {
+    std::atomic<index_type> index{0};
+    index_type cache = 0;
+  };
+  side producer_;
+  side consumer_;
+  alignas(cache_line_size) std::array<value_type, Elements> arr_{};
+};
+
+}  // end namespace midi2::adt
+
+#endif  // MIDI2_SPSC_FIFO_HPP
@@ -14,11 +14,11 @@
 #ifndef MIDI2_BYTESTREAM_TO_UMP_HPP
 #define MIDI2_BYTESTREAM_TO_UMP_HPP
 
-#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "midi2/adt/fifo.hpp"
 #include "midi2/translator.hpp"
@@ -62,6 +62,17 @@ public:
   /// \param b The byte of input to be translated
   void push(input_type b) noexcept;
 
+  /// \brief Translates a span of MIDI 1.0 input bytes to UMP message words.
+  ///
+  /// The result is identical to calling push() for each input byte and pop() until empty(). Normally called via
+  /// midi2::translate().
+  ///
+  /// \param input  The bytes of input to be translated
+  /// \param output  The span to which UMP message words are written
+  /// \returns The number of bytes consumed from \p input and words written to \p output
+  translate_result<std::span<output_type>::iterator> translate(std::span<input_type const> input,
+                                                               std::span<output_type> output) noexcept;
+
   /// \brief Restore the translator to its original state.
   /// Any in-flight messages are lost.
   void reset() noexcept;
@@ -85,19 +96,24 @@ private:
     /// System exclusive message bytes gathered for the current UMP
     std::array<std::byte, 6> bytes{};
 
+    /// Resets the state. The bytes array is not cleared: bytes beyond \p pos are ignored when a UMP is built.
     void reset() noexcept {
       state = sysex7::status::none;
       pos = 0;
-      std::ranges::fill(bytes, std::byte{0U});
     }
   };
   sysex7 sysex7_;
   adt::fifo<std::uint32_t, 4> output_;
 
+  [[nodiscard]] output_type message(std::byte b0, std::byte b1, std::byte b2) const noexcept;
   void convert(std::byte b0, std::byte b1, std::byte b2) noexcept;
 
+  template <ump::mt::data64 T, typename Function> void sysex7_words(Function function) const noexcept;
   template <ump::mt::data64 T> void push_sysex7() noexcept;
   void sysex_data_byte(std::byte b) noexcept;
+
+  translate_result<std::span<output_type>::iterator> translate_data(std::span<input_type const> data,
+                                                                    std::span<output_type> output) noexcept;
 };
 
 static_assert(translator<std::byte, std::uint32_t, to_ump>);
@@ -12,11 +12,14 @@
 #define MIDI2_CI_CI7TEXT_HPP
 
 // Standard library
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <span>
 #include <type_traits>
 
 // icubaby library
@@ -25,6 +28,55 @@
 // local includes
 #include "midi2/utils.hpp"
 
+namespace midi2::ci::details {
+
+/// \brief Returns the number of bytes at the start of \p str which are below 0x80 and are not a backslash.
+///
+/// This is defined in ci7text.cpp so that the vector instructions it uses are chosen when the library is compiled.
+///
+/// \param str  The bytes to be searched.
+/// \returns The index of the first byte which must be escaped (or is malformed) or the size of \p str.
+[[nodiscard]] std::size_t plain_ascii_bytes(std::span<std::byte const> str) noexcept;
+
+/// \brief Returns the number of code units at the start of \p str which are passed through CI 7-bit text unchanged.
+///
+/// These are the characters below U+0080 other than backslash. Single-byte code units are tested a block at a time.
+///
+/// \param str  The code units to be searched.
+/// \returns The index of the first code unit which must be escaped (or is malformed) or the size of \p str.
+template <typename CharType> [[nodiscard]] std::size_t plain_ascii_run(std::span<CharType const> const str) noexcept {
+  if constexpr (sizeof(CharType) == 1) {
+    return plain_ascii_bytes(std::as_bytes(str));
+  } else {
+    auto index = std::size_t{0};
+    for (; index < str.size(); ++index) {
+      auto const c = static_cast<std::make_unsigned_t<CharType>>(str[index]);
+      if (c >= 0x80U || c == '\\') {
+        break;
+      }
+    }
+    return index;
+  }
+}
+
+/// \brief Copies a run of code units which need no conversion.
+/// \param run  The code units to be copied. All must be less than U+0080.
+/// \param dest  An output iterator to which the code units are written.
+/// \returns  Iterator one past the last element assigned.
+template <typename OutputType, typename InputType, std::output_iterator<OutputType> OutputIterator>
+OutputIterator copy_ascii(std::span<InputType const> const run, OutputIterator dest) {
+  if constexpr (sizeof(InputType) == sizeof(OutputType) && std::is_same_v<OutputIterator, OutputType*>) {
+    if (!run.empty()) {
+      std::memcpy(dest, run.data(), run.size());
+    }
+    return dest + run.size();
+  } else {
+    return std::ranges::transform(run, dest, [](InputType const c) { return static_cast<OutputType>(c); }).out;
+  }
+}
+
+}  // end namespace midi2::ci::details
+
 namespace icubaby {
 
 template <unicode_char_type InputEncoding> class transcoder<InputEncoding, char> {
@@ -55,6 +107,31 @@ public:
     return dest;
   }
 
+  /// Transcodes a span of code units. The output is identical to passing each member of \p input to
+  /// \ref transcoder-call-operator "operator()", but runs of ASCII characters which need no escaping are copied
+  /// directly.
+  ///
+  /// \tparam OutputIterator  An output iterator type to which values of type transcoder::output_type can be written.
+  /// \param input  The code units in the source encoding.
+  /// \param dest  An output iterator to which the output sequence is written.
+  /// \returns  Iterator one past the last element assigned.
+  template <std::output_iterator<output_type> OutputIterator>
+  OutputIterator transcode(std::span<input_type const> input, OutputIterator dest) noexcept {
+    while (!input.empty()) {
+      if (!this->partial()) {
+        auto const run = input.first(midi2::ci::details::plain_ascii_run(input));
+        dest = midi2::ci::details::copy_ascii<output_type>(run, dest);
+        input = input.subspan(run.size());
+        if (input.empty()) {
+          break;
+        }
+      }
+      dest = (*this)(input.front(), dest);
+      input = input.subspan(1);
+    }
+    return dest;
+  }
+
   /// Call once the entire input sequence has been fed to \ref transcoder-call-operator "operator()". This function
   /// ensures that the sequence did not end with a partial code point.
   ///
@@ -166,6 +243,34 @@ public:
     return dest;
   }
 
+  /// Transcodes a span of code units. The output is identical to passing each member of \p input to
+  /// \ref transcoder-call-operator "operator()", but runs of ASCII characters outside of an escape sequence are
+  /// copied directly.
+  ///
+  /// \tparam OutputIterator  An output iterator type to which values of type transcoder::output_type can be written.
+  /// \param input  The code units in the source encoding.
+  /// \param dest  An output iterator to which the output sequence is written.
+  /// \returns  Iterator one past the last element assigned.
+  template <std::output_iterator<output_type> OutputIterator>
+  OutputIterator transcode(std::span<input_type const> input, OutputIterator dest) noexcept {
+    while (!input.empty()) {
+      if (state_ == state::normal) {
+        if (auto const run = input.first(midi2::ci::details::plain_ascii_run(input)); !run.empty()) {
+          // A preceding \u escape may have left an unpaired high surrogate.
+          dest = hex_to_32_.end_cp(dest);
+          dest = midi2::ci::details::copy_ascii<output_type>(run, dest);
+          input = input.subspan(run.size());
+          if (input.empty()) {
+            break;
+          }
+        }
+      }
+      dest = (*this)(input.front(), dest);
+      input = input.subspan(1);
+    }
+    return dest;
+  }
+
   /// Call once the entire input sequence has been fed to \ref transcoder-call-operator "operator()". This function
   /// ensures that the sequence did not end with a partial code point.
   ///
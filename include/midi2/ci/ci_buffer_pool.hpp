@@ -0,0 +1,104 @@
+//===-- CI Buffer Pool --------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_buffer_pool.hpp
+/// \brief A pool of message buffers which may be shared by many MIDI-CI dispatchers.
+
+#ifndef MIDI2_CI_BUFFER_POOL_HPP
+#define MIDI2_CI_BUFFER_POOL_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+#include "midi2/adt/uinteger.hpp"
+
+namespace midi2::ci {
+
+/// \brief A fixed set of \p Buffers message buffers, each of \p BufferSize bytes, which are shared by a number of
+///   ci_dispatcher instances.
+///
+/// A dispatcher whose configuration has a buffer_pool member takes a buffer from the pool once it has received the
+/// header of a message that it will process and returns the buffer as soon as the message has been handled. The
+/// memory needed by a large number of dispatchers (for example, one for each group of each port on a gateway) is
+/// therefore determined by the number of messages that are in flight at once rather than by the number of
+/// dispatchers. When every buffer is in use, the dispatcher reports the message to its system.buffer_overflow
+/// handler and discards it.
+///
+/// The buffers are part of the pool object itself. The pool is not thread-safe.
+///
+/// \tparam BufferSize  The size of each buffer in bytes.
+/// \tparam Buffers  The number of buffers in the pool.
+template <std::size_t BufferSize, std::size_t Buffers>
+  requires(BufferSize > 0 && Buffers > 0)
+class buffer_pool {
+public:
+  /// The size of each buffer in bytes.
+  static constexpr auto buffer_size = BufferSize;
+
+  constexpr buffer_pool() noexcept {
+    for (auto index = std::size_t{0}; index < Buffers; ++index) {
+      free_[index] = static_cast<index_type>(index);
+    }
+  }
+  buffer_pool(buffer_pool const&) = delete;
+  buffer_pool(buffer_pool&&) noexcept = delete;
+  ~buffer_pool() noexcept = default;
+
+  buffer_pool& operator=(buffer_pool const&) = delete;
+  buffer_pool& operator=(buffer_pool&&) noexcept = delete;
+
+  /// \brief Takes a buffer from the pool.
+  /// \returns A buffer of buffer_size bytes or an empty span if every buffer is in use.
+  [[nodiscard]] constexpr std::span<std::byte> acquire() noexcept {
+    if (available_ == 0U) {
+      ++exhausted_;
+      return {};
+    }
+    auto const index = std::size_t{free_[--available_]};
+    high_water_mark_ = std::max(high_water_mark_, this->in_use());
+    return std::span{storage_}.subspan(index * BufferSize, BufferSize);
+  }
+  /// \brief Returns a buffer to the pool.
+  /// \param buffer  A buffer previously returned by acquire().
+  constexpr void release(std::span<std::byte> const buffer) noexcept {
+    assert(buffer.size() == BufferSize && buffer.data() >= storage_.data() &&
+           buffer.data() < storage_.data() + storage_.size() && "buffer was not acquired from this pool");
+    assert(available_ < Buffers);
+    auto const offset = static_cast<std::size_t>(buffer.data() - storage_.data());
+    free_[available_++] = static_cast<index_type>(offset / BufferSize);
+  }
+
+  /// \returns The total number of buffers in the pool.
+  [[nodiscard]] static constexpr std::size_t capacity() noexcept { return Buffers; }
+  /// \returns The number of buffers currently in use.
+  [[nodiscard]] constexpr std::size_t in_use() const noexcept { return Buffers - available_; }
+  /// \returns The largest number of buffers that have been in use at once.
+  [[nodiscard]] constexpr std::size_t high_water_mark() const noexcept { return high_water_mark_; }
+  /// \returns The number of requests for a buffer that failed because every buffer was in use.
+  [[nodiscard]] constexpr std::size_t exhausted() const noexcept { return exhausted_; }
+
+private:
+  using index_type = adt::uinteger_t<static_cast<unsigned>(std::bit_width(Buffers))>;
+
+  /// A stack of the indices of the buffers that are not in use. The first available_ entries are valid.
+  std::array<index_type, Buffers> free_{};
+  std::size_t available_ = Buffers;
+  std::size_t high_water_mark_ = 0;
+  std::size_t exhausted_ = 0;
+  std::array<std::byte, BufferSize * Buffers> storage_{};
+};
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_BUFFER_POOL_HPP
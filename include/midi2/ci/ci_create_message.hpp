@@ -12,8 +12,11 @@
 #define MIDI2_CI_CREATE_MESSAGE_HPP
 
 #include <algorithm>
+#include <array>
 #include <bit>
+#include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <span>
@@ -298,6 +301,11 @@ constexpr O write_pe(O first, S const last, header const& hdr, property_exchange
   return first;
 }
 
+/// \brief A buffer for create_message() which can hold a message of up to \p Size bytes.
+/// create_message() returns the end of its output range when the message does not fit, so a message which exactly
+/// fills the range cannot be told apart from one which overflowed. The buffer therefore has a spare byte.
+template <std::size_t Size> using create_message_buffer = std::array<std::byte, Size + 1U>;
+
 }  // end namespace details
 
 struct trivial_sentinel {
@@ -406,6 +414,116 @@ constexpr O create_message(O first, S const last, header const& hdr, property_ex
   return details::write_pe(first, last, hdr, pe, details::type_to_packed<std::remove_cvref_t<decltype(pe)>>::id);
 }
 
+/// \brief Generates the chunks of a Property Exchange message on demand so that each fits within the receiver's
+///   maximum System Exclusive message size.
+///
+/// The property header is sent in the first chunk only and the property data is divided between as many chunks as
+/// necessary. Each call to next() writes a single chunk to a buffer supplied by the caller, so only one chunk need
+/// exist at a time and the caller controls the rate at which chunks are produced. The header and data spans must
+/// remain valid until the last chunk has been written.
+///
+/// \tparam Pet  The type of Property Exchange message to be generated.
+template <property_exchange::property_exchange_type Pet> class property_exchange_chunker {
+public:
+  /// \param hdr  The MIDI CI header for each of the chunks.
+  /// \param pe  The message to be sent. Its chunk member is ignored.
+  /// \param max_sysex_size  The receiver's maximum System Exclusive message size (including the F0 and F7 bytes) as
+  ///   reported by its Discovery or Discovery Reply message.
+  constexpr property_exchange_chunker(struct header const& hdr, property_exchange::property_exchange<Pet> const& pe,
+                                      b28 const max_sysex_size) noexcept
+      : hdr_{hdr}, request_{pe.request}, header_{pe.header}, data_{pe.data} {
+    auto const limit = static_cast<std::size_t>(max_sysex_size.get());
+    if (limit < overhead_ + header_.size()) {
+      return;  // Not even the property header can be sent.
+    }
+    first_capacity_ = std::min(limit - overhead_ - header_.size(), max_data_length_);
+    capacity_ = std::min(limit - overhead_, max_data_length_);
+    auto chunks = std::size_t{1};
+    if (data_.size() > first_capacity_) {
+      if (capacity_ == 0U) {
+        return;  // No chunk has room for any data.
+      }
+      chunks += (data_.size() - first_capacity_ + capacity_ - 1U) / capacity_;
+    }
+    if (chunks <= max_data_length_) {
+      number_of_chunks_ = static_cast<std::uint16_t>(chunks);
+    }
+  }
+
+  /// \returns True if the message can be sent within the receiver's size limit.
+  [[nodiscard]] constexpr bool valid() const noexcept { return number_of_chunks_ > 0U; }
+  /// \returns The total number of chunks in the message or 0 if the message cannot be sent.
+  [[nodiscard]] constexpr std::size_t number_of_chunks() const noexcept { return number_of_chunks_; }
+  /// \returns True if every chunk has been written (or the message cannot be sent).
+  [[nodiscard]] constexpr bool done() const noexcept { return chunk_number_ >= number_of_chunks_; }
+  /// \returns The size in bytes of the largest chunk. A buffer of this size is sufficient for every call to next().
+  [[nodiscard]] constexpr std::size_t max_chunk_size() const noexcept {
+    return this->valid() ? this->chunk_size(0U) : 0U;
+  }
+
+  /// \brief Writes the next chunk to \p buffer.
+  /// \param buffer  The buffer to which the chunk is written. This does not include the F0 and F7 bytes.
+  /// \returns The portion of \p buffer that holds the chunk. This is empty if all of the chunks have already been
+  ///   written or if \p buffer is too small, in which case the chunk will be written by the next call.
+  constexpr std::span<std::byte> next(std::span<std::byte> const buffer) {
+    if (this->done()) {
+      return {};
+    }
+    auto const size = this->chunk_size(chunk_number_);
+    if (buffer.size() < size) {
+      return {};
+    }
+    auto const first = chunk_number_ == 0U;
+    auto const data_size = std::min(data_.size() - offset_, first ? first_capacity_ : capacity_);
+    auto const pe = property_exchange::property_exchange<Pet>::make(
+        {.number_of_chunks = b14{number_of_chunks_}, .chunk_number = b14{chunk_number_ + 1U}}, request_,
+        first ? header_ : std::span<char const>{}, data_.subspan(offset_, data_size));
+    auto const* const end = details::write_pe(buffer.data(), trivial_sentinel{}, hdr_, pe,
+                                              details::type_to_packed<property_exchange::property_exchange<Pet>>::id);
+    assert(end == buffer.data() + size);
+    (void)end;
+    offset_ += data_size;
+    ++chunk_number_;
+    return buffer.first(size);
+  }
+
+private:
+  /// The maximum value of a 14 bit field.
+  static constexpr auto max_data_length_ = std::size_t{(1U << 14) - 1U};
+  /// The number of bytes in each chunk other than the property header and data, including the F0 and F7 bytes.
+  static constexpr auto overhead_ = 2U + sizeof(packed::header) +
+                                    offsetof(property_exchange::packed::property_exchange_pt1, header) +
+                                    offsetof(property_exchange::packed::property_exchange_pt2, data);
+
+  /// \returns The size of chunk \p index (counting from 0) excluding the F0 and F7 bytes.
+  [[nodiscard]] constexpr std::size_t chunk_size(std::size_t const index) const noexcept {
+    auto const fixed = overhead_ - 2U;
+    if (index == 0U) {
+      return fixed + header_.size() + std::min(data_.size(), first_capacity_);
+    }
+    auto const offset = first_capacity_ + (index - 1U) * capacity_;
+    return fixed + std::min(data_.size() - offset, capacity_);
+  }
+
+  struct header hdr_;
+  b7 request_;
+  std::span<char const> header_;
+  std::span<char const> data_;
+  /// The number of data bytes carried by the first chunk.
+  std::size_t first_capacity_ = 0;
+  /// The number of data bytes carried by each subsequent chunk.
+  std::size_t capacity_ = 0;
+  /// The offset within data_ of the next chunk's data.
+  std::size_t offset_ = 0;
+  std::uint16_t number_of_chunks_ = 0;
+  /// The number of chunks written so far.
+  std::uint16_t chunk_number_ = 0;
+};
+
+template <property_exchange::property_exchange_type Pet>
+property_exchange_chunker(struct header const&, property_exchange::property_exchange<Pet> const&, b28)
+    -> property_exchange_chunker<Pet>;
+
 }  // end namespace midi2::ci
 
 #endif  // MIDI2_CI_CREATE_MESSAGE_HPP
@@ -0,0 +1,288 @@
+//===-- CI Discovery Responder ------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_discovery_responder.hpp
+/// \brief Answers MIDI-CI Discovery and Inquiry: Endpoint messages from pre-serialized replies, coalescing repeated
+///   requests and limiting the rate at which replies are sent.
+
+#ifndef MIDI2_CI_DISCOVERY_RESPONDER_HPP
+#define MIDI2_CI_DISCOVERY_RESPONDER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_types.hpp"
+
+namespace midi2::ci {
+
+/// \brief Limits the rate at which replies are sent to a port.
+///
+/// A port which serves several local identities has one limiter which is passed to the flush() member function of
+/// each of their discovery_responder instances, so that the total output to the port is bounded. The limiter is a
+/// generic cell rate algorithm: it records the theoretical time at which the next reply would be sent were replies
+/// sent at exactly the configured rate, and a reply may go out early by up to (burst - 1) intervals.
+///
+/// \tparam Clock  The clock used to measure the rate.
+template <typename Clock = std::chrono::steady_clock> class reply_rate_limiter {
+public:
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+  /// Constructs a limiter which imposes no limit.
+  constexpr reply_rate_limiter() noexcept = default;
+  /// \param interval  The minimum average time between replies. Zero removes the limit.
+  /// \param burst  The number of replies that may be sent back-to-back after a quiet period.
+  constexpr explicit reply_rate_limiter(duration const interval, std::size_t const burst = 1) noexcept {
+    this->rate(interval, burst);
+  }
+
+  /// \brief Changes the rate at which replies may be sent.
+  /// \param interval  The minimum average time between replies. Zero removes the limit.
+  /// \param burst  The number of replies that may be sent back-to-back after a quiet period.
+  constexpr reply_rate_limiter& rate(duration const interval, std::size_t const burst = 1) noexcept {
+    assert(burst > 0U);
+    interval_ = interval;
+    burst_ = burst;
+    return *this;
+  }
+  /// \brief Claims permission to send a reply at time \p now.
+  /// \returns True if the reply may be sent, false if it must wait.
+  constexpr bool acquire(time_point const now) noexcept {
+    if (interval_ == duration::zero()) {
+      return true;
+    }
+    auto const tolerance = interval_ * static_cast<typename duration::rep>(burst_ - 1U);
+    if (now < tat_ - tolerance) {
+      return false;
+    }
+    tat_ = std::max(tat_, now) + interval_;
+    return true;
+  }
+
+private:
+  duration interval_ = duration::zero();
+  std::size_t burst_ = 1;
+  /// The theoretical arrival time of the next reply.
+  time_point tat_{};
+};
+
+/// \brief Replies to Discovery and Inquiry: Endpoint messages on behalf of a single local MIDI-CI device.
+///
+/// The replies are serialized once, when the responder is constructed, and only the destination MUID (and, for
+/// Discovery, the initiator's output path ID) is patched before each one is sent. Incoming requests are queued rather
+/// than answered immediately so that:
+/// - a Discovery message from a remote MUID which has already been queued within the coalescing window is ignored;
+/// - a request which duplicates one that is still waiting to be answered is merged with it;
+/// - flush() sends no more replies than the reply_rate_limiter passed to it permits. The responders for all of the
+///   local identities served by a port share that port's limiter.
+///
+/// The responder is not thread-safe.
+///
+/// \tparam MaxEndpointInformation  The largest number of information bytes in the Reply to Endpoint message.
+/// \tparam Pending  The maximum number of replies that may be waiting to be sent.
+/// \tparam Recent  The number of remote MUIDs whose Discovery messages are remembered for coalescing.
+/// \tparam Clock  The clock used for the coalescing window.
+template <std::size_t MaxEndpointInformation = 64, std::size_t Pending = 16, std::size_t Recent = 32,
+          typename Clock = std::chrono::steady_clock>
+  requires(Pending > 0 && Recent > 0)
+class discovery_responder {
+public:
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+  /// \param local  The MUID of the local device. This is the source MUID of every reply.
+  /// \param reply  The body of the Reply to Discovery message. Its output_path_id is replaced by the value from each
+  ///   Discovery message.
+  /// \param device_id  The device ID placed in the header of each reply.
+  /// \param version  The MIDI-CI message version used for the replies.
+  constexpr discovery_responder(muid const local, discovery_reply const& reply, b7 const device_id = b7{0x7FU},
+                                b7 const version = b7{2U}) noexcept
+      : local_{local}, device_id_{device_id}, version_{version} {
+    auto const last = create_message(discovery_.begin(), discovery_.end(), this->reply_header(), reply);
+    assert(last != discovery_.end());
+    discovery_size_ = static_cast<std::size_t>(last - discovery_.begin());
+  }
+
+  /// \brief Sets the reply to Inquiry: Endpoint messages.
+  /// Only requests whose status matches that of \p reply will be answered.
+  /// \returns False if \p reply holds more than MaxEndpointInformation bytes of information, in which case Inquiry:
+  ///   Endpoint messages will not be answered.
+  constexpr bool endpoint_reply(ci::endpoint_reply const& reply) noexcept {
+    endpoint_size_ = 0;
+    if (reply.information.size() > MaxEndpointInformation) {
+      return false;
+    }
+    auto const last = create_message(endpoint_.begin(), endpoint_.end(), this->reply_header(), reply);
+    assert(last != endpoint_.end());
+    endpoint_size_ = static_cast<std::size_t>(last - endpoint_.begin());
+    endpoint_status_ = reply.status;
+    return true;
+  }
+
+  // clang-format off
+  /// Sets the period during which repeated Discovery messages from the same remote MUID are ignored.
+  constexpr discovery_responder &window(duration const w) noexcept { window_ = w; return *this; }
+  // clang-format on
+
+  /// \brief Queues a reply to a Discovery message.
+  /// Suitable for calling from the dispatcher's management.discovery() handler.
+  /// \returns True if a new reply was queued; false if the request was coalesced with an earlier one or the queue was
+  ///   full.
+  bool discovery(header const& hdr, ci::discovery const& d) {
+    auto const now = Clock::now();
+    auto const seen =
+        std::ranges::find_if(recent_, [&hdr](recent_entry const& r) { return r.valid && r.remote == hdr.remote_muid; });
+    if (seen != recent_.end() && now - seen->when < window_) {
+      ++coalesced_;
+      return false;
+    }
+    if (!this->enqueue(kind::discovery, hdr.remote_muid, d.output_path_id)) {
+      return false;
+    }
+    // Remember the remote MUID, replacing its previous entry, an unused entry, or else the least recently used one.
+    auto slot = seen;
+    if (slot == recent_.end()) {
+      slot = std::ranges::find_if(recent_, [](recent_entry const& r) { return !r.valid; });
+    }
+    if (slot == recent_.end()) {
+      slot = std::ranges::min_element(recent_, std::ranges::less{}, &recent_entry::when);
+    }
+    *slot = recent_entry{.remote = hdr.remote_muid, .when = now, .valid = true};
+    return true;
+  }
+  /// \brief Queues a reply to an Inquiry: Endpoint message.
+  /// Suitable for calling from the dispatcher's management.endpoint() handler.
+  /// \returns True if a new reply was queued; false if there is no cached reply for the requested status, the request
+  ///   duplicated one that is already queued, or the queue was full.
+  bool endpoint(header const& hdr, ci::endpoint const& e) {
+    if (endpoint_size_ == 0U || e.status != endpoint_status_) {
+      return false;
+    }
+    return this->enqueue(kind::endpoint, hdr.remote_muid, b7{});
+  }
+
+  /// \brief Sends all of the queued replies.
+  /// \param send  A function called with the bytes of each reply (excluding the 0xF0/0xF7 system exclusive framing).
+  ///   The bytes are valid only for the duration of the call.
+  /// \returns The number of replies sent.
+  template <typename SendFunction> std::size_t flush(SendFunction send) {
+    reply_rate_limiter<Clock> unlimited;
+    return this->flush(unlimited, std::move(send));
+  }
+  /// \brief Sends as many queued replies as \p port permits.
+  /// \param port  The rate limiter of the port to which the replies are sent.
+  /// \param send  A function called with the bytes of each reply (excluding the 0xF0/0xF7 system exclusive framing).
+  ///   The bytes are valid only for the duration of the call.
+  /// \returns The number of replies sent.
+  template <typename SendFunction> std::size_t flush(reply_rate_limiter<Clock>& port, SendFunction send) {
+    auto sent = std::size_t{0};
+    auto const now = Clock::now();
+    while (size_ > 0U && port.acquire(now)) {
+      auto const& p = pending_[head_];
+      std::span<std::byte> message;
+      if (p.what == kind::discovery) {
+        message = std::span{discovery_}.first(discovery_size_);
+        if (message.size() > output_path_id_offset) {
+          message[output_path_id_offset] = details::to_le7(p.output_path_id);
+        }
+      } else {
+        message = std::span{endpoint_}.first(endpoint_size_);
+      }
+      std::ranges::copy(details::to_le7(p.remote), message.begin() + offsetof(packed::header, destination_muid));
+      head_ = (head_ + 1U) % Pending;
+      --size_;
+      send(std::span<std::byte const>{message});
+      ++sent;
+    }
+    return sent;
+  }
+
+  /// \returns The number of replies waiting to be sent.
+  [[nodiscard]] constexpr std::size_t pending() const noexcept { return size_; }
+  /// \returns The number of requests which were merged with an earlier one rather than generating a new reply.
+  [[nodiscard]] constexpr std::size_t coalesced() const noexcept { return coalesced_; }
+  /// \returns The number of requests discarded because the queue was full.
+  [[nodiscard]] constexpr std::size_t dropped() const noexcept { return dropped_; }
+
+private:
+  enum class kind : std::uint8_t { discovery, endpoint };
+  struct pending_entry {
+    muid remote;
+    b7 output_path_id;
+    kind what = kind::discovery;
+  };
+  struct recent_entry {
+    muid remote;
+    time_point when{};
+    bool valid = false;
+  };
+
+  static constexpr auto output_path_id_offset =
+      sizeof(packed::header) + offsetof(packed::discovery_reply_v2, output_path_id);
+  static constexpr auto max_endpoint_size = sizeof(packed::header) + offsetof(packed::endpoint_reply_v1, data) +
+                                            MaxEndpointInformation;
+
+  [[nodiscard]] constexpr header reply_header() const noexcept {
+    return {.device_id = device_id_, .version = version_, .remote_muid = local_, .local_muid = broadcast_muid};
+  }
+
+  /// Adds a reply to the queue unless an identical one is already waiting. A duplicate Discovery message takes the
+  /// output path ID of the most recent request.
+  bool enqueue(kind const what, muid const remote, b7 const output_path_id) {
+    for (auto index = std::size_t{0}; index < size_; ++index) {
+      if (auto& p = pending_[(head_ + index) % Pending]; p.what == what && p.remote == remote) {
+        p.output_path_id = output_path_id;
+        ++coalesced_;
+        return false;
+      }
+    }
+    if (size_ >= Pending) {
+      ++dropped_;
+      return false;
+    }
+    pending_[(head_ + size_) % Pending] =
+        pending_entry{.remote = remote, .output_path_id = output_path_id, .what = what};
+    ++size_;
+    return true;
+  }
+
+  muid local_;
+  b7 device_id_;
+  b7 version_;
+  b7 endpoint_status_;
+
+  duration window_ = std::chrono::duration_cast<duration>(std::chrono::seconds{1});
+
+  std::size_t coalesced_ = 0;
+  std::size_t dropped_ = 0;
+
+  std::size_t discovery_size_ = 0;
+  std::size_t endpoint_size_ = 0;
+  details::create_message_buffer<sizeof(packed::header) + sizeof(packed::discovery_reply_v2)> discovery_{};
+  details::create_message_buffer<max_endpoint_size> endpoint_{};
+
+  /// A circular queue of the replies waiting to be sent.
+  std::size_t head_ = 0;
+  std::size_t size_ = 0;
+  std::array<pending_entry, Pending> pending_{};
+  std::array<recent_entry, Recent> recent_{};
+};
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_DISCOVERY_RESPONDER_HPP
@@ -14,6 +14,7 @@
 #ifndef MIDI2_CI_DISPATCHER_HPP
 #define MIDI2_CI_DISPATCHER_HPP
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <concepts>
@@ -25,6 +26,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "midi2/adt/inplace_function.hpp"
 #include "midi2/ci/ci_dispatcher_backend.hpp"
 #include "midi2/ci/ci_types.hpp"
 #include "midi2/dispatcher.hpp"
@@ -42,6 +44,34 @@ concept ci_dispatcher_config = requires(T v) {
   { v.process_inquiry } -> dispatcher_backend::process_inquiry<decltype(v.context)>;
 };
 
+/// A configuration which, in addition to the standard backends, has a property_exchange_stream member. The dispatcher
+/// delivers the data of Property Exchange get, set, subscription, and notify messages (and their replies) to this
+/// backend in fragments as they arrive rather than passing complete messages to the property_exchange backend. The
+/// internal buffer then needs to hold only the Property Exchange header plus a fragment of data.
+///
+/// Other messages are not streamed. In particular, a Profile Specific Data message is still passed whole to
+/// profile.specific_data(), so it can carry at most buffer_size less 7 bytes (the profile ID and data length) of
+/// data. A longer message is reported to system.buffer_overflow. The buffer must be able to hold at least those
+/// fixed fields and one byte of data.
+template <typename T>
+concept ci_dispatcher_stream_config =
+    ci_dispatcher_config<T> &&
+    requires(T v) {
+      { v.property_exchange_stream } -> dispatcher_backend::property_exchange_stream<decltype(v.context)>;
+    } && T::buffer_size >= sizeof(ci::profile_configuration::packed::specific_data_v1);
+
+/// A configuration whose buffer_pool member points to a pool of message buffers (normally an instance of
+/// ci::buffer_pool<>) which is shared with other dispatchers. Rather than embedding a buffer of buffer_size bytes, the
+/// dispatcher then takes a buffer from the pool when it accepts a message header and returns it once the message has
+/// been handled. If the pool is empty, the message is reported to system.buffer_overflow and discarded. The pool's
+/// buffers must be buffer_size bytes.
+template <typename T>
+concept ci_dispatcher_pool_config =
+    ci_dispatcher_config<T> && requires(T v) {
+      { v.buffer_pool->acquire() } -> std::same_as<std::span<std::byte>>;
+      { v.buffer_pool->release(std::span<std::byte>{}) };
+    } && std::remove_cvref_t<decltype(*std::declval<T&>().buffer_pool)>::buffer_size == T::buffer_size;
+
 template <typename Context, std::size_t BufferSize> struct function_config {
   constexpr explicit function_config(Context c = Context{}) : context{c} {}
 
@@ -54,9 +84,79 @@ template <typename Context, std::size_t BufferSize> struct function_config {
   dispatcher_backend::process_inquiry_function<Context> process_inquiry;
 };
 
+/// A configuration with the same on_*() interface as function_config whose callbacks are held by
+/// adt::inplace_function<>. Constructing, copying, and destroying the configuration never allocates memory. A callable
+/// whose captures exceed \p CallableSize bytes is rejected at compile time.
+template <typename Context, std::size_t BufferSize, std::size_t CallableSize = 2 * sizeof(void*)>
+struct compact_function_config {
+  template <typename Signature> using function = adt::inplace_function<Signature, CallableSize>;
+
+  constexpr explicit compact_function_config(Context c = Context{}) : context{c} {}
+
+  [[no_unique_address]] Context context;
+  static constexpr auto buffer_size = BufferSize;
+  dispatcher_backend::system_function<Context, function> system;
+  dispatcher_backend::management_function<Context, function> management;
+  dispatcher_backend::profile_function<Context, function> profile;
+  dispatcher_backend::property_exchange_function<Context, function> property_exchange;
+  dispatcher_backend::process_inquiry_function<Context, function> process_inquiry;
+};
+
 template <typename T>
 concept unaligned_copyable = alignof(T) == 1 && std::is_trivially_copyable_v<T>;
 
+namespace details {
+
+/// The message buffer of a dispatcher whose configuration supplies a buffer pool. A small array holds the message
+/// header; a buffer from the pool holds the remainder of the message. A buffer that is still held when the object is
+/// destroyed is returned to the pool.
+template <typename Pool, std::size_t HeaderSize> class pooled_buffer {
+public:
+  constexpr pooled_buffer() noexcept = default;
+  pooled_buffer(pooled_buffer const&) = delete;
+  constexpr pooled_buffer(pooled_buffer&& other) noexcept
+      : header_{other.header_}, pool_{std::exchange(other.pool_, nullptr)}, buffer_{std::exchange(other.buffer_, {})} {}
+  constexpr ~pooled_buffer() noexcept { this->release(); }
+
+  pooled_buffer& operator=(pooled_buffer const&) = delete;
+  constexpr pooled_buffer& operator=(pooled_buffer&& other) noexcept {
+    if (&other != this) {
+      this->release();
+      header_ = other.header_;
+      pool_ = std::exchange(other.pool_, nullptr);
+      buffer_ = std::exchange(other.buffer_, {});
+    }
+    return *this;
+  }
+
+  /// \returns The pool buffer if one is held, otherwise the header array.
+  [[nodiscard]] constexpr std::span<std::byte> get() noexcept {
+    return buffer_.empty() ? std::span<std::byte>{header_} : buffer_;
+  }
+  /// \brief Takes a buffer from \p pool.
+  /// \returns True if a buffer was obtained, false if the pool was empty.
+  constexpr bool acquire(Pool& pool) noexcept {
+    assert(buffer_.empty());
+    pool_ = &pool;
+    buffer_ = pool.acquire();
+    return !buffer_.empty();
+  }
+  /// \brief Returns the buffer, if one is held, to its pool.
+  constexpr void release() noexcept {
+    if (!buffer_.empty()) {
+      pool_->release(buffer_);
+      buffer_ = {};
+    }
+  }
+
+private:
+  std::array<std::byte, HeaderSize> header_{};
+  Pool* pool_ = nullptr;
+  std::span<std::byte> buffer_{};
+};
+
+}  // end namespace details
+
 template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 class ci_dispatcher {
@@ -86,7 +186,27 @@ public:
   constexpr void set_group(std::uint8_t const group) noexcept { group_ = group; }
   constexpr void set_device_id(b7 const device_id) noexcept { header_.device_id = device_id; }
 
+  /// \brief Dispatches a single byte of a MIDI-CI message.
+  /// \param s7  The next byte of the message.
   void dispatch(std::byte s7);
+  /// \brief Dispatches a contiguous buffer of MIDI-CI message bytes.
+  ///
+  /// The result is identical to calling dispatch() for each byte of \p s7, but bytes are copied into the message
+  /// buffer as whole runs and the message handlers are only invoked at field boundaries.
+  ///
+  /// \param s7  A span of message bytes.
+  void dispatch(std::span<std::byte const> s7);
+  /// \brief Prepares the dispatcher to receive the first byte of a new message. Any partially received message is
+  ///   abandoned. If its data was being streamed, the property_exchange_stream backend's abort() is called.
+  constexpr void reset() {
+    this->abort_stream();
+    this->release_buffer();
+    count_ = header_size;
+    consumer_ = &ci_dispatcher::header;
+    pos_ = 0;
+    stream_ = ci::property_exchange::stream_info{};
+    stream_remaining_ = 0;
+  }
 
   [[nodiscard]] constexpr config_type const& config() const noexcept { return config_; }
   [[nodiscard]] constexpr config_type& config() noexcept { return config_; }
@@ -106,10 +226,67 @@ private:
   // Note that the struct keyword is necessary to avoid an error from gcc about a conflict with header().
   struct header header_;
 
+  // The message buffer is either embedded in the dispatcher or taken from a pool supplied by the configuration.
+  static constexpr bool pooled = ci_dispatcher_pool_config<config_type>;
+  template <typename T> struct storage {
+    using type = std::array<std::byte, T::buffer_size>;
+  };
+  template <ci_dispatcher_pool_config T> struct storage<T> {
+    using pool = std::remove_reference_t<decltype(*std::declval<T&>().buffer_pool)>;
+    using type = details::pooled_buffer<pool, header_size>;
+  };
+
   // TODO: replace buffer_/pos_ with inplace_vector<> at some point.
-  std::array<std::byte, config_type::buffer_size> buffer_{};
+  typename storage<config_type>::type buffer_{};
   unsigned pos_ = 0;
 
+  // The state of a Property Exchange message whose data is being streamed.
+  ci::property_exchange::stream_info stream_{};
+  std::size_t stream_remaining_ = 0;
+
+  /// \returns The buffer into which message bytes are gathered.
+  [[nodiscard]] constexpr std::span<std::byte> buffer() noexcept {
+    if constexpr (pooled) {
+      return buffer_.get();
+    } else {
+      return buffer_;
+    }
+  }
+  /// Obtains a buffer for the body of a message whose header has been accepted.
+  /// \returns False if the configuration's buffer pool is empty.
+  constexpr bool acquire_buffer() noexcept {
+    if constexpr (pooled) {
+      return buffer_.acquire(*this->config().buffer_pool);
+    } else {
+      return true;
+    }
+  }
+  /// Returns a pooled buffer, if one is held, to the configuration's buffer pool.
+  constexpr void release_buffer() noexcept {
+    if constexpr (pooled) {
+      buffer_.release();
+    }
+  }
+  /// If the data of a Property Exchange message is being streamed, tells the backend that the rest of it will not
+  /// arrive.
+  constexpr void abort_stream() {
+    if constexpr (ci_dispatcher_stream_config<config_type>) {
+      if (consumer_ == &ci_dispatcher::property_exchange_stream_data) {
+        auto& c = this->config();
+        c.property_exchange_stream.abort(c.context, header_, stream_);
+      }
+    }
+  }
+  /// Calls the current consumer. Once a message has been handled, its pooled buffer is released.
+  void consume() {
+    (this->*consumer_)();
+    if constexpr (pooled) {
+      if (consumer_ == &ci_dispatcher::discard) {
+        this->release_buffer();
+      }
+    }
+  }
+
   void discard();
   void overflow();
 
@@ -140,6 +317,7 @@ private:
   void pe_capabilities();
   void pe_capabilities_reply();
   void property_exchange();
+  void property_exchange_stream_data();
 
   // Process Inquiry messages
   void process_inquiry_capabilities();
@@ -240,21 +418,27 @@ constexpr void ci_dispatcher<Config>::header() {
       message_dispatch_info{message::nak, sizeof(packed::nak_v1), offsetof(packed::nak_v2, message),
                             &ci_dispatcher::nak},
   };
-  auto const* const h = reinterpret_cast<packed::header const*>(buffer_.data());
+  // A table indexed by sub-ID #2 which maps from a message type to its dispatch information. Unknown message types
+  // have a null consumer.
+  static constexpr auto table = [] {
+    std::array<message_dispatch_info, 128> result{};
+    for (auto const& info : messages) {
+      auto const index = std::to_underlying(info.type);
+      assert(index < result.size() && result[index].consumer == nullptr && "message types must be unique");
+      result[index] = info;
+    }
+    return result;
+  }();
+
+  auto const* const h = reinterpret_cast<packed::header const*>(this->buffer().data());
   type_ = static_cast<message>(h->sub_id_2);
   header_.version = to_underlying(h->version);
   header_.remote_muid = details::from_le7(h->source_muid);
   header_.local_muid = details::from_le7(h->destination_muid);
 
   auto& c = this->config();
-  auto const first = std::begin(messages);
-  auto const last = std::end(messages);
-  auto const pred = [](message_dispatch_info const& a, message_dispatch_info const& b) constexpr {
-    return a.type < b.type;
-  };
-  assert(std::is_sorted(first, last, pred));
-  if (auto const pos = std::lower_bound(first, last, message_dispatch_info{type_, 0, 0, nullptr}, pred);
-      pos == last || pos->type != type_) {
+  if (auto const index = std::to_integer<std::size_t>(h->sub_id_2);
+      index >= table.size() || table[index].consumer == nullptr) {
     // An unknown message type.
     consumer_ = &ci_dispatcher::discard;
     count_ = 0;
@@ -264,12 +448,15 @@ constexpr void ci_dispatcher<Config>::header() {
     // The message wasn't intended for us.
     consumer_ = &ci_dispatcher::discard;
     count_ = 0;
+  } else if (!this->acquire_buffer()) {
+    // There is no buffer available to hold the body of the message.
+    this->overflow();
   } else {
-    assert(pos->consumer != nullptr && "consumer must not be null");
-    consumer_ = pos->consumer;
-    count_ = header_.version == b7{1U} ? pos->v1size : pos->v2size;
+    auto const& info = table[index];
+    consumer_ = info.consumer;
+    count_ = header_.version == b7{1U} ? info.v1size : info.v2size;
     if (count_ == 0) {
-      (this->*consumer_)();
+      this->consume();
     }
   }
   pos_ = 0;
@@ -286,9 +473,9 @@ void ci_dispatcher<Config>::discovery() {
     c.management.discovery(c.context, header_, discovery::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<packed::discovery_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<packed::discovery_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<packed::discovery_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<packed::discovery_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -304,9 +491,9 @@ void ci_dispatcher<Config>::discovery_reply() {
     c.management.discovery_reply(c.context, header_, discovery_reply::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<packed::discovery_reply_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<packed::discovery_reply_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<packed::discovery_reply_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<packed::discovery_reply_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -319,7 +506,7 @@ void ci_dispatcher<Config>::invalidate_muid() {
   using type = packed::invalidate_muid_v1;
   auto& c = this->config();
   c.management.invalidate_muid(c.context, header_,
-                               invalidate_muid::make(*reinterpret_cast<type const*>(buffer_.data())));
+                               invalidate_muid::make(*reinterpret_cast<type const*>(this->buffer().data())));
   consumer_ = &ci_dispatcher::discard;
 }
 
@@ -328,7 +515,7 @@ void ci_dispatcher<Config>::invalidate_muid() {
 template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::ack() {
-  auto const* const ptr = reinterpret_cast<packed::ack_v1 const*>(buffer_.data());
+  auto const* const ptr = reinterpret_cast<packed::ack_v1 const*>(this->buffer().data());
   auto const message_length = details::from_le7(ptr->message_length).get();
   if (pos_ == offsetof(packed::ack_v1, message) && message_length > 0U) {
     // We've got the fixed-size part of the message. Now wait for the variable-length message buffer.
@@ -356,11 +543,11 @@ void ci_dispatcher<Config>::nak() {
   };
   if (header_.version == b7{1U}) {
     assert(pos_ == sizeof(v1_type));
-    handler(*reinterpret_cast<v1_type const*>(buffer_.data()));
+    handler(*reinterpret_cast<v1_type const*>(this->buffer().data()));
     return;
   }
 
-  auto const* const v2ptr = reinterpret_cast<v2_type const*>(buffer_.data());
+  auto const* const v2ptr = reinterpret_cast<v2_type const*>(this->buffer().data());
   auto const message_length = details::from_le7(v2ptr->message_length).get();
   if (pos_ == offsetof(ci::packed::nak_v2, message) && message_length > 0) {
     count_ = message_length;
@@ -378,7 +565,7 @@ void ci_dispatcher<Config>::endpoint() {
   using type = ci::packed::endpoint_v1;
   assert(pos_ == sizeof(type));
   auto& c = this->config();
-  c.management.endpoint(c.context, header_, ci::endpoint::make(*reinterpret_cast<type const*>(buffer_.data())));
+  c.management.endpoint(c.context, header_, ci::endpoint::make(*reinterpret_cast<type const*>(this->buffer().data())));
   consumer_ = &ci_dispatcher::discard;
 }
 
@@ -388,7 +575,7 @@ template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::endpoint_reply() {
   using type = ci::packed::endpoint_reply_v1;
-  auto const* const ptr = reinterpret_cast<type const*>(buffer_.data());
+  auto const* const ptr = reinterpret_cast<type const*>(this->buffer().data());
   auto const data_length = details::from_le7(ptr->data_length).get();
   if (pos_ == offsetof(type, data) && data_length > 0) {
     // We've got the basic structure. Now get the variable length data array.
@@ -418,7 +605,7 @@ template <typename Config>
 void ci_dispatcher<Config>::profile_inquiry_reply() {
   using pt1_type = ci::profile_configuration::packed::inquiry_reply_v1_pt1;
   using pt2_type = ci::profile_configuration::packed::inquiry_reply_v1_pt2;
-  auto const* const pt1 = reinterpret_cast<pt1_type const*>(buffer_.data());
+  auto const* const pt1 = reinterpret_cast<pt1_type const*>(this->buffer().data());
   auto const num_enabled = details::from_le7(pt1->num_enabled).get();
   auto const num_enabled_size = num_enabled * sizeof(pt1->ids[0]);
   if (num_enabled > 0 && pos_ == offsetof(pt1_type, ids)) {
@@ -428,7 +615,7 @@ void ci_dispatcher<Config>::profile_inquiry_reply() {
   }
 
   auto const* const pt2 =
-      reinterpret_cast<pt2_type const*>(buffer_.data() + offsetof(pt1_type, ids) + num_enabled_size);
+      reinterpret_cast<pt2_type const*>(this->buffer().data() + offsetof(pt1_type, ids) + num_enabled_size);
   if (auto const num_disabled = details::from_le7(pt2->num_disabled).get();
       num_disabled > 0 && pos_ == offsetof(pt1_type, ids) + num_enabled_size + offsetof(pt2_type, ids)) {
     // Get the variable length "disabled" array.
@@ -449,7 +636,7 @@ void ci_dispatcher<Config>::profile_added() {
   assert(pos_ == sizeof(type));
   auto& c = this->config();
   c.profile.added(c.context, header_,
-                  ci::profile_configuration::added::make(*reinterpret_cast<type const*>(buffer_.data())));
+                  ci::profile_configuration::added::make(*reinterpret_cast<type const*>(this->buffer().data())));
   consumer_ = &ci_dispatcher::discard;
 }
 
@@ -462,7 +649,7 @@ void ci_dispatcher<Config>::profile_removed() {
   assert(pos_ == sizeof(type));
   auto& c = this->config();
   c.profile.removed(c.context, header_,
-                    ci::profile_configuration::removed::make(*reinterpret_cast<type const*>(buffer_.data())));
+                    ci::profile_configuration::removed::make(*reinterpret_cast<type const*>(this->buffer().data())));
   consumer_ = &ci_dispatcher::discard;
 }
 
@@ -475,7 +662,7 @@ void ci_dispatcher<Config>::profile_details() {
   assert(pos_ == sizeof(type));
   auto& c = this->config();
   c.profile.details(c.context, header_,
-                    ci::profile_configuration::details::make(*reinterpret_cast<type const*>(buffer_.data())));
+                    ci::profile_configuration::details::make(*reinterpret_cast<type const*>(this->buffer().data())));
   consumer_ = &ci_dispatcher::discard;
 }
 
@@ -485,7 +672,7 @@ template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::profile_details_reply() {
   using type = ci::profile_configuration::packed::details_reply_v1;
-  auto const* const reply = reinterpret_cast<type const*>(buffer_.data());
+  auto const* const reply = reinterpret_cast<type const*>(this->buffer().data());
   if (auto const data_length = details::from_le7(reply->data_length).get();
       pos_ == offsetof(type, data) && data_length > 0) {
     count_ = data_length * sizeof(type::data[0]);
@@ -507,9 +694,9 @@ void ci_dispatcher<Config>::profile_on() {
     c.profile.on(c.context, header_, ci::profile_configuration::on::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<ci::profile_configuration::packed::on_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::on_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<ci::profile_configuration::packed::on_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::on_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -525,9 +712,9 @@ void ci_dispatcher<Config>::profile_off() {
     c.profile.off(c.context, header_, ci::profile_configuration::off::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<ci::profile_configuration::packed::off_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::off_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<ci::profile_configuration::packed::off_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::off_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -543,9 +730,9 @@ void ci_dispatcher<Config>::profile_enabled() {
     c.profile.enabled(c.context, header_, ci::profile_configuration::enabled::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<ci::profile_configuration::packed::enabled_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::enabled_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<ci::profile_configuration::packed::enabled_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::enabled_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -561,9 +748,9 @@ void ci_dispatcher<Config>::profile_disabled() {
     c.profile.disabled(c.context, header_, ci::profile_configuration::disabled::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<ci::profile_configuration::packed::disabled_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::disabled_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<ci::profile_configuration::packed::disabled_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::profile_configuration::packed::disabled_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -574,7 +761,7 @@ template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::profile_specific_data() {
   using type = ci::profile_configuration::packed::specific_data_v1;
-  auto const* const reply = reinterpret_cast<type const*>(buffer_.data());
+  auto const* const reply = reinterpret_cast<type const*>(this->buffer().data());
   if (auto const data_length = details::from_le7(reply->data_length).get();
       pos_ == offsetof(type, data) && data_length > 0) {
     count_ = data_length * sizeof(type::data[0]);
@@ -596,9 +783,9 @@ void ci_dispatcher<Config>::pe_capabilities() {
     c.property_exchange.capabilities(c.context, header_, ci::property_exchange::capabilities::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -614,9 +801,9 @@ void ci_dispatcher<Config>::pe_capabilities_reply() {
     c.property_exchange.capabilities_reply(c.context, header_, ci::property_exchange::capabilities_reply::make(*v));
   };
   if (header_.version == b7{1U}) {
-    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_reply_v1 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_reply_v1 const*>(this->buffer().data()));
   } else {
-    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_reply_v2 const*>(buffer_.data()));
+    handler(reinterpret_cast<ci::property_exchange::packed::capabilities_reply_v2 const*>(this->buffer().data()));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -629,7 +816,7 @@ void ci_dispatcher<Config>::property_exchange() {
   using ci::property_exchange::packed::property_exchange_pt1;
   using ci::property_exchange::packed::property_exchange_pt2;
   auto size = offsetof(property_exchange_pt1, header);
-  auto const* const pt1 = reinterpret_cast<property_exchange_pt1 const*>(buffer_.data());
+  auto const* const pt1 = reinterpret_cast<property_exchange_pt1 const*>(this->buffer().data());
   auto const header_length = details::from_le7(pt1->header_length).get();
   if (pos_ == size && header_length > 0) {
     count_ = header_length * sizeof(pt1->header[0]);
@@ -642,10 +829,10 @@ void ci_dispatcher<Config>::property_exchange() {
     return;
   }
 
-  auto const* const pt2 = reinterpret_cast<property_exchange_pt2 const*>(buffer_.data() + size);
+  auto const* const pt2 = reinterpret_cast<property_exchange_pt2 const*>(this->buffer().data() + size);
   size += pt2_size;
   auto const data_length = details::from_le7(pt2->data_length).get();
-  if (pos_ == size && data_length > 0) {
+  if (!ci_dispatcher_stream_config<config_type> && pos_ == size && data_length > 0) {
     count_ = data_length * sizeof(pt2->data[0]);
     return;
   }
@@ -660,6 +847,29 @@ void ci_dispatcher<Config>::property_exchange() {
 
   auto& c = this->config();
   using enum message;
+  if constexpr (ci_dispatcher_stream_config<config_type>) {
+    using enum ci::property_exchange::property_exchange_type;
+    auto type = get;
+    switch (type_) {
+    case pe_get: type = get; break;
+    case pe_get_reply: type = get_reply; break;
+    case pe_set: type = set; break;
+    case pe_set_reply: type = set_reply; break;
+    case pe_sub: type = subscription; break;
+    case pe_sub_reply: type = subscription_reply; break;
+    case pe_notify: type = notify; break;
+    default: assert(false); break;
+    }
+    stream_ = ci::property_exchange::stream_info{
+        .type = type, .chunk = chunk, .request = request, .data_length = b14{data_length}};
+    stream_remaining_ = data_length;
+    c.property_exchange_stream.begin(c.context, header_, stream_, header);
+    // The data is now delivered in fragments which reuse the whole of the buffer.
+    pos_ = 0;
+    consumer_ = &ci_dispatcher::property_exchange_stream_data;
+    this->property_exchange_stream_data();
+    return;
+  }
   using ci::property_exchange::get;
   using ci::property_exchange::get_reply;
   using ci::property_exchange::notify;
@@ -684,6 +894,29 @@ void ci_dispatcher<Config>::property_exchange() {
   consumer_ = &ci_dispatcher::discard;
 }
 
+// property exchange stream data
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+template <typename Config>
+  requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
+void ci_dispatcher<Config>::property_exchange_stream_data() {
+  if constexpr (ci_dispatcher_stream_config<config_type>) {
+    auto& c = this->config();
+    auto& pes = c.property_exchange_stream;
+    if (pos_ > 0) {
+      assert(pos_ <= stream_remaining_);
+      pes.data(c.context, header_, stream_, std::span{reinterpret_cast<char const*>(this->buffer().data()), pos_});
+      stream_remaining_ -= pos_;
+      pos_ = 0;
+    }
+    if (stream_remaining_ > 0) {
+      count_ = std::min(stream_remaining_, this->buffer().size());
+      return;
+    }
+    pes.end(c.context, header_, stream_);
+  }
+  consumer_ = &ci_dispatcher::discard;
+}
+
 // process inquiry capabilities
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 template <typename Config>
@@ -707,7 +940,7 @@ void ci_dispatcher<Config>::process_inquiry_capabilities_reply() {
   if (header_.version > b7{1U}) {
     auto& c = this->config();
     c.process_inquiry.capabilities_reply(c.context, header_,
-                                         reply::make(*reinterpret_cast<reply_v2 const*>(buffer_.data())));
+                                         reply::make(*reinterpret_cast<reply_v2 const*>(this->buffer().data())));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -723,7 +956,7 @@ void ci_dispatcher<Config>::process_inquiry_midi_message_report() {
   if (header_.version > b7{1U}) {
     auto& c = this->config();
     c.process_inquiry.midi_message_report(c.context, header_,
-                                          report::make(*reinterpret_cast<report_v2 const*>(buffer_.data())));
+                                          report::make(*reinterpret_cast<report_v2 const*>(this->buffer().data())));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -739,7 +972,7 @@ void ci_dispatcher<Config>::process_inquiry_midi_message_report_reply() {
   if (header_.version > b7{1U}) {
     auto& c = this->config();
     c.process_inquiry.midi_message_report_reply(c.context, header_,
-                                                reply::make(*reinterpret_cast<reply_v2 const*>(buffer_.data())));
+                                                reply::make(*reinterpret_cast<reply_v2 const*>(this->buffer().data())));
   }
   consumer_ = &ci_dispatcher::discard;
 }
@@ -762,7 +995,7 @@ template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::discard() {
   pos_ = 0;
-  count_ = buffer_.size();
+  count_ = this->buffer().size();
 }
 
 // overflow
@@ -770,8 +1003,10 @@ void ci_dispatcher<Config>::discard() {
 template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::overflow() {
+  this->abort_stream();
   auto& c = this->config();
   c.system.buffer_overflow(c.context);
+  this->release_buffer();
   count_ = 0;
   pos_ = 0;
   consumer_ = &ci_dispatcher::discard;
@@ -783,16 +1018,48 @@ template <typename Config>
   requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
 void ci_dispatcher<Config>::dispatch(std::byte const s7) {
   if (count_ > 0) {
-    if (pos_ >= buffer_.size()) {
+    if (pos_ >= this->buffer().size()) {
       this->overflow();
       return;
     }
-    buffer_[pos_] = s7;
+    this->buffer()[pos_] = s7;
     ++pos_;
     --count_;
   }
   if (count_ == 0) {
-    (this->*consumer_)();
+    this->consume();
+  }
+}
+
+template <typename Config>
+  requires ci_dispatcher_config<std::unwrap_reference_t<Config>>
+void ci_dispatcher<Config>::dispatch(std::span<std::byte const> s7) {
+  while (!s7.empty()) {
+    if (consumer_ == &ci_dispatcher::discard) {
+      // Every remaining byte will be thrown away. Skip them all and leave the state as if they had been.
+      this->discard();
+      return;
+    }
+    if (count_ == 0) {
+      // Equivalent to dispatch() being called with count_ == 0: the byte is not recorded.
+      this->consume();
+      s7 = s7.subspan(1);
+      continue;
+    }
+    if (pos_ >= this->buffer().size()) {
+      this->overflow();
+      s7 = s7.subspan(1);
+      continue;
+    }
+    // Copy as much of the current field as is available and will fit in the buffer.
+    auto const n = std::min({count_, s7.size(), this->buffer().size() - pos_});
+    std::memcpy(this->buffer().data() + pos_, s7.data(), n);
+    pos_ += static_cast<unsigned>(n);
+    count_ -= n;
+    s7 = s7.subspan(n);
+    if (count_ == 0) {
+      this->consume();
+    }
   }
 }
 
@@ -810,6 +1077,14 @@ ci_dispatcher<function_config<Context, BufferSize>> make_function_dispatcher() {
   return ci_dispatcher<config>{};
 }
 
+template <typename Context, std::size_t BufferSize>
+ci_dispatcher<compact_function_config<Context, BufferSize>> make_compact_dispatcher(b7 const device_id,
+                                                                                    std::uint8_t const group,
+                                                                                    Context&& context = Context{}) {
+  using config = compact_function_config<Context, BufferSize>;
+  return ci_dispatcher{device_id, group, config{std::forward<Context>(context)}};
+}
+
 }  // end namespace midi2::ci
 
 #endif  // MIDI2_CI_DISPATCHER_HPP
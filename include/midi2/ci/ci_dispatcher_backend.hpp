@@ -17,6 +17,7 @@
 #include <concepts>
 #include <cstdint>
 #include <functional>
+#include <span>
 
 #include "midi2/ci/ci_types.hpp"
 #include "midi2/utils.hpp"
@@ -92,6 +93,25 @@ concept property_exchange = requires(T v, Context context) {
   { v.notify(context, header{}, property_exchange::notify{}) } -> std::same_as<void>;
 };
 
+/// \brief The property exchange stream concept gathers the callbacks used by a dispatcher that delivers Property
+/// Exchange message data in fragments as it arrives rather than as a single complete message.
+///
+/// The functions required are:
+///
+/// - begin: Called once the Property Exchange header has been received. The header span is valid only for the
+///   duration of the call.
+/// - data: Called with each fragment of the message data. A fragment is valid only for the duration of the call.
+/// - end: Called once all of the message data has been delivered.
+/// - abort: Called in place of end if the dispatcher is reset or its buffer overflows after begin has been called.
+///   Any state accumulated for the message should be discarded.
+template <typename T, typename Context>
+concept property_exchange_stream = requires(T v, Context context) {
+  { v.begin(context, header{}, property_exchange::stream_info{}, std::span<char const>{}) } -> std::same_as<void>;
+  { v.data(context, header{}, property_exchange::stream_info{}, std::span<char const>{}) } -> std::same_as<void>;
+  { v.end(context, header{}, property_exchange::stream_info{}) } -> std::same_as<void>;
+  { v.abort(context, header{}, property_exchange::stream_info{}) } -> std::same_as<void>;
+};
+
 template <typename T, typename Context>
 concept process_inquiry = requires(T v, Context context) {
   { v.capabilities(context, header{}) } -> std::same_as<void>;
@@ -180,6 +200,12 @@ template <typename Context> struct property_exchange_null {
   constexpr static void subscription_reply(Context, header const &, property_exchange::subscription_reply const &) { /* do nothing */ }
   constexpr static void notify(Context, header const &, property_exchange::notify const &) { /* do nothing */ }
 };
+template <typename Context> struct property_exchange_stream_null {
+  constexpr static void begin(Context, header const &, property_exchange::stream_info const &, std::span<char const>) { /* do nothing */ }
+  constexpr static void data(Context, header const &, property_exchange::stream_info const &, std::span<char const>) { /* do nothing */ }
+  constexpr static void end(Context, header const &, property_exchange::stream_info const &) { /* do nothing */ }
+  constexpr static void abort(Context, header const &, property_exchange::stream_info const &) { /* do nothing */ }
+};
 template <typename Context> struct process_inquiry_null {
   constexpr static void capabilities(Context, header const &) { /* do nothing */ }
   constexpr static void capabilities_reply(Context, header const &, process_inquiry::capabilities_reply const &) { /* do nothing */ }
@@ -193,6 +219,7 @@ static_assert(system<system_null<int>, int>);
 static_assert(management<management_null<int>, int>);
 static_assert(profile<profile_null<int>, int>);
 static_assert(property_exchange<property_exchange_null<int>, int>);
+static_assert(property_exchange_stream<property_exchange_stream_null<int>, int>);
 static_assert(process_inquiry<process_inquiry_null<int>, int>);
 
 template <typename Context> struct system_pure {
@@ -281,6 +308,20 @@ template <typename Context> struct property_exchange_pure {
   virtual void subscription_reply(Context, header const &, property_exchange::subscription_reply const &) = 0;
   virtual void notify(Context, header const &, property_exchange::notify const &) = 0;
 };
+template <typename Context> struct property_exchange_stream_pure {
+  property_exchange_stream_pure() = default;
+  property_exchange_stream_pure(property_exchange_stream_pure const &) = default;
+  property_exchange_stream_pure(property_exchange_stream_pure &&) noexcept = default;
+  virtual ~property_exchange_stream_pure() noexcept = default;
+
+  property_exchange_stream_pure &operator=(property_exchange_stream_pure const &) = default;
+  property_exchange_stream_pure &operator=(property_exchange_stream_pure &&) noexcept = default;
+
+  virtual void begin(Context, header const &, property_exchange::stream_info const &, std::span<char const>) = 0;
+  virtual void data(Context, header const &, property_exchange::stream_info const &, std::span<char const>) = 0;
+  virtual void end(Context, header const &, property_exchange::stream_info const &) = 0;
+  virtual void abort(Context, header const &, property_exchange::stream_info const &) = 0;
+};
 template <typename Context> struct process_inquiry_pure {
   process_inquiry_pure() = default;
   process_inquiry_pure(process_inquiry_pure const &) = default;
@@ -301,6 +342,7 @@ template <typename Context> struct process_inquiry_pure {
 static_assert(management<management_pure<int>, int>);
 static_assert(profile<profile_pure<int>, int>);
 static_assert(property_exchange<property_exchange_pure<int>, int>);
+static_assert(property_exchange_stream<property_exchange_stream_pure<int>, int>);
 static_assert(process_inquiry<process_inquiry_pure<int>, int>);
 
 // clang-format off
@@ -358,6 +400,12 @@ template <typename Context> struct property_exchange_base : property_exchange_pu
   void subscription_reply(Context, header const &, property_exchange::subscription_reply const &) override { /* do nothing */ }
   void notify(Context, header const &, property_exchange::notify const &) override { /* do nothing */ }
 };
+template <typename Context> struct property_exchange_stream_base : property_exchange_stream_pure<Context> {
+  void begin(Context, header const &, property_exchange::stream_info const &, std::span<char const>) override { /* do nothing */ }
+  void data(Context, header const &, property_exchange::stream_info const &, std::span<char const>) override { /* do nothing */ }
+  void end(Context, header const &, property_exchange::stream_info const &) override { /* do nothing */ }
+  void abort(Context, header const &, property_exchange::stream_info const &) override { /* do nothing */ }
+};
 template <typename Context> struct process_inquiry_base : process_inquiry_pure<Context> {
   void capabilities(Context, header const &) override { /* do nothing */ }
   void capabilities_reply(Context, header const &, process_inquiry::capabilities_reply const &) override { /* do nothing */ }
@@ -367,11 +415,11 @@ template <typename Context> struct process_inquiry_base : process_inquiry_pure<C
 };
 // clang-format on
 
-template <typename Context> class system_function {
+template <typename Context, template <typename> class Function = std::function> class system_function {
 public:
-  using check_muid_fn = std::function<bool(Context, std::uint8_t /*group*/, muid)>;
-  using unknown_fn = std::function<void(Context, header const &)>;
-  using buffer_overflow_fn = std::function<void(Context)>;
+  using check_muid_fn = Function<bool(Context, std::uint8_t /*group*/, muid)>;
+  using unknown_fn = Function<void(Context, header const &)>;
+  using buffer_overflow_fn = Function<void(Context)>;
 
   /// Sets the function that is to be called when the library needs to check whether the message is addressed to
   /// this receiver.
@@ -416,15 +464,15 @@ private:
   buffer_overflow_fn overflow_;
 };
 
-template <typename Context> class management_function {
+template <typename Context, template <typename> class Function = std::function> class management_function {
 public:
-  using discovery_fn = std::function<void(Context, header const &, ci::discovery const &)>;
-  using discovery_reply_fn = std::function<void(Context, header const &, ci::discovery_reply const &)>;
-  using endpoint_fn = std::function<void(Context, header const &, ci::endpoint const &)>;
-  using endpoint_reply_fn = std::function<void(Context, header const &, ci::endpoint_reply const &)>;
-  using invalidate_muid_fn = std::function<void(Context, header const &, ci::invalidate_muid const &)>;
-  using ack_fn = std::function<void(Context, header const &, ci::ack const &)>;
-  using nak_fn = std::function<void(Context, header const &, ci::nak const &)>;
+  using discovery_fn = Function<void(Context, header const &, ci::discovery const &)>;
+  using discovery_reply_fn = Function<void(Context, header const &, ci::discovery_reply const &)>;
+  using endpoint_fn = Function<void(Context, header const &, ci::endpoint const &)>;
+  using endpoint_reply_fn = Function<void(Context, header const &, ci::endpoint_reply const &)>;
+  using invalidate_muid_fn = Function<void(Context, header const &, ci::invalidate_muid const &)>;
+  using ack_fn = Function<void(Context, header const &, ci::ack const &)>;
+  using nak_fn = Function<void(Context, header const &, ci::nak const &)>;
 
   constexpr management_function &on_discovery(discovery_fn discovery) {
     discovery_ = std::move(discovery);
@@ -485,22 +533,22 @@ private:
 
 static_assert(management<management_function<int>, int>);
 
-template <typename Context> class profile_function {
+template <typename Context, template <typename> class Function = std::function> class profile_function {
 public:
-  using inquiry_fn = std::function<void(Context, header const &)>;
+  using inquiry_fn = Function<void(Context, header const &)>;
   using inquiry_reply_fn =
-      std::function<void(Context, header const &, ci::profile_configuration::inquiry_reply const &)>;
-  using added_fn = std::function<void(Context, header const &, ci::profile_configuration::added const &)>;
-  using removed_fn = std::function<void(Context, header const &, ci::profile_configuration::removed const &)>;
-  using details_fn = std::function<void(Context, header const &, ci::profile_configuration::details const &)>;
+      Function<void(Context, header const &, ci::profile_configuration::inquiry_reply const &)>;
+  using added_fn = Function<void(Context, header const &, ci::profile_configuration::added const &)>;
+  using removed_fn = Function<void(Context, header const &, ci::profile_configuration::removed const &)>;
+  using details_fn = Function<void(Context, header const &, ci::profile_configuration::details const &)>;
   using details_reply_fn =
-      std::function<void(Context, header const &, ci::profile_configuration::details_reply const &)>;
-  using on_fn = std::function<void(Context, header const &, ci::profile_configuration::on const &)>;
-  using off_fn = std::function<void(Context, header const &, ci::profile_configuration::off const &)>;
-  using enabled_fn = std::function<void(Context, header const &, ci::profile_configuration::enabled const &)>;
-  using disabled_fn = std::function<void(Context, header const &, ci::profile_configuration::disabled const &)>;
+      Function<void(Context, header const &, ci::profile_configuration::details_reply const &)>;
+  using on_fn = Function<void(Context, header const &, ci::profile_configuration::on const &)>;
+  using off_fn = Function<void(Context, header const &, ci::profile_configuration::off const &)>;
+  using enabled_fn = Function<void(Context, header const &, ci::profile_configuration::enabled const &)>;
+  using disabled_fn = Function<void(Context, header const &, ci::profile_configuration::disabled const &)>;
   using specific_data_fn =
-      std::function<void(Context, header const &, ci::profile_configuration::specific_data const &)>;
+      Function<void(Context, header const &, ci::profile_configuration::specific_data const &)>;
 
   constexpr profile_function &on_inquiry(inquiry_fn inquiry) {
     inquiry_ = std::move(inquiry);
@@ -595,19 +643,19 @@ private:
 
 static_assert(profile<profile_function<int>, int>);
 
-template <typename Context> class property_exchange_function {
+template <typename Context, template <typename> class Function = std::function> class property_exchange_function {
 public:
-  using capabilities_fn = std::function<void(Context, header const &, ci::property_exchange::capabilities const &)>;
+  using capabilities_fn = Function<void(Context, header const &, ci::property_exchange::capabilities const &)>;
   using capabilities_reply_fn =
-      std::function<void(Context, header const &, ci::property_exchange::capabilities_reply const &)>;
-  using get_fn = std::function<void(Context, header const &, ci::property_exchange::get const &)>;
-  using get_reply_fn = std::function<void(Context, header const &, ci::property_exchange::get_reply const &)>;
-  using set_fn = std::function<void(Context, header const &, ci::property_exchange::set const &)>;
-  using set_reply_fn = std::function<void(Context, header const &, ci::property_exchange::set_reply const &)>;
-  using subscription_fn = std::function<void(Context, header const &, ci::property_exchange::subscription const &)>;
+      Function<void(Context, header const &, ci::property_exchange::capabilities_reply const &)>;
+  using get_fn = Function<void(Context, header const &, ci::property_exchange::get const &)>;
+  using get_reply_fn = Function<void(Context, header const &, ci::property_exchange::get_reply const &)>;
+  using set_fn = Function<void(Context, header const &, ci::property_exchange::set const &)>;
+  using set_reply_fn = Function<void(Context, header const &, ci::property_exchange::set_reply const &)>;
+  using subscription_fn = Function<void(Context, header const &, ci::property_exchange::subscription const &)>;
   using subscription_reply_fn =
-      std::function<void(Context, header const &, ci::property_exchange::subscription_reply const &)>;
-  using notify_fn = std::function<void(Context, header const &, ci::property_exchange::notify const &)>;
+      Function<void(Context, header const &, ci::property_exchange::subscription_reply const &)>;
+  using notify_fn = Function<void(Context, header const &, ci::property_exchange::notify const &)>;
 
   constexpr property_exchange_function &on_capabilities(capabilities_fn capabilities) {
     capabilities_ = std::move(capabilities);
@@ -690,16 +738,67 @@ private:
 
 static_assert(property_exchange<property_exchange_function<int>, int>);
 
-template <typename Context> class process_inquiry_function {
+template <typename Context, template <typename> class Function = std::function>
+class property_exchange_stream_function {
+public:
+  using begin_fn =
+      Function<void(Context, header const &, ci::property_exchange::stream_info const &, std::span<char const>)>;
+  using data_fn =
+      Function<void(Context, header const &, ci::property_exchange::stream_info const &, std::span<char const>)>;
+  using end_fn = Function<void(Context, header const &, ci::property_exchange::stream_info const &)>;
+  using abort_fn = Function<void(Context, header const &, ci::property_exchange::stream_info const &)>;
+
+  constexpr property_exchange_stream_function &on_begin(begin_fn begin) {
+    begin_ = std::move(begin);
+    return *this;
+  }
+  constexpr property_exchange_stream_function &on_data(data_fn data) {
+    data_ = std::move(data);
+    return *this;
+  }
+  constexpr property_exchange_stream_function &on_end(end_fn end) {
+    end_ = std::move(end);
+    return *this;
+  }
+  constexpr property_exchange_stream_function &on_abort(abort_fn abort) {
+    abort_ = std::move(abort);
+    return *this;
+  }
+
+  void begin(Context context, header const &ci, ci::property_exchange::stream_info const &info,
+             std::span<char const> pe_header) const {
+    call(begin_, context, ci, info, pe_header);
+  }
+  void data(Context context, header const &ci, ci::property_exchange::stream_info const &info,
+            std::span<char const> fragment) const {
+    call(data_, context, ci, info, fragment);
+  }
+  void end(Context context, header const &ci, ci::property_exchange::stream_info const &info) const {
+    call(end_, context, ci, info);
+  }
+  void abort(Context context, header const &ci, ci::property_exchange::stream_info const &info) const {
+    call(abort_, context, ci, info);
+  }
+
+private:
+  begin_fn begin_;
+  data_fn data_;
+  end_fn end_;
+  abort_fn abort_;
+};
+
+static_assert(property_exchange_stream<property_exchange_stream_function<int>, int>);
+
+template <typename Context, template <typename> class Function = std::function> class process_inquiry_function {
 public:
-  using capabilities_fn = std::function<void(Context, header const &)>;
+  using capabilities_fn = Function<void(Context, header const &)>;
   using capabilities_reply_fn =
-      std::function<void(Context, header const &, ci::process_inquiry::capabilities_reply const &)>;
+      Function<void(Context, header const &, ci::process_inquiry::capabilities_reply const &)>;
   using midi_message_report_fn =
-      std::function<void(Context, header const &, ci::process_inquiry::midi_message_report const &)>;
+      Function<void(Context, header const &, ci::process_inquiry::midi_message_report const &)>;
   using midi_message_report_reply_fn =
-      std::function<void(Context, header const &, ci::process_inquiry::midi_message_report_reply const &)>;
-  using midi_message_report_end_fn = std::function<void(Context, header const &)>;
+      Function<void(Context, header const &, ci::process_inquiry::midi_message_report_reply const &)>;
+  using midi_message_report_end_fn = Function<void(Context, header const &)>;
 
   constexpr process_inquiry_function &on_capabilities(capabilities_fn capabilities) {
     capabilities_ = std::move(capabilities);
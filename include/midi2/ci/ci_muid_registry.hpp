@@ -0,0 +1,156 @@
+//===-- CI MUID Registry ------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_muid_registry.hpp
+/// \brief A fixed-capacity table of the MUIDs owned by the local MIDI-CI devices and the groups to which they belong.
+
+#ifndef MIDI2_CI_MUID_REGISTRY_HPP
+#define MIDI2_CI_MUID_REGISTRY_HPP
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <random>
+
+#include "midi2/ci/ci_dispatcher_backend.hpp"
+#include "midi2/ci/ci_muid_table.hpp"
+#include "midi2/ci/ci_types.hpp"
+
+namespace midi2::ci {
+
+/// \brief Records the MUIDs owned by local MIDI-CI devices along with the group to which each belongs.
+///
+/// The registry is a details::muid_table. Each slot is a single 32-bit word holding a 28-bit MUID and its 4-bit
+/// group, so a lookup usually touches a single cache line. Insertion fails once three quarters of the slots are
+/// occupied.
+///
+/// \tparam Capacity  The number of slots in the table. Must be a power of two.
+template <std::size_t Capacity>
+  requires(Capacity >= 4 && Capacity <= (std::size_t{1} << 24) && std::has_single_bit(Capacity))
+class muid_registry {
+public:
+  /// The number of MUIDs that may be registered.
+  static constexpr std::size_t max_size() noexcept { return table::max_size(); }
+  /// The number of random MUIDs that generate() will try before giving up. With a good generator, even a full
+  /// registry makes a collision vanishingly unlikely so failure indicates a faulty generator.
+  static constexpr auto generate_attempts = 64U;
+
+  /// \brief Registers MUID \p m as belonging to \p group.
+  /// \param m  The MUID to be registered. Must not be reserved or the broadcast MUID.
+  /// \param group  The group to which \p m belongs.
+  /// \returns True if \p m was added, false if it was already registered or the table is full.
+  constexpr bool insert(muid const m, std::uint8_t const group) noexcept {
+    assert(m <= max_user_muid && group < 16U);
+    return table_.insert(m, (std::uint32_t{group} << muid_bits) | m.get()).second;
+  }
+
+  /// \brief Removes MUID \p m from the registry.
+  /// \returns The group to which \p m belonged or std::nullopt if it was not registered.
+  constexpr std::optional<std::uint8_t> erase(muid const m) noexcept {
+    auto const* const slot = table_.find(m);
+    if (slot == nullptr) {
+      return std::nullopt;
+    }
+    auto const group = group_of(*slot);
+    table_.erase(slot);
+    return group;
+  }
+
+  /// \brief Handles an Invalidate MUID message by removing its target MUID from the registry.
+  /// \returns The group to which the invalidated MUID belonged or std::nullopt if it was not a local MUID. In the
+  ///   former case, the device must choose a new MUID.
+  constexpr std::optional<std::uint8_t> invalidate(ci::invalidate_muid const& msg) noexcept {
+    return this->erase(msg.target_muid);
+  }
+
+  /// \brief Generates a new random MUID for \p group, avoiding any that are already registered, and registers it.
+  /// \param group  The group to which the new MUID will belong.
+  /// \param gen  A uniform random bit generator.
+  /// \returns The new MUID or std::nullopt if the table is full or no unused MUID was found after
+  ///   generate_attempts tries.
+  template <std::uniform_random_bit_generator Generator>
+  std::optional<muid> generate(std::uint8_t const group, Generator& gen) {
+    if (this->size() >= max_size()) {
+      return std::nullopt;
+    }
+    std::uniform_int_distribution<std::uint32_t> dist{0U, max_user_muid.get()};
+    for (auto attempt = 0U; attempt < generate_attempts; ++attempt) {
+      auto const m = muid{dist(gen)};
+      if (this->insert(m, group)) {
+        return m;
+      }
+      ++collisions_;
+    }
+    return std::nullopt;
+  }
+
+  /// \returns The group to which MUID \p m belongs or std::nullopt if it is not registered.
+  [[nodiscard]] constexpr std::optional<std::uint8_t> owner(muid const m) const noexcept {
+    if (auto const* const slot = table_.find(m)) {
+      return group_of(*slot);
+    }
+    return std::nullopt;
+  }
+  /// \returns True if MUID \p m is registered.
+  [[nodiscard]] constexpr bool contains(muid const m) const noexcept { return table_.find(m) != nullptr; }
+  /// \brief Checks whether a message addressed to MUID \p m on \p group should be handled.
+  /// This is the operation required by the dispatcher's system.check_muid() function.
+  /// \returns True if \p m is registered as belonging to \p group.
+  [[nodiscard]] constexpr bool check_muid(std::uint8_t const group, muid const m) const noexcept {
+    auto const g = this->owner(m);
+    return g.has_value() && *g == group;
+  }
+
+  /// \returns The number of registered MUIDs.
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return table_.size(); }
+  /// \returns True if no MUIDs are registered.
+  [[nodiscard]] constexpr bool empty() const noexcept { return table_.size() == 0U; }
+  /// \returns The number of randomly generated MUIDs which were discarded because they were already registered.
+  [[nodiscard]] constexpr std::size_t collisions() const noexcept { return collisions_; }
+
+private:
+  static constexpr auto muid_bits = 28U;
+  static constexpr auto muid_mask = (std::uint32_t{1} << muid_bits) - 1U;
+
+  struct slot_traits {
+    /// The value of an unused slot. It corresponds to the broadcast MUID which is never registered.
+    static constexpr std::uint32_t vacant() noexcept { return ~std::uint32_t{0}; }
+    static constexpr bool is_vacant(std::uint32_t const slot) noexcept { return slot == vacant(); }
+    static constexpr std::uint32_t key(std::uint32_t const slot) noexcept { return slot & muid_mask; }
+  };
+  using table = details::muid_table<std::uint32_t, Capacity, slot_traits>;
+
+  [[nodiscard]] static constexpr std::uint8_t group_of(std::uint32_t const slot) noexcept {
+    return static_cast<std::uint8_t>(slot >> muid_bits);
+  }
+
+  std::size_t collisions_ = 0;
+  table table_;
+};
+
+namespace dispatcher_backend {
+
+/// \brief A system backend whose check_muid() function accepts messages addressed to the MUIDs in a muid_registry.
+/// The other system functions do nothing.
+template <typename Context, typename Registry> struct system_muid_registry : system_null<Context> {
+  constexpr explicit system_muid_registry(Registry const& r) noexcept : registry{&r} {}
+  [[nodiscard]] constexpr bool check_muid(Context, std::uint8_t const group, muid const m) const noexcept {
+    return registry->check_muid(group, m);
+  }
+  Registry const* registry;
+};
+
+}  // end namespace dispatcher_backend
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_MUID_REGISTRY_HPP
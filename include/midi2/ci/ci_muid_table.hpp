@@ -0,0 +1,125 @@
+//===-- CI MUID Table ---------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_muid_table.hpp
+/// \brief A fixed-capacity open-addressing hash table keyed by MUID.
+
+#ifndef MIDI2_CI_MUID_TABLE_HPP
+#define MIDI2_CI_MUID_TABLE_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "midi2/ci/ci_types.hpp"
+
+namespace midi2::ci::details {
+
+/// The operations that muid_table needs on its slots.
+template <typename Traits, typename Slot>
+concept muid_table_traits = requires(Slot const& s) {
+  { Traits::vacant() } -> std::same_as<Slot>;
+  { Traits::is_vacant(s) } -> std::convertible_to<bool>;
+  { Traits::key(s) } -> std::same_as<std::uint32_t>;
+};
+
+/// \brief An open-addressing hash table of \p Capacity slots keyed by MUID using linear probing.
+///
+/// MUIDs are spread across the table by Fibonacci hashing because those in use may be sequential rather than random.
+/// Entries are removed with backward-shift deletion so no tombstones accumulate. To keep probe sequences short,
+/// insertion fails once three quarters of the slots are occupied.
+///
+/// \tparam Slot  The type of a table slot. It holds a MUID and any data associated with it.
+/// \tparam Capacity  The number of slots in the table. Must be a power of two.
+/// \tparam Traits  Supplies vacant(), which returns an unoccupied slot; is_vacant(), which tests whether a slot is
+///   unoccupied; and key(), which returns the MUID held by an occupied slot.
+template <typename Slot, std::size_t Capacity, typename Traits>
+  requires(Capacity >= 4 && Capacity <= (std::size_t{1} << 24) && std::has_single_bit(Capacity) &&
+           muid_table_traits<Traits, Slot>)
+class muid_table {
+public:
+  /// The number of MUIDs that may be held.
+  static constexpr std::size_t max_size() noexcept { return Capacity / 4U * 3U; }
+
+  constexpr muid_table() noexcept { slots_.fill(Traits::vacant()); }
+
+  /// \returns The slot holding MUID \p m or nullptr if it is not present.
+  [[nodiscard]] constexpr Slot* find(muid const m) noexcept {
+    auto const index = this->probe(m);
+    return Traits::is_vacant(slots_[index]) ? nullptr : &slots_[index];
+  }
+  /// \returns The slot holding MUID \p m or nullptr if it is not present.
+  [[nodiscard]] constexpr Slot const* find(muid const m) const noexcept {
+    auto const index = this->probe(m);
+    return Traits::is_vacant(slots_[index]) ? nullptr : &slots_[index];
+  }
+  /// \brief Stores \p value, which holds MUID \p m, unless \p m is already present.
+  /// \returns The slot holding \p m and true if \p value was stored. The slot is nullptr if \p m was not present
+  ///   and the table is full.
+  constexpr std::pair<Slot*, bool> insert(muid const m, Slot const& value) noexcept {
+    auto const index = this->probe(m);
+    if (!Traits::is_vacant(slots_[index])) {
+      return {&slots_[index], false};
+    }
+    if (size_ >= max_size()) {
+      return {nullptr, false};
+    }
+    slots_[index] = value;
+    ++size_;
+    return {&slots_[index], true};
+  }
+  /// \brief Removes the entry held in \p slot, which must have been returned by find() or insert().
+  constexpr void erase(Slot const* const slot) noexcept {
+    auto hole = static_cast<std::size_t>(slot - slots_.data());
+    // Move later members of the probe sequence into the hole until an entry is found which is already in its home
+    // slot (or an unoccupied slot is reached).
+    for (auto index = next(hole); !Traits::is_vacant(slots_[index]); index = next(index)) {
+      auto const h = home(muid{Traits::key(slots_[index])});
+      // Move the entry if its home slot does not lie cyclically in (hole, index].
+      if (((index - h) & mask) >= ((index - hole) & mask)) {
+        slots_[hole] = slots_[index];
+        hole = index;
+      }
+    }
+    slots_[hole] = Traits::vacant();
+    --size_;
+  }
+
+  /// \returns The number of MUIDs in the table.
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+
+private:
+  static constexpr auto mask = Capacity - 1U;
+
+  [[nodiscard]] static constexpr std::size_t home(muid const m) noexcept {
+    constexpr auto shift = 32U - static_cast<unsigned>(std::bit_width(mask));
+    return static_cast<std::size_t>(static_cast<std::uint32_t>(m.get() * 0x9E3779B1U) >> shift) & mask;
+  }
+  [[nodiscard]] static constexpr std::size_t next(std::size_t const index) noexcept { return (index + 1U) & mask; }
+  /// \returns The index of the slot holding \p m or, if it is not present, of the unoccupied slot which ends its
+  ///   probe sequence.
+  [[nodiscard]] constexpr std::size_t probe(muid const m) const noexcept {
+    auto index = home(m);
+    while (!Traits::is_vacant(slots_[index]) && Traits::key(slots_[index]) != m.get()) {
+      index = next(index);
+    }
+    return index;
+  }
+
+  std::size_t size_ = 0;
+  std::array<Slot, Capacity> slots_{};
+};
+
+}  // end namespace midi2::ci::details
+
+#endif  // MIDI2_CI_MUID_TABLE_HPP
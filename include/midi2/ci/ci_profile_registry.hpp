@@ -0,0 +1,273 @@
+//===-- CI Profile Registry ---------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_profile_registry.hpp
+/// \brief Records the profiles supported and enabled on each channel, group, and function block of a device.
+
+#ifndef MIDI2_CI_PROFILE_REGISTRY_HPP
+#define MIDI2_CI_PROFILE_REGISTRY_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_types.hpp"
+
+namespace midi2::ci {
+
+/// \brief Records the profiles supported and enabled on each destination of a device.
+///
+/// A destination is one of the sixteen channels of a group, the group as a whole, or the function block. This is the
+/// target given by the device ID field of a MIDI-CI message. The member functions that handle messages take it as an
+/// explicit argument: the header that ci_dispatcher passes to its handlers holds the dispatcher's device ID (see
+/// ci_dispatcher::set_device_id()), which need not be that of the message.
+///
+/// Each distinct profile ID is assigned a small index when it is first added. Each destination has two bitsets indexed
+/// by that value: one for the profiles it supports and one for those that are enabled.
+///
+/// An inquiry reply is written directly from these bitsets, so no list of profile IDs is built. on() and off()
+/// change a single bit.
+///
+/// \tparam Profiles  The maximum number of distinct profile IDs.
+/// \tparam Groups  The number of groups. The default of sixteen gives 256 channels.
+template <std::size_t Profiles = 64, std::size_t Groups = 16>
+  requires(Profiles > 0 && Groups > 0 && Groups <= 16)
+class profile_registry {
+public:
+  using profile = profile_configuration::profile;
+
+  /// The device ID which addresses a whole group.
+  static constexpr auto group_destination = b7{0x7EU};
+  /// The device ID which addresses the function block.
+  static constexpr auto function_block_destination = b7{0x7FU};
+
+  /// \brief Records that \p pid is supported (but not enabled) on a destination.
+  /// \param group  The group of the destination.
+  /// \param destination  A channel number (0-15), group_destination, or function_block_destination.
+  /// \param pid  The profile ID.
+  /// \returns False if the destination is not valid or no more profile IDs can be recorded.
+  constexpr bool add(std::uint8_t const group, b7 const destination, profile const& pid) noexcept {
+    auto const d = index(group, destination);
+    if (!d) {
+      return false;
+    }
+    auto p = this->find(pid);
+    if (!p) {
+      if (size_ >= Profiles) {
+        return false;
+      }
+      p = size_++;
+      profiles_[*p] = pid;
+    }
+    supported_[*d].set(*p);
+    return true;
+  }
+  /// \brief Records that \p pid is no longer supported on a destination. A profile ID which is supported nowhere
+  ///   releases its index.
+  /// \returns True if the profile had been supported on the destination.
+  constexpr bool remove(std::uint8_t const group, b7 const destination, profile const& pid) noexcept {
+    auto const d = index(group, destination);
+    auto const p = this->find(pid);
+    if (!d || !p || !supported_[*d].test(*p)) {
+      return false;
+    }
+    supported_[*d].reset(*p);
+    enabled_[*d].reset(*p);
+    if (std::ranges::none_of(supported_, [p](bitset const& b) { return b.test(*p); })) {
+      this->release(*p);
+    }
+    return true;
+  }
+
+  /// \brief Enables or disables a supported profile.
+  /// \returns True if the state of the profile changed.
+  constexpr bool set(std::uint8_t const group, b7 const destination, profile const& pid, bool const on) noexcept {
+    auto const d = index(group, destination);
+    auto const p = this->find(pid);
+    if (!d || !p || !supported_[*d].test(*p) || enabled_[*d].test(*p) == on) {
+      return false;
+    }
+    if (on) {
+      enabled_[*d].set(*p);
+    } else {
+      enabled_[*d].reset(*p);
+    }
+    return true;
+  }
+  /// \brief Handles a Set Profile On message. The number of channels requested is not recorded.
+  /// \param group  The group of the destination.
+  /// \param destination  The device ID of the message.
+  /// \param on  The message.
+  /// \returns True if the profile was supported and has just been enabled.
+  constexpr bool on(std::uint8_t const group, b7 const destination, profile_configuration::on const& on) noexcept {
+    return this->set(group, destination, on.pid, true);
+  }
+  /// \brief Handles a Set Profile Off message.
+  /// \param group  The group of the destination.
+  /// \param destination  The device ID of the message.
+  /// \param off  The message.
+  /// \returns True if the profile was enabled and has just been disabled.
+  constexpr bool off(std::uint8_t const group, b7 const destination, profile_configuration::off const& off) noexcept {
+    return this->set(group, destination, off.pid, false);
+  }
+
+  /// \returns True if \p pid is supported on the destination.
+  [[nodiscard]] constexpr bool supported(std::uint8_t const group, b7 const destination,
+                                         profile const& pid) const noexcept {
+    auto const d = index(group, destination);
+    auto const p = this->find(pid);
+    return d && p && supported_[*d].test(*p);
+  }
+  /// \returns True if \p pid is enabled on the destination.
+  [[nodiscard]] constexpr bool enabled(std::uint8_t const group, b7 const destination,
+                                       profile const& pid) const noexcept {
+    auto const d = index(group, destination);
+    auto const p = this->find(pid);
+    return d && p && enabled_[*d].test(*p);
+  }
+
+  /// \brief Writes a Profile Inquiry Reply message listing the profiles enabled and disabled on a destination.
+  ///
+  /// The output is identical to that of create_message() with an equivalent profile_configuration::inquiry_reply.
+  ///
+  /// \param first  Along with \p last, the range to which the message is written.
+  /// \param last  Along with \p first, the range to which the message is written.
+  /// \param group  The group of the destination.
+  /// \param destination  The device ID of the inquiry. The reply is sent with the same device ID.
+  /// \param hdr  The header of the reply. Its device ID is replaced by \p destination.
+  /// \returns An iterator past the last byte written or \p last if there was insufficient space.
+  template <std::output_iterator<std::byte> O, std::sentinel_for<O> S>
+  constexpr O inquiry_reply(O first, S const last, std::uint8_t const group, b7 const destination,
+                            header const& hdr) const {
+    auto const d = index(group, destination);
+    auto const enabled = d ? enabled_[*d] : bitset{};
+    auto const disabled = d ? supported_[*d].minus(enabled_[*d]) : bitset{};
+    auto const num_enabled = enabled.count();
+    auto const num_disabled = disabled.count();
+
+    auto reply = hdr;
+    reply.device_id = destination;
+    first = details::write_header(first, last, reply, message::profile_inquiry_reply);
+    // Check that there's room for the two counts and the profile IDs before writing anything.
+    auto const size = 2U * sizeof(byte_array<2>) + (num_enabled + num_disabled) * sizeof(profile);
+    auto first2 = first;
+    std::ranges::advance(first2, static_cast<std::iter_difference_t<O>>(size), last);
+    if (first2 == last) {
+      return first2;
+    }
+    first = this->write_ids(first, enabled, num_enabled);
+    return this->write_ids(first, disabled, num_disabled);
+  }
+
+private:
+  static constexpr auto destinations = Groups * 17U + 1U;
+
+  class bitset {
+  public:
+    constexpr void set(std::size_t const pos) noexcept { words_[pos / 64U] |= bit(pos); }
+    constexpr void reset(std::size_t const pos) noexcept { words_[pos / 64U] &= ~bit(pos); }
+    [[nodiscard]] constexpr bool test(std::size_t const pos) const noexcept {
+      return (words_[pos / 64U] & bit(pos)) != 0U;
+    }
+    [[nodiscard]] constexpr std::size_t count() const noexcept {
+      auto result = std::size_t{0};
+      for (auto const w : words_) {
+        result += static_cast<std::size_t>(std::popcount(w));
+      }
+      return result;
+    }
+    /// \returns The bits which are set in *this but not in \p other.
+    [[nodiscard]] constexpr bitset minus(bitset const& other) const noexcept {
+      bitset result;
+      std::ranges::transform(words_, other.words_, result.words_.begin(),
+                             [](std::uint64_t const a, std::uint64_t const b) { return a & ~b; });
+      return result;
+    }
+    /// Calls \p f with the position of each set bit in ascending order.
+    template <typename Function> constexpr void for_each(Function f) const {
+      for (auto word = std::size_t{0}; word < words_.size(); ++word) {
+        for (auto w = words_[word]; w != 0U; w &= w - 1U) {
+          f(word * 64U + static_cast<std::size_t>(std::countr_zero(w)));
+        }
+      }
+    }
+
+  private:
+    static constexpr std::uint64_t bit(std::size_t const pos) noexcept { return std::uint64_t{1} << (pos % 64U); }
+    std::array<std::uint64_t, (Profiles + 63U) / 64U> words_{};
+  };
+
+  /// \returns The index of the destination addressed by \p device_id within \p group.
+  [[nodiscard]] static constexpr std::optional<std::size_t> index(std::uint8_t const group,
+                                                                  b7 const device_id) noexcept {
+    if (device_id == function_block_destination) {
+      return destinations - 1U;
+    }
+    if (group >= Groups) {
+      return std::nullopt;
+    }
+    if (device_id == group_destination) {
+      return group * 17U + 16U;
+    }
+    if (device_id.get() < 16U) {
+      return group * 17U + device_id.get();
+    }
+    return std::nullopt;
+  }
+  [[nodiscard]] constexpr std::optional<std::size_t> find(profile const& pid) const noexcept {
+    auto const ids = std::span{profiles_}.first(size_);
+    if (auto const pos = std::ranges::find(ids, pid); pos != ids.end()) {
+      return static_cast<std::size_t>(pos - ids.begin());
+    }
+    return std::nullopt;
+  }
+  /// Releases the index \p p by moving the last profile ID into its place.
+  constexpr void release(std::size_t const p) noexcept {
+    auto const last = --size_;
+    if (p != last) {
+      profiles_[p] = profiles_[last];
+      for (auto d = std::size_t{0}; d < destinations; ++d) {
+        move_bit(supported_[d], last, p);
+        move_bit(enabled_[d], last, p);
+      }
+    }
+  }
+  static constexpr void move_bit(bitset& b, std::size_t const from, std::size_t const to) noexcept {
+    if (b.test(from)) {
+      b.set(to);
+      b.reset(from);
+    } else {
+      b.reset(to);
+    }
+  }
+  template <std::output_iterator<std::byte> O>
+  constexpr O write_ids(O first, bitset const& b, std::size_t const count) const {
+    first = std::ranges::copy(details::to_le7(static_cast<b14>(count)), first).out;
+    b.for_each([this, &first](std::size_t const p) {
+      first = std::ranges::transform(profiles_[p], first, [](b7 const v) { return details::to_le7(v); }).out;
+    });
+    return first;
+  }
+
+  std::size_t size_ = 0;
+  std::array<profile, Profiles> profiles_{};
+  std::array<bitset, destinations> supported_{};
+  std::array<bitset, destinations> enabled_{};
+};
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_PROFILE_REGISTRY_HPP
@@ -0,0 +1,268 @@
+//===-- CI Property Cache -----------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_property_cache.hpp
+/// \brief A client-side cache of Property Exchange Get replies keyed by device, resource, and resId.
+
+#ifndef MIDI2_CI_PROPERTY_CACHE_HPP
+#define MIDI2_CI_PROPERTY_CACHE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "midi2/adt/plru_cache.hpp"
+#include "midi2/ci/ci_resource_key.hpp"
+#include "midi2/ci/ci_types.hpp"
+
+namespace midi2::ci {
+
+namespace details {
+
+/// \brief Finds the value of a string property in a Property Exchange header.
+/// This is not a JSON parser: it finds the first occurrence of \p name as a quoted string followed by a colon and
+/// returns the string which follows. Escape sequences in the value are not supported. This is sufficient for the
+/// simple headers which carry the resource, resId, and subscribeId properties.
+/// \returns The value of the property or std::nullopt if it was not found.
+[[nodiscard]] constexpr std::optional<std::string_view> find_header_string(std::string_view const header,
+                                                                           std::string_view const name) noexcept {
+  constexpr auto is_space = [](char const c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; };
+  for (auto pos = header.find(name); pos != std::string_view::npos; pos = header.find(name, pos + 1U)) {
+    if (pos == 0U || header[pos - 1U] != '"' || pos + name.size() >= header.size() ||
+        header[pos + name.size()] != '"') {
+      continue;
+    }
+    auto rest = header.substr(pos + name.size() + 1U);
+    auto const skip_space = [&rest, &is_space] {
+      while (!rest.empty() && is_space(rest.front())) {
+        rest.remove_prefix(1);
+      }
+    };
+    skip_space();
+    if (rest.empty() || rest.front() != ':') {
+      continue;
+    }
+    rest.remove_prefix(1);
+    skip_space();
+    if (rest.empty() || rest.front() != '"') {
+      return std::nullopt;
+    }
+    rest.remove_prefix(1);
+    auto const end = rest.find('"');
+    if (end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return rest.substr(0, end);
+  }
+  return std::nullopt;
+}
+
+}  // end namespace details
+
+/// \brief Caches the bodies of complete Property Exchange Get replies so that repeated inquiries for the same
+///   property of the same device need not be sent.
+///
+/// Entries are keyed by the device's MUID together with the resource name and resId. A 32-bit hash of the key
+/// indexes an adt::plru_cache so that, once full, the least recently used entries are replaced. The full key is
+/// stored with each entry so that hash collisions are detected.
+///
+/// Entries are invalidated when:
+/// - the device's MUID is invalidated;
+/// - a Subscription or Notify message arrives from the device whose subscribeId was associated with the entry by
+///   subscribe();
+/// - invalidate() is called explicitly.
+///
+/// Each of the Sets * Ways entries has a BodySize buffer within the cache object. A reply which does not fit is not
+/// cached.
+///
+/// \tparam Sets  The number of sets in the underlying plru_cache. Must be a power of two.
+/// \tparam Ways  The number of ways in each set of the underlying plru_cache. Must be a power of two.
+/// \tparam BodySize  The maximum combined size of the header and data of a cached reply.
+/// \tparam KeySize  The maximum combined length of a resource name and its resId.
+template <std::size_t Sets = 16, std::size_t Ways = 4, std::size_t BodySize = 1024, std::size_t KeySize = 64>
+class property_cache {
+public:
+  /// The maximum length of a subscribeId.
+  static constexpr auto max_subscribe_id_size = std::size_t{8};
+
+  /// A cached reply. The spans remain valid until the cache is next modified.
+  struct reply {
+    std::span<char const> header;
+    std::span<char const> data;
+  };
+
+  /// \brief Looks for a cached reply.
+  /// \returns The cached reply or std::nullopt if there is no valid entry for the key.
+  [[nodiscard]] std::optional<reply> find(muid const device, std::string_view const resource,
+                                          std::string_view const res_id) {
+    if (auto* const e = this->lookup(device, resource, res_id)) {
+      ++hits_;
+      auto const body = std::span{bodies_[e->slot]}.first(e->header_size + e->data_size);
+      return reply{.header = body.first(e->header_size), .data = body.subspan(e->header_size)};
+    }
+    ++misses_;
+    return std::nullopt;
+  }
+
+  /// \brief Records a reply received from a device. Typically called with the header and data of a complete Get
+  ///   reply, for example as delivered by property_exchange_assembler.
+  /// \param device  The MUID of the device which sent the reply.
+  /// \param resource  The resource named by the original inquiry.
+  /// \param res_id  The resId of the original inquiry or an empty string if it had none.
+  /// \param header  The reply's header.
+  /// \param data  The reply's data.
+  /// \returns False if the reply or key is too large to be cached.
+  bool store(muid const device, std::string_view const resource, std::string_view const res_id,
+             std::span<char const> const header, std::span<char const> const data) {
+    auto const k = make_key(device, resource, res_id);
+    if (!k || header.size() + data.size() > BodySize) {
+      return false;
+    }
+    auto& e = cache_.access(k->name.hash, make_entry, [](entry const&) { return true; });
+    if (e.key != *k) {
+      // A new entry or one whose slot is being reused for a different key: it has no subscription. Storing a fresh
+      // reply for the same key keeps the subscription so that later updates still invalidate it.
+      e.key = *k;
+      e.subscribe_id_size = 0;
+    }
+    e.valid = true;
+    e.header_size = header.size();
+    e.data_size = data.size();
+    std::ranges::copy(data, std::ranges::copy(header, bodies_[e.slot].begin()).out);
+    return true;
+  }
+
+  /// \brief Associates a subscription with a cached entry. Messages for the subscription will invalidate the entry.
+  /// \returns False if there is no valid entry for the key or \p subscribe_id is too long.
+  bool subscribe(muid const device, std::string_view const resource, std::string_view const res_id,
+                 std::string_view const subscribe_id) {
+    auto* const e = this->lookup(device, resource, res_id);
+    if (e == nullptr || subscribe_id.size() > max_subscribe_id_size) {
+      return false;
+    }
+    e->subscribe_id_size = subscribe_id.size();
+    std::ranges::copy(subscribe_id, e->subscribe_id.begin());
+    return true;
+  }
+
+  /// \brief Invalidates the entry for a single property.
+  /// \returns True if a valid entry was invalidated.
+  bool invalidate(muid const device, std::string_view const resource, std::string_view const res_id) {
+    if (auto* const e = this->lookup(device, resource, res_id)) {
+      e->valid = false;
+      return true;
+    }
+    return false;
+  }
+  /// \brief Invalidates every entry for \p device.
+  /// \returns The number of entries invalidated.
+  std::size_t invalidate(muid const device) {
+    return this->invalidate_if([device](entry const& e) { return e.key.device == device; });
+  }
+  /// \brief Handles an Invalidate MUID message by discarding the entries for its target MUID.
+  /// \returns The number of entries invalidated.
+  std::size_t invalidate(header const&, ci::invalidate_muid const& im) { return this->invalidate(im.target_muid); }
+  /// \brief Handles a Subscription or Notify message from a device by invalidating the entry associated with its
+  ///   subscribeId.
+  /// \returns The number of entries invalidated.
+  template <property_exchange::property_exchange_type Pet>
+    requires(Pet == property_exchange::property_exchange_type::subscription ||
+             Pet == property_exchange::property_exchange_type::notify)
+  std::size_t changed(header const& hdr, property_exchange::property_exchange<Pet> const& pe) {
+    auto const id = details::find_header_string(std::string_view{pe.header.data(), pe.header.size()}, "subscribeId");
+    if (!id) {
+      return 0;
+    }
+    return this->invalidate_if([&hdr, &id](entry const& e) {
+      return e.key.device == hdr.remote_muid &&
+             std::string_view{e.subscribe_id.data(), e.subscribe_id_size} == *id;
+    });
+  }
+
+  /// \returns The number of calls to find() which returned a cached reply.
+  [[nodiscard]] constexpr std::size_t hits() const noexcept { return hits_; }
+  /// \returns The number of calls to find() which did not return a cached reply.
+  [[nodiscard]] constexpr std::size_t misses() const noexcept { return misses_; }
+  /// \returns The maximum number of entries that the cache can hold.
+  [[nodiscard]] constexpr std::size_t max_size() const noexcept { return cache_.max_size(); }
+
+private:
+  struct key_type {
+    constexpr friend bool operator==(key_type const&, key_type const&) noexcept = default;
+    muid device;
+    /// The resource name and resId. Its hash also covers the device.
+    details::resource_key<KeySize> name;
+  };
+  struct entry {
+    /// The index of this entry's element of bodies_. It is the entry's position in the cache so it never changes.
+    std::size_t slot = 0;
+    key_type key;
+    bool valid = false;
+    std::size_t subscribe_id_size = 0;
+    std::array<char, max_subscribe_id_size> subscribe_id{};
+    std::size_t header_size = 0;
+    std::size_t data_size = 0;
+  };
+  /// The miss function for the cache. Reply bodies are held in bodies_ rather than in the entry so that populating an
+  /// entry does not build (and copy) a body-sized object.
+  static constexpr entry make_entry(std::uint32_t, std::size_t const slot) noexcept {
+    entry e;
+    e.slot = slot;
+    return e;
+  }
+
+  [[nodiscard]] static constexpr std::optional<key_type> make_key(muid const device, std::string_view const resource,
+                                                                  std::string_view const res_id) noexcept {
+    // FNV-1a over the MUID followed by the key characters.
+    auto seed = details::fnv1a_basis;
+    for (auto shift = 0U; shift < 32U; shift += 8U) {
+      seed = details::fnv1a(seed, static_cast<std::uint8_t>(device.get() >> shift));
+    }
+    auto const name = details::resource_key<KeySize>::make(resource, res_id, seed);
+    if (!name) {
+      return std::nullopt;
+    }
+    return key_type{.device = device, .name = *name};
+  }
+
+  /// \returns The valid entry matching the key or nullptr.
+  [[nodiscard]] entry* lookup(muid const device, std::string_view const resource, std::string_view const res_id) {
+    auto const k = make_key(device, resource, res_id);
+    if (!k || !cache_.contains(k->name.hash)) {
+      return nullptr;
+    }
+    // The key is present so access() will not call the miss function.
+    auto& e = cache_.access(k->name.hash, make_entry, [](entry const&) { return true; });
+    return e.valid && e.key == *k ? &e : nullptr;
+  }
+  template <typename Predicate> std::size_t invalidate_if(Predicate predicate) {
+    auto count = std::size_t{0};
+    for (auto&& kv : cache_) {
+      if (auto& e = kv.second; e.valid && predicate(e)) {
+        e.valid = false;
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+  adt::plru_cache<std::uint32_t, entry, Sets, Ways> cache_;
+  std::array<std::array<char, BodySize>, Sets * Ways> bodies_;
+};
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_PROPERTY_CACHE_HPP
@@ -0,0 +1,267 @@
+//===-- CI Property Exchange Assembler ----------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_property_exchange_assembler.hpp
+/// \brief A MIDI CI dispatcher backend which reassembles multi-chunk Property Exchange messages.
+
+#ifndef MIDI2_CI_PROPERTY_EXCHANGE_ASSEMBLER_HPP
+#define MIDI2_CI_PROPERTY_EXCHANGE_ASSEMBLER_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+
+#include "midi2/adt/arena.hpp"
+#include "midi2/ci/ci_dispatcher_backend.hpp"
+#include "midi2/ci/ci_types.hpp"
+#include "midi2/utils.hpp"
+
+namespace midi2::ci::dispatcher_backend {
+
+/// \brief A property_exchange backend which gathers the chunks of multi-chunk Property Exchange messages and passes
+///   each complete message to a second property_exchange backend as a single chunk.
+///
+/// In-flight messages are tracked by the remote MUID and request ID in a table of \p Requests entries. The header
+/// and data of each are accumulated in a shared adt::arena of \p PoolSize characters so that no memory is allocated
+/// per message. A chunk is copied once on arrival whatever the order in which the chunks of different messages are
+/// received, and the assembled message is made contiguous in place when its last chunk arrives. Messages consisting
+/// of a single chunk and the capabilities messages are forwarded without being copied.
+///
+/// A sender which does not know how many chunks a message will need sets number_of_chunks to zero. The message is
+/// then complete when a chunk arrives whose number_of_chunks is equal to its chunk_number.
+///
+/// A message is abandoned and reported to the function passed to on_error() if:
+/// - a chunk is missing or arrives out of order;
+/// - there is no free table entry or insufficient pool space for it;
+/// - no chunk has been received for it within the timeout period. Stale entries are reclaimed by expire() which is
+///   also called automatically when the table or pool is full.
+///
+/// \tparam Context  The dispatcher context type.
+/// \tparam Backend  The property_exchange backend to which complete messages are delivered.
+/// \tparam Requests  The maximum number of messages that can be assembled concurrently.
+/// \tparam PoolSize  The total number of header and data characters available to the messages being assembled.
+/// \tparam Clock  The clock used to time out stale messages.
+template <typename Context, property_exchange<Context> Backend, std::size_t Requests = 16,
+          std::size_t PoolSize = 32768, typename Clock = std::chrono::steady_clock>
+class property_exchange_assembler {
+public:
+  /// The reasons for which a message may be abandoned.
+  enum class error : std::uint8_t {
+    missing_chunk,  ///< A chunk was received without its predecessor.
+    out_of_order,   ///< A chunk was repeated, was inconsistent with earlier chunks, or a message was restarted.
+    table_full,     ///< There were already Requests messages in flight.
+    overflow,       ///< The pool had insufficient space for the message.
+    timeout,        ///< No chunk of the message was received within the timeout period.
+  };
+  using error_fn = std::function<void(header const &, b7 request, error)>;
+
+  constexpr explicit property_exchange_assembler(Backend backend = Backend{}) : backend_{std::move(backend)} {}
+
+  // clang-format off
+  constexpr property_exchange_assembler &on_error(error_fn err) { error_ = std::move(err); return *this; }
+  /// Sets the time after which a partially received message is considered stale.
+  constexpr property_exchange_assembler &timeout(typename Clock::duration const t) noexcept { timeout_ = t; return *this; }
+
+  [[nodiscard]] constexpr Backend &backend() noexcept { return backend_; }
+  [[nodiscard]] constexpr Backend const &backend() const noexcept { return backend_; }
+
+  void capabilities(Context c, header const &h, ci::property_exchange::capabilities const &cap) { backend_.capabilities(c, h, cap); }
+  void capabilities_reply(Context c, header const &h, ci::property_exchange::capabilities_reply const &reply) { backend_.capabilities_reply(c, h, reply); }
+
+  void get(Context c, header const &h, ci::property_exchange::get const &get) { this->assemble(c, h, get); }
+  void get_reply(Context c, header const &h, ci::property_exchange::get_reply const &reply) { this->assemble(c, h, reply); }
+  void set(Context c, header const &h, ci::property_exchange::set const &set) { this->assemble(c, h, set); }
+  void set_reply(Context c, header const &h, ci::property_exchange::set_reply const &reply) { this->assemble(c, h, reply); }
+
+  void subscription(Context c, header const &h, ci::property_exchange::subscription const &sub) { this->assemble(c, h, sub); }
+  void subscription_reply(Context c, header const &h, ci::property_exchange::subscription_reply const &reply) { this->assemble(c, h, reply); }
+  void notify(Context c, header const &h, ci::property_exchange::notify const &notify) { this->assemble(c, h, notify); }
+  // clang-format on
+
+  /// \brief Abandons any message for which no chunk has been received within the timeout period.
+  void expire() {
+    auto const now = Clock::now();
+    for (auto index = std::size_t{0}; index < Requests; ++index) {
+      if (auto &e = entries_[index]; e.in_use && now - e.last_seen >= timeout_) {
+        this->abandon(index, error::timeout);
+      }
+    }
+  }
+  /// \returns The number of messages currently being assembled.
+  [[nodiscard]] constexpr std::size_t in_flight() const noexcept {
+    return static_cast<std::size_t>(std::ranges::count_if(entries_, [](entry const &e) { return e.in_use; }));
+  }
+
+private:
+  struct entry {
+    /// The header of the most recently received chunk.
+    header hdr;
+    typename Clock::time_point last_seen{};
+    ci::property_exchange::property_exchange_type type = ci::property_exchange::property_exchange_type::get;
+    b7 request;
+    /// The total number of chunks or zero if the sender did not know it when the message was started.
+    std::uint16_t number_of_chunks = 0;
+    /// The number of the chunk expected next.
+    std::uint16_t next_chunk = 0;
+    /// The number of characters at the start of the entry's arena segment which form the message header.
+    std::uint16_t header_size = 0;
+    bool in_use = false;
+  };
+
+  template <ci::property_exchange::property_exchange_type Pet>
+  void assemble(Context c, header const &h, ci::property_exchange::property_exchange<Pet> const &pe) {
+    auto const number_of_chunks = pe.chunk.number_of_chunks.get();
+    auto const chunk_number = pe.chunk.chunk_number.get();
+    auto index = this->find(h.remote_muid, pe.request);
+    if (chunk_number == 1U) {
+      if (index < Requests) {
+        // The previous message using this request ID was never completed.
+        this->report(h, pe.request, error::out_of_order);
+        this->abandon(index);
+      }
+      if (number_of_chunks == 1U) {
+        this->forward(c, h, pe);
+        return;
+      }
+      index = this->allocate(h, pe);
+      if (index >= Requests) {
+        return;
+      }
+    } else {
+      if (index >= Requests) {
+        this->report(h, pe.request, error::missing_chunk);
+        return;
+      }
+      auto const &e = entries_[index];
+      auto const consistent = e.type == Pet && (e.number_of_chunks == number_of_chunks ||
+                                                (e.number_of_chunks == 0U && number_of_chunks == chunk_number));
+      if (!consistent || chunk_number != e.next_chunk) {
+        this->abandon(index, consistent && chunk_number > e.next_chunk ? error::missing_chunk : error::out_of_order);
+        return;
+      }
+    }
+    if (!this->append(index, pe.data)) {
+      return;
+    }
+    auto &e = entries_[index];
+    e.hdr = h;
+    e.last_seen = Clock::now();
+    ++e.next_chunk;
+    if (chunk_number == number_of_chunks) {
+      auto const content = pool_.gather(index);
+      constexpr auto single = ci::property_exchange::chunk_info{.number_of_chunks = b14{1U}, .chunk_number = b14{1U}};
+      this->forward(c, h,
+                    ci::property_exchange::property_exchange<Pet>::make(
+                        single, pe.request, content.first(e.header_size), content.subspan(e.header_size)));
+      this->abandon(index);
+    }
+  }
+
+  /// \returns The index of the in-flight message from \p muid with request ID \p request or Requests if there is
+  ///   none.
+  [[nodiscard]] std::size_t find(muid const muid, b7 const request) const noexcept {
+    auto const pos = std::ranges::find_if(
+        entries_, [&](entry const &e) { return e.in_use && e.hdr.remote_muid == muid && e.request == request; });
+    return static_cast<std::size_t>(pos - entries_.begin());
+  }
+
+  /// Claims a table entry for a new message whose first chunk is \p pe and copies the chunk's header to the pool.
+  /// \returns The index of the new entry or Requests if none could be allocated.
+  template <ci::property_exchange::property_exchange_type Pet>
+  std::size_t allocate(header const &h, ci::property_exchange::property_exchange<Pet> const &pe) {
+    auto const is_free = [](entry const &e) { return !e.in_use; };
+    auto pos = std::ranges::find_if(entries_, is_free);
+    if (pos == entries_.end()) {
+      this->expire();
+      pos = std::ranges::find_if(entries_, is_free);
+      if (pos == entries_.end()) {
+        this->report(h, pe.request, error::table_full);
+        return Requests;
+      }
+    }
+    *pos = entry{.hdr = h,
+                 .last_seen = Clock::now(),
+                 .type = Pet,
+                 .request = pe.request,
+                 .number_of_chunks = pe.chunk.number_of_chunks.get(),
+                 .next_chunk = 1U,
+                 .header_size = static_cast<std::uint16_t>(pe.header.size()),
+                 .in_use = true};
+    auto const index = static_cast<std::size_t>(pos - entries_.begin());
+    return this->append(index, pe.header) ? index : Requests;
+  }
+
+  /// Appends \p chars to the pool segment belonging to entry \p index. On failure, the message is abandoned.
+  bool append(std::size_t const index, std::span<char const> const chars) {
+    if (pool_.append(index, chars)) {
+      return true;
+    }
+    // Reclaim the space used by any stale messages and try again.
+    this->expire();
+    if (entries_[index].in_use && pool_.append(index, chars)) {
+      return true;
+    }
+    if (entries_[index].in_use) {
+      this->abandon(index, error::overflow);
+    }
+    return false;
+  }
+
+  void report(header const &h, b7 const request, error const err) const { call(error_, h, request, err); }
+  /// Releases the table entry \p index and its pool segment.
+  void abandon(std::size_t const index) noexcept {
+    entries_[index].in_use = false;
+    pool_.clear(index);
+  }
+  void abandon(std::size_t const index, error const err) {
+    auto const &e = entries_[index];
+    this->report(e.hdr, e.request, err);
+    this->abandon(index);
+  }
+
+  template <ci::property_exchange::property_exchange_type Pet>
+  void forward(Context c, header const &h, ci::property_exchange::property_exchange<Pet> const &pe) {
+    using enum ci::property_exchange::property_exchange_type;
+    if constexpr (Pet == get) {
+      backend_.get(c, h, pe);
+    } else if constexpr (Pet == get_reply) {
+      backend_.get_reply(c, h, pe);
+    } else if constexpr (Pet == set) {
+      backend_.set(c, h, pe);
+    } else if constexpr (Pet == set_reply) {
+      backend_.set_reply(c, h, pe);
+    } else if constexpr (Pet == subscription) {
+      backend_.subscription(c, h, pe);
+    } else if constexpr (Pet == subscription_reply) {
+      backend_.subscription_reply(c, h, pe);
+    } else {
+      static_assert(Pet == notify);
+      backend_.notify(c, h, pe);
+    }
+  }
+
+  Backend backend_;
+  error_fn error_;
+  typename Clock::duration timeout_ = std::chrono::duration_cast<typename Clock::duration>(std::chrono::seconds{3});
+  std::array<entry, Requests> entries_{};
+  adt::arena<char, Requests, PoolSize> pool_;
+};
+
+static_assert(property_exchange<property_exchange_assembler<int, property_exchange_null<int>>, int>,
+              "property_exchange_assembler must implement the property_exchange concept");
+
+}  // end namespace midi2::ci::dispatcher_backend
+
+#endif  // MIDI2_CI_PROPERTY_EXCHANGE_ASSEMBLER_HPP
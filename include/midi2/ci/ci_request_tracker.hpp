@@ -0,0 +1,480 @@
+//===-- CI Request Tracker ----------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_request_tracker.hpp
+/// \brief Tracks MIDI-CI requests awaiting a reply, allocating their request IDs and handling retries and timeouts.
+
+#ifndef MIDI2_CI_REQUEST_TRACKER_HPP
+#define MIDI2_CI_REQUEST_TRACKER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+
+#include "midi2/adt/uinteger.hpp"
+#include "midi2/ci/ci_muid_table.hpp"
+#include "midi2/ci/ci_types.hpp"
+#include "midi2/utils.hpp"
+
+namespace midi2::ci {
+
+/// \brief Records the requests that have been sent to remote MIDI-CI devices and are waiting for a reply.
+///
+/// Each request is given a request ID from a 128-entry bitmap kept for its remote MUID. IDs are handed out in rotation
+/// so that a late reply to a request which timed out is unlikely to be mistaken for the reply to a new one. The
+/// requests for each remote MUID form a list so that correlating a reply touches only that device's requests.
+///
+/// Deadlines are kept in a three-level hierarchical timer wheel of 64 slots per level. Starting a timer and
+/// expiring a slot take constant time regardless of the number of requests in flight, and expire() steps directly
+/// to the next slot that holds a timer rather than through every tick that has elapsed. The wheel covers 2^18 ticks of
+/// the resolution() period; longer timeouts are shortened to fit.
+///
+/// Replies are correlated as follows:
+/// - Property Exchange replies by their request ID. A reply which is not the final chunk restarts the request's
+///   timer. A reply whose number_of_chunks is zero is not the final chunk; the final chunk is the one whose
+///   chunk_number equals its number_of_chunks.
+/// - ACK and NAK messages for Property Exchange inquiries by the request ID in the first byte of their details field,
+///   and otherwise by their original transaction sub-ID#2.
+/// - Other replies (for example, a Reply to Profile Details Inquiry) by the sub-ID#2 of the message that was sent. If
+///   more than one such request is in flight to the same device, the oldest is completed.
+///
+/// The tracker's tables are fixed in size when it is constructed. Only the std::function callbacks passed to
+/// on_retry() and on_complete() may allocate. The tracker is not thread-safe.
+///
+/// \tparam Requests  The maximum number of requests that may be in flight at once.
+/// \tparam Remotes  The number of slots in the details::muid_table of remote MUIDs. Must be a power of two; at most
+///   three quarters of the slots are used.
+/// \tparam Clock  The clock used to time requests.
+template <std::size_t Requests = 64, std::size_t Remotes = 64, typename Clock = std::chrono::steady_clock>
+  requires(Requests > 0 && Requests < 65535 && Remotes >= 4 && std::has_single_bit(Remotes))
+class request_tracker {
+public:
+  using duration = typename Clock::duration;
+  /// The ways in which a request may be completed.
+  enum class outcome : std::uint8_t {
+    ack,      ///< The remote device sent an ACK message.
+    nak,      ///< The remote device sent a NAK message.
+    reply,    ///< The remote device replied.
+    timeout,  ///< No reply was received after all retries were exhausted.
+  };
+  /// Called when a request's timer expires and it is to be sent again.
+  using retry_fn = std::function<void(muid remote, b7 request_id, message sent, std::uint32_t cookie)>;
+  /// Called when a request completes.
+  using complete_fn = std::function<void(muid remote, b7 request_id, std::uint32_t cookie, outcome)>;
+
+  /// \param resolution  The period of a tick of the timer wheel. Timeouts are rounded up to a whole number of ticks.
+  explicit request_tracker(
+      duration const resolution = std::chrono::duration_cast<duration>(std::chrono::milliseconds{10}))
+      : resolution_{resolution}, epoch_{Clock::now()} {
+    assert(resolution > duration::zero());
+    wheel_.fill(none);
+    for (auto index = std::size_t{0}; index < Requests; ++index) {
+      entries_[index].next = static_cast<index_type>(index + 1U);
+    }
+  }
+
+  // clang-format off
+  request_tracker &on_retry(retry_fn retry) { retry_ = std::move(retry); return *this; }
+  request_tracker &on_complete(complete_fn complete) { complete_ = std::move(complete); return *this; }
+  // clang-format on
+
+  /// \brief Starts tracking a request.
+  /// \param remote  The MUID of the device to which the request is sent.
+  /// \param sent  The sub-ID#2 of the request message.
+  /// \param cookie  A value which is passed to the retry and completion callbacks.
+  /// \param timeout  The time allowed for a reply before the request is retried or abandoned.
+  /// \param retries  The number of times the request is retried before it is abandoned.
+  /// \returns The request ID to be placed in the message or std::nullopt if the maximum number of requests are
+  ///   already in flight or all 128 request IDs for \p remote are in use.
+  std::optional<b7> issue(muid const remote, message const sent, std::uint32_t const cookie, duration const timeout,
+                          std::uint8_t const retries = 0) {
+    if (free_ == none) {
+      return std::nullopt;
+    }
+    auto* const r = this->find_or_insert_remote(remote);
+    if (r == nullptr) {
+      return std::nullopt;
+    }
+    auto const id = r->allocate();
+    if (!id) {
+      this->erase_remote_if_idle(remote);
+      return std::nullopt;
+    }
+    auto const index = free_;
+    auto& e = entries_[index];
+    free_ = e.next;
+    e = entry{.remote = remote,
+              .cookie = cookie,
+              .timeout = this->to_ticks(timeout),
+              .sent = sent,
+              .id = *id,
+              .retries = retries,
+              .next_for_remote = r->head};
+    r->head = index;
+    this->arm(index);
+    ++size_;
+    return id;
+  }
+
+  /// \brief Stops tracking a request without calling the completion callback.
+  /// \returns True if the request was in flight.
+  bool cancel(muid const remote, b7 const request_id) {
+    auto const index = this->find_by_id(remote, request_id);
+    if (index == none) {
+      return false;
+    }
+    this->release(index);
+    return true;
+  }
+
+  /// \brief Handles an ACK message from the dispatcher's management.ack() handler.
+  /// \returns True if the message completed a request.
+  bool ack(header const& hdr, ci::ack const& a) {
+    return this->acknowledge(hdr.remote_muid, a.original_id, a.details[0], outcome::ack);
+  }
+  /// \brief Handles a NAK message from the dispatcher's management.nak() handler.
+  /// \returns True if the message completed a request.
+  bool nak(header const& hdr, ci::nak const& n) {
+    return this->acknowledge(hdr.remote_muid, n.original_id, n.details[0], outcome::nak);
+  }
+  /// \brief Handles a Property Exchange reply (get_reply, set_reply, or subscription_reply).
+  /// \returns True if the message belongs to a request that is in flight.
+  template <property_exchange::property_exchange_type Pet>
+  bool reply(header const& hdr, property_exchange::property_exchange<Pet> const& pe) {
+    auto const index = this->find_by_id(hdr.remote_muid, pe.request);
+    if (index == none) {
+      return false;
+    }
+    auto const number_of_chunks = pe.chunk.number_of_chunks.get();
+    auto const chunk_number = pe.chunk.chunk_number.get();
+    if (number_of_chunks == 0U || chunk_number < number_of_chunks) {
+      // More chunks are to come (a count of zero means that the sender does not yet know how many there will be):
+      // allow the full timeout for the next one.
+      this->disarm(index);
+      this->arm(index);
+      return true;
+    }
+    if (chunk_number != number_of_chunks) {
+      return false;
+    }
+    this->complete(index, outcome::reply);
+    return true;
+  }
+  /// \brief Handles a reply which carries no request ID.
+  /// \param hdr  The header of the reply.
+  /// \param sent  The sub-ID#2 of the request to which this is a reply.
+  /// \returns True if the message completed a request.
+  bool reply(header const& hdr, message const sent) {
+    auto const index = this->find_oldest(hdr.remote_muid, sent);
+    if (index == none) {
+      return false;
+    }
+    this->complete(index, outcome::reply);
+    return true;
+  }
+
+  /// \brief Retries or abandons the requests whose timers have expired.
+  void expire() {
+    auto const target = this->now_ticks();
+    while (tick_ < target) {
+      // Skip straight to the next tick at which a slot is due so that the cost does not grow with the time since the
+      // last call.
+      auto const next = this->next_due();
+      if (next > target) {
+        tick_ = target;
+        break;
+      }
+      tick_ = next;
+      if ((tick_ & slot_mask) == 0U) {
+        // Move the timers from the next slot of each higher level to the level below.
+        for (auto level = 1U; level < levels; ++level) {
+          auto const slot = (tick_ >> (level * slot_bits)) & slot_mask;
+          this->cascade(level * slots + slot);
+          if (slot != 0U) {
+            break;
+          }
+        }
+      }
+      // A callback may cancel or complete other requests so take the timers from the slot one at a time.
+      for (auto const slot = tick_ & slot_mask; wheel_[slot] != none;) {
+        auto const index = wheel_[slot];
+        this->disarm(index);
+        this->timeout(index);
+      }
+    }
+  }
+
+  /// \returns The number of requests in flight.
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+  /// \returns True if no requests are in flight.
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0U; }
+  /// \returns The period of a tick of the timer wheel.
+  [[nodiscard]] constexpr duration resolution() const noexcept { return resolution_; }
+
+private:
+  using index_type = adt::uinteger_t<static_cast<unsigned>(std::bit_width(Requests))>;
+  static constexpr auto none = static_cast<index_type>(Requests);
+
+  static constexpr auto slot_bits = 6U;
+  static constexpr auto slots = 1U << slot_bits;
+  static constexpr auto slot_mask = slots - 1U;
+  static constexpr auto levels = 3U;
+  static constexpr auto max_ticks = (std::uint32_t{1} << (slot_bits * levels)) - 1U;
+
+  struct entry {
+    muid remote;
+    std::uint32_t cookie = 0;
+    /// The request's timeout in ticks.
+    std::uint32_t timeout = 0;
+    /// The tick at which the request's timer expires.
+    std::uint64_t expires = 0;
+    message sent = message::ack;
+    b7 id;
+    std::uint8_t retries = 0;
+    /// The timer wheel slot holding this entry.
+    std::uint16_t slot = 0;
+    /// Links for the entry's timer wheel slot or, when not in use, the free list.
+    index_type prev = none;
+    index_type next = none;
+    /// The next request sent to the same remote MUID.
+    index_type next_for_remote = none;
+  };
+
+  struct remote_entry {
+    /// Allocates the next free request ID following the one most recently allocated.
+    constexpr std::optional<b7> allocate() noexcept {
+      auto const free_from = [this](unsigned const from) -> std::optional<unsigned> {
+        for (auto word = from / 64U; word < ids.size(); ++word) {
+          auto bits = ~ids[word];
+          if (word == from / 64U) {
+            bits &= ~std::uint64_t{0} << (from % 64U);
+          }
+          if (bits != 0U) {
+            return word * 64U + static_cast<unsigned>(std::countr_zero(bits));
+          }
+        }
+        return std::nullopt;
+      };
+      auto const id = free_from(next_id).or_else([&free_from] { return free_from(0U); });
+      if (!id) {
+        return std::nullopt;
+      }
+      ids[*id / 64U] |= std::uint64_t{1} << (*id % 64U);
+      next_id = (*id + 1U) % 128U;
+      return b7{static_cast<std::uint8_t>(*id)};
+    }
+    constexpr void free(b7 const id) noexcept { ids[id.get() / 64U] &= ~(std::uint64_t{1} << (id.get() % 64U)); }
+    [[nodiscard]] constexpr bool idle() const noexcept { return ids[0] == 0U && ids[1] == 0U; }
+
+    std::uint32_t key = unused;
+    std::array<std::uint64_t, 2> ids{};
+    unsigned next_id = 0;
+    /// The most recently issued request for this MUID.
+    index_type head = none;
+  };
+  static constexpr auto unused = ~std::uint32_t{0};
+  struct remote_traits {
+    static constexpr remote_entry vacant() noexcept { return remote_entry{}; }
+    static constexpr bool is_vacant(remote_entry const& r) noexcept { return r.key == unused; }
+    static constexpr std::uint32_t key(remote_entry const& r) noexcept { return r.key; }
+  };
+
+  [[nodiscard]] std::uint64_t now_ticks() const {
+    return static_cast<std::uint64_t>((Clock::now() - epoch_) / resolution_);
+  }
+  [[nodiscard]] constexpr std::uint32_t to_ticks(duration const d) const noexcept {
+    // Round up so that a request is never timed out early.
+    auto const ticks = (d + resolution_ - duration{1}) / resolution_;
+    return static_cast<std::uint32_t>(std::clamp(ticks, decltype(ticks){1}, static_cast<decltype(ticks)>(max_ticks)));
+  }
+
+  /// Starts the timer for entry \p index: it expires timeout ticks from now.
+  void arm(index_type const index) {
+    auto& e = entries_[index];
+    e.expires = std::max(this->now_ticks(), tick_) + e.timeout;
+    this->insert(index);
+  }
+  /// Adds entry \p index to the wheel slot appropriate for its expiry time. If expire() has not been called for a
+  /// while, the expiry time may lie beyond the reach of the wheel. The entry is then placed in the furthest slot and
+  /// its position is recalculated when that slot is cascaded.
+  constexpr void insert(index_type const index) noexcept {
+    auto& e = entries_[index];
+    auto const delta = std::min(e.expires - tick_, std::uint64_t{max_ticks});
+    auto const at = tick_ + delta;
+    auto level = 0U;
+    while (level < levels - 1U && delta >= (std::uint64_t{1} << ((level + 1U) * slot_bits))) {
+      ++level;
+    }
+    e.slot = static_cast<std::uint16_t>(level * slots + ((at >> (level * slot_bits)) & slot_mask));
+    e.prev = none;
+    e.next = wheel_[e.slot];
+    if (e.next != none) {
+      entries_[e.next].prev = index;
+    }
+    wheel_[e.slot] = index;
+    occupied_[level] |= std::uint64_t{1} << (e.slot & slot_mask);
+  }
+  /// Removes entry \p index from its timer wheel slot.
+  constexpr void disarm(index_type const index) noexcept {
+    auto const& e = entries_[index];
+    if (e.prev == none) {
+      wheel_[e.slot] = e.next;
+      if (e.next == none) {
+        occupied_[e.slot / slots] &= ~(std::uint64_t{1} << (e.slot & slot_mask));
+      }
+    } else {
+      entries_[e.prev].next = e.next;
+    }
+    if (e.next != none) {
+      entries_[e.next].prev = e.prev;
+    }
+  }
+  /// Redistributes the timers in wheel slot \p slot to lower levels.
+  constexpr void cascade(std::size_t const slot) noexcept {
+    auto index = std::exchange(wheel_[slot], none);
+    occupied_[slot / slots] &= ~(std::uint64_t{1} << (slot & slot_mask));
+    while (index != none) {
+      auto const next = entries_[index].next;
+      this->insert(index);
+      index = next;
+    }
+  }
+  /// \returns The first tick after tick_ at which a non-empty slot expires or is cascaded, or the maximum tick value
+  ///   if no timers are armed.
+  [[nodiscard]] constexpr std::uint64_t next_due() const noexcept {
+    auto result = std::numeric_limits<std::uint64_t>::max();
+    for (auto level = 0U; level < levels; ++level) {
+      if (auto const occupied = occupied_[level]; occupied != 0U) {
+        // The slots of this level are visited in turn, one every 64^level ticks, starting with the next.
+        auto const shift = level * slot_bits;
+        auto const turn = (tick_ >> shift) + 1U;
+        auto const skip = std::countr_zero(std::rotr(occupied, static_cast<int>(turn & slot_mask)));
+        result = std::min(result, (turn + static_cast<unsigned>(skip)) << shift);
+      }
+    }
+    return result;
+  }
+  /// Called when the timer for entry \p index expires. The entry has already been removed from the wheel.
+  void timeout(index_type const index) {
+    auto& e = entries_[index];
+    if (e.retries == 0U) {
+      this->complete(index, outcome::timeout, false);
+      return;
+    }
+    --e.retries;
+    this->arm(index);
+    call(retry_, e.remote, e.id, e.sent, e.cookie);
+  }
+
+  [[nodiscard]] constexpr remote_entry* find_remote(muid const m) noexcept { return remotes_.find(m); }
+  constexpr remote_entry* find_or_insert_remote(muid const m) noexcept {
+    return remotes_.insert(m, remote_entry{.key = m.get()}).first;
+  }
+  /// Removes the table entry for \p m if it has no requests in flight.
+  constexpr void erase_remote_if_idle(muid const m) noexcept {
+    if (auto const* const r = remotes_.find(m); r != nullptr && r->idle()) {
+      remotes_.erase(r);
+    }
+  }
+
+  [[nodiscard]] constexpr index_type find_by_id(muid const remote, b7 const id) noexcept {
+    if (auto const* const r = this->find_remote(remote)) {
+      for (auto index = r->head; index != none; index = entries_[index].next_for_remote) {
+        if (entries_[index].id == id) {
+          return index;
+        }
+      }
+    }
+    return none;
+  }
+  /// Finds the oldest request to \p remote with message type \p sent. Requests are added to the head of each
+  /// remote's list so this is the last match.
+  [[nodiscard]] constexpr index_type find_oldest(muid const remote, message const sent) noexcept {
+    auto result = none;
+    if (auto const* const r = this->find_remote(remote)) {
+      for (auto index = r->head; index != none; index = entries_[index].next_for_remote) {
+        if (entries_[index].sent == sent) {
+          result = index;
+        }
+      }
+    }
+    return result;
+  }
+  [[nodiscard]] static constexpr bool has_request_id(message const m) noexcept {
+    return m == message::pe_get || m == message::pe_set || m == message::pe_sub;
+  }
+  bool acknowledge(muid const remote, b7 const original_id, b7 const detail, outcome const o) {
+    auto const sent = static_cast<message>(original_id.get());
+    auto const index = has_request_id(sent) ? this->find_by_id(remote, detail) : this->find_oldest(remote, sent);
+    if (index == none) {
+      return false;
+    }
+    this->complete(index, o);
+    return true;
+  }
+  /// Releases entry \p index and reports its completion.
+  void complete(index_type const index, outcome const o, bool const armed = true) {
+    auto const& e = entries_[index];
+    auto const remote = e.remote;
+    auto const id = e.id;
+    auto const cookie = e.cookie;
+    this->release(index, armed);
+    call(complete_, remote, id, cookie, o);
+  }
+  /// Removes entry \p index from the timer wheel and its remote's list and returns it to the free list.
+  constexpr void release(index_type const index, bool const armed = true) noexcept {
+    auto& e = entries_[index];
+    if (armed) {
+      this->disarm(index);
+    }
+    auto* const r = this->find_remote(e.remote);
+    assert(r != nullptr);
+    if (r->head == index) {
+      r->head = e.next_for_remote;
+    } else {
+      auto prev = r->head;
+      while (entries_[prev].next_for_remote != index) {
+        prev = entries_[prev].next_for_remote;
+      }
+      entries_[prev].next_for_remote = e.next_for_remote;
+    }
+    r->free(e.id);
+    this->erase_remote_if_idle(e.remote);
+    e.next = free_;
+    free_ = index;
+    --size_;
+  }
+
+  retry_fn retry_;
+  complete_fn complete_;
+  duration resolution_;
+  typename Clock::time_point epoch_;
+  /// The most recent tick processed by expire().
+  std::uint64_t tick_ = 0;
+  std::size_t size_ = 0;
+  index_type free_ = 0;
+  std::array<index_type, levels * slots> wheel_{};
+  /// A bit for each non-empty slot of each level of the wheel.
+  std::array<std::uint64_t, levels> occupied_{};
+  std::array<entry, Requests> entries_{};
+  details::muid_table<remote_entry, Remotes, remote_traits> remotes_;
+};
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_REQUEST_TRACKER_HPP
@@ -0,0 +1,72 @@
+//===-- CI Resource Key -------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_resource_key.hpp
+/// \brief A fixed-size, hashed key formed from a Property Exchange resource name and resId.
+
+#ifndef MIDI2_CI_RESOURCE_KEY_HPP
+#define MIDI2_CI_RESOURCE_KEY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace midi2::ci::details {
+
+/// The FNV-1a offset basis: the hash of an empty sequence.
+inline constexpr auto fnv1a_basis = std::uint32_t{2166136261U};
+
+/// \returns \p hash updated with byte \p b using 32-bit FNV-1a.
+[[nodiscard]] constexpr std::uint32_t fnv1a(std::uint32_t const hash, std::uint8_t const b) noexcept {
+  return (hash ^ b) * 16777619U;
+}
+
+/// \brief A resource name and resId separated by a NUL character together with their FNV-1a hash.
+/// \tparam KeySize  The maximum combined length of a resource name and its resId.
+template <std::size_t KeySize> struct resource_key {
+  /// \brief Builds the key for \p resource and \p res_id.
+  /// \param seed  The initial value of the hash. Callers which key on more than the resource may pass the hash of
+  ///   the additional fields.
+  /// \returns The key or std::nullopt if \p resource and \p res_id together are longer than KeySize.
+  [[nodiscard]] static constexpr std::optional<resource_key> make(std::string_view const resource,
+                                                                  std::string_view const res_id,
+                                                                  std::uint32_t const seed = fnv1a_basis) noexcept {
+    if (resource.size() + res_id.size() > KeySize) {
+      return std::nullopt;
+    }
+    resource_key key;
+    auto out = std::ranges::copy(resource, key.chars.begin()).out;
+    *(out++) = '\0';
+    out = std::ranges::copy(res_id, out).out;
+    key.size = static_cast<std::size_t>(out - key.chars.begin());
+    key.hash = seed;
+    for (auto const c : std::span{key.chars}.first(key.size)) {
+      key.hash = fnv1a(key.hash, static_cast<std::uint8_t>(c));
+    }
+    return key;
+  }
+
+  constexpr friend bool operator==(resource_key const& lhs, resource_key const& rhs) noexcept {
+    return lhs.hash == rhs.hash && lhs.size == rhs.size &&
+           std::ranges::equal(std::span{lhs.chars}.first(lhs.size), std::span{rhs.chars}.first(rhs.size));
+  }
+
+  std::uint32_t hash = 0;
+  std::size_t size = 0;
+  std::array<char, KeySize + 1> chars{};
+};
+
+}  // end namespace midi2::ci::details
+
+#endif  // MIDI2_CI_RESOURCE_KEY_HPP
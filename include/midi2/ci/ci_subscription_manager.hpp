@@ -0,0 +1,348 @@
+//===-- CI Subscription Manager -----------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ci_subscription_manager.hpp
+/// \brief Records Property Exchange subscriptions and sends each subscriber the updates to the resources that it has
+///   subscribed to.
+
+#ifndef MIDI2_CI_SUBSCRIPTION_MANAGER_HPP
+#define MIDI2_CI_SUBSCRIPTION_MANAGER_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "midi2/adt/spsc_fifo.hpp"
+#include "midi2/adt/uinteger.hpp"
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_resource_key.hpp"
+#include "midi2/ci/ci_types.hpp"
+
+namespace midi2::ci {
+
+/// \brief The subscription responder's side of Property Exchange subscriptions.
+///
+/// The manager is shared by two threads:
+/// - The I/O thread, which receives MIDI-CI messages, records subscriptions with subscribe() and unsubscribe(), and
+///   sends queued updates by calling flush().
+/// - A control thread, which calls publish() when the value of a resource changes.
+///
+/// publish() serializes the Subscription message carrying the update just once, with a placeholder subscribeId. The
+/// message travels to the I/O thread through a wait-free single-producer/single-consumer FIFO. flush() then stamps the
+/// destination MUID, request ID, and subscribeId for each subscriber in turn: nothing else is rebuilt. Neither side
+/// takes a lock and the subscription table is only ever touched by the I/O thread.
+///
+/// Subscriptions are stored as parallel arrays so that finding the subscribers to a resource scans a contiguous
+/// array of resource indices, each of the smallest unsigned type that can hold Subscriptions. The Queue message
+/// buffers belong to the manager so publish() never allocates on the control thread.
+///
+/// \tparam Subscriptions  The maximum number of subscriptions.
+/// \tparam MessageSize  The maximum size of an update message in bytes (excluding the 0xF0/0xF7 framing).
+/// \tparam Queue  The number of updates that may be waiting for flush(). Must be a power of two.
+/// \tparam KeySize  The maximum combined length of a resource name and its resId.
+template <std::size_t Subscriptions = 64, std::size_t MessageSize = 512, std::size_t Queue = 8,
+          std::size_t KeySize = 64>
+  requires(Subscriptions > 0 && Subscriptions < 65535 && Queue > 1 && Queue <= 128 && std::has_single_bit(Queue))
+class subscription_manager {
+public:
+  /// The number of characters in a subscribeId.
+  static constexpr auto subscribe_id_size = std::size_t{8};
+  using subscribe_id = std::array<char, subscribe_id_size>;
+
+  /// The "command" value of an update.
+  enum class update : std::uint8_t {
+    full,     ///< The message data is the resource's complete new value.
+    partial,  ///< The message data describes the parts of the resource which have changed.
+    notify,   ///< The resource has changed; the subscriber should fetch it with an Inquiry: Get Property Data.
+  };
+
+  /// \param local  The MUID of the local device. This is the source MUID of every update.
+  /// \param device_id  The device ID placed in the header of each update.
+  /// \param version  The MIDI-CI message version used for the updates.
+  explicit subscription_manager(muid const local, b7 const device_id = b7{0x7FU}, b7 const version = b7{2U}) noexcept
+      : local_{local}, device_id_{device_id}, version_{version} {
+    for (auto index = std::size_t{0}; index < Queue; ++index) {
+      [[maybe_unused]] auto const ok = free_.push_back(static_cast<std::uint8_t>(index));
+      assert(ok);
+    }
+  }
+  subscription_manager(subscription_manager const&) = delete;
+  subscription_manager(subscription_manager&&) noexcept = delete;
+  ~subscription_manager() noexcept = default;
+
+  subscription_manager& operator=(subscription_manager const&) = delete;
+  subscription_manager& operator=(subscription_manager&&) noexcept = delete;
+
+  /// \brief Records a subscription. May only be called by the I/O thread.
+  /// \param subscriber  The MUID of the subscribing device.
+  /// \param resource  The name of the resource to which the device is subscribing.
+  /// \param res_id  The resource's resId or an empty string if it has none.
+  /// \returns The subscribeId to be sent to the subscriber in the reply to its subscription request or std::nullopt if
+  ///   the table is full or the resource name is too long.
+  std::optional<subscribe_id> subscribe(muid const subscriber, std::string_view const resource,
+                                        std::string_view const res_id) {
+    if (size_ >= Subscriptions) {
+      return std::nullopt;
+    }
+    auto const key = make_key(resource, res_id);
+    if (!key) {
+      return std::nullopt;
+    }
+    auto const r = this->find_or_add_resource(*key);
+    ++resources_[r].subscribers;
+    resource_of_[size_] = r;
+    subscriber_[size_] = subscriber;
+    id_[size_] = next_id_++;
+    return to_string(id_[size_++]);
+  }
+  /// \brief Ends the subscription with subscribeId \p id. May only be called by the I/O thread.
+  /// \returns True if the subscription was found.
+  bool unsubscribe(std::string_view const id) {
+    auto const value = from_string(id);
+    if (!value) {
+      return false;
+    }
+    for (auto index = std::size_t{0}; index < size_; ++index) {
+      if (id_[index] == *value) {
+        this->erase(index);
+        return true;
+      }
+    }
+    return false;
+  }
+  /// \brief Ends all of the subscriptions made by \p subscriber. Used when its MUID is invalidated. May only be called
+  ///   by the I/O thread.
+  /// \returns The number of subscriptions ended.
+  std::size_t unsubscribe(muid const subscriber) {
+    auto count = std::size_t{0};
+    for (auto index = std::size_t{0}; index < size_;) {
+      if (subscriber_[index] == subscriber) {
+        this->erase(index);
+        ++count;
+      } else {
+        ++index;
+      }
+    }
+    return count;
+  }
+
+  /// \brief Queues an update to a resource to be sent to its subscribers. May only be called by the control thread.
+  /// \param resource  The name of the resource which has changed.
+  /// \param res_id  The resource's resId or an empty string if it has none.
+  /// \param data  The message data: the new value or the changes, depending on \p command.
+  /// \param command  The kind of update.
+  /// \returns False if the queue is full, the resource name is too long, or the message would be larger than
+  ///   MessageSize.
+  bool publish(std::string_view const resource, std::string_view const res_id, std::span<char const> const data,
+               update const command = update::full) {
+    constexpr auto prefix = std::string_view{R"({"command":")"};
+    constexpr auto infix = std::string_view{R"(","subscribeId":")"};
+    constexpr auto suffix = std::string_view{R"("})"};
+    constexpr auto header_offset =
+        sizeof(packed::header) + offsetof(property_exchange::packed::property_exchange_pt1, header);
+    constexpr auto pt2_size = offsetof(property_exchange::packed::property_exchange_pt2, data);
+
+    auto const json_size =
+        prefix.size() + command_name(command).size() + infix.size() + subscribe_id_size + suffix.size();
+    auto const key = make_key(resource, res_id);
+    if (!key || header_offset + json_size + pt2_size + data.size() > MessageSize) {
+      return false;
+    }
+    auto const index = free_.pop_front();
+    if (!index) {
+      return false;
+    }
+    auto& m = messages_[*index];
+    m.key = *key;
+
+    std::array<char, prefix.size() + 7 + infix.size() + subscribe_id_size + suffix.size()> json{};
+    auto out = std::ranges::copy(prefix, json.begin()).out;
+    out = std::ranges::copy(command_name(command), out).out;
+    out = std::ranges::copy(infix, out).out;
+    auto const id_position = static_cast<std::size_t>(out - json.begin());
+    out = std::ranges::fill_n(out, subscribe_id_size, '0');
+    out = std::ranges::copy(suffix, out).out;
+
+    m.id_offset = header_offset + id_position;
+    auto const last = create_message(
+        m.bytes.begin(), m.bytes.end(),
+        header{.device_id = device_id_, .version = version_, .remote_muid = local_, .local_muid = broadcast_muid},
+        property_exchange::subscription{.chunk = {.number_of_chunks = b14{1U}, .chunk_number = b14{1U}},
+                                        .request = b7{0U},
+                                        .header = std::span{json.begin(), out},
+                                        .data = data});
+    assert(last != m.bytes.end());
+    m.size = static_cast<std::size_t>(last - m.bytes.begin());
+    [[maybe_unused]] auto const ok = ready_.push_back(*index);
+    assert(ok && "there are no more buffers than ready_ entries");
+    return true;
+  }
+
+  /// \brief Sends each queued update to the subscribers of its resource. May only be called by the I/O thread.
+  /// \param send  A function called with the bytes of each message (excluding the 0xF0/0xF7 system exclusive
+  ///   framing). The bytes are valid only for the duration of the call.
+  /// \returns The number of messages sent.
+  template <typename SendFunction> std::size_t flush(SendFunction send) {
+    auto sent = std::size_t{0};
+    while (auto const index = ready_.pop_front()) {
+      auto& m = messages_[*index];
+      auto const bytes = std::span{m.bytes}.first(m.size);
+      if (auto const r = this->find_resource(m.key)) {
+        for (auto s = std::size_t{0}; s < size_; ++s) {
+          if (resource_of_[s] != *r) {
+            continue;
+          }
+          std::ranges::copy(details::to_le7(subscriber_[s]),
+                            bytes.begin() + offsetof(packed::header, destination_muid));
+          bytes[request_id_offset] = static_cast<std::byte>(request_id_);
+          request_id_ = (request_id_ + 1U) % 128U;
+          std::ranges::transform(to_string(id_[s]), bytes.begin() + static_cast<std::ptrdiff_t>(m.id_offset),
+                                 [](char const c) { return static_cast<std::byte>(c); });
+          send(std::span<std::byte const>{bytes});
+          ++sent;
+        }
+      }
+      this->release(*index);
+    }
+    return sent;
+  }
+
+  /// \returns The number of subscriptions.
+  [[nodiscard]] constexpr std::size_t size() const noexcept { return size_; }
+  /// \returns True if there are no subscriptions.
+  [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0U; }
+
+private:
+  using index_type = adt::uinteger_t<static_cast<unsigned>(std::bit_width(Subscriptions))>;
+
+  using key_type = details::resource_key<KeySize>;
+  struct resource_entry {
+    key_type key;
+    std::size_t subscribers = 0;
+  };
+  struct message_buffer {
+    key_type key;
+    std::size_t size = 0;
+    std::size_t id_offset = 0;
+    details::create_message_buffer<MessageSize> bytes{};
+  };
+
+  static constexpr auto request_id_offset =
+      sizeof(packed::header) + offsetof(property_exchange::packed::property_exchange_pt1, request_id);
+
+  [[nodiscard]] static constexpr std::string_view command_name(update const u) noexcept {
+    switch (u) {
+    case update::partial: return "partial";
+    case update::notify: return "notify";
+    case update::full:
+    default: return "full";
+    }
+  }
+  [[nodiscard]] static constexpr subscribe_id to_string(std::uint32_t value) noexcept {
+    constexpr auto digits = std::string_view{"0123456789abcdef"};
+    subscribe_id result{};
+    for (auto it = result.rbegin(); it != result.rend(); ++it) {
+      *it = digits[value & 0xFU];
+      value >>= 4U;
+    }
+    return result;
+  }
+  [[nodiscard]] static constexpr std::optional<std::uint32_t> from_string(std::string_view const id) noexcept {
+    if (id.size() != subscribe_id_size) {
+      return std::nullopt;
+    }
+    auto result = std::uint32_t{0};
+    for (auto const c : id) {
+      auto nibble = 0U;
+      if (c >= '0' && c <= '9') {
+        nibble = static_cast<unsigned>(c - '0');
+      } else if (c >= 'a' && c <= 'f') {
+        nibble = static_cast<unsigned>(c - 'a') + 10U;
+      } else {
+        return std::nullopt;
+      }
+      result = (result << 4U) | nibble;
+    }
+    return result;
+  }
+  [[nodiscard]] static constexpr std::optional<key_type> make_key(std::string_view const resource,
+                                                                  std::string_view const res_id) noexcept {
+    return key_type::make(resource, res_id);
+  }
+
+  [[nodiscard]] constexpr std::optional<index_type> find_resource(key_type const& key) const noexcept {
+    for (auto index = std::size_t{0}; index < resource_count_; ++index) {
+      if (auto const& r = resources_[index]; r.key == key) {
+        return static_cast<index_type>(index);
+      }
+    }
+    return std::nullopt;
+  }
+  /// There are never more resources than subscriptions so there is always room for a new resource.
+  constexpr index_type find_or_add_resource(key_type const& key) noexcept {
+    if (auto const r = this->find_resource(key)) {
+      return *r;
+    }
+    assert(resource_count_ < Subscriptions);
+    resources_[resource_count_] = resource_entry{.key = key, .subscribers = 0};
+    return static_cast<index_type>(resource_count_++);
+  }
+  /// Removes subscription \p index by moving the last subscription into its place.
+  constexpr void erase(std::size_t const index) noexcept {
+    auto const r = resource_of_[index];
+    --size_;
+    resource_of_[index] = resource_of_[size_];
+    subscriber_[index] = subscriber_[size_];
+    id_[index] = id_[size_];
+    if (--resources_[r].subscribers == 0U) {
+      // Remove the resource, moving the last resource into its place.
+      auto const last = static_cast<index_type>(--resource_count_);
+      if (r != last) {
+        resources_[r] = resources_[last];
+        std::ranges::replace(std::span{resource_of_}.first(size_), last, r);
+      }
+    }
+  }
+  /// Returns a buffer for use by the control thread.
+  void release(std::uint8_t const index) noexcept {
+    [[maybe_unused]] auto const ok = free_.push_back(index);
+    assert(ok);
+  }
+
+  muid local_;
+  b7 device_id_;
+  b7 version_;
+  std::uint32_t next_id_ = 0;
+  std::uint8_t request_id_ = 0;
+
+  // The subscription table. Only accessed by the I/O thread.
+  std::size_t size_ = 0;
+  std::array<index_type, Subscriptions> resource_of_{};
+  std::array<muid, Subscriptions> subscriber_{};
+  std::array<std::uint32_t, Subscriptions> id_{};
+  std::size_t resource_count_ = 0;
+  std::array<resource_entry, Subscriptions> resources_{};
+
+  /// Buffers available to publish(). Produced by the I/O thread, consumed by the control thread.
+  adt::spsc_fifo<std::uint8_t, Queue> free_;
+  /// Buffers holding updates waiting to be sent. Produced by the control thread, consumed by the I/O thread.
+  adt::spsc_fifo<std::uint8_t, Queue> ready_;
+  std::array<message_buffer, Queue> messages_{};
+};
+
+}  // end namespace midi2::ci
+
+#endif  // MIDI2_CI_SUBSCRIPTION_MANAGER_HPP
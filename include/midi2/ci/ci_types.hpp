@@ -1438,6 +1438,17 @@ struct chunk_info {
 };
 
 enum class property_exchange_type { get, get_reply, set, set_reply, subscription, subscription_reply, notify };
+
+/// \brief Describes a Property Exchange message whose data is delivered to a streaming backend in fragments.
+struct stream_info {
+  constexpr friend bool operator==(stream_info const&, stream_info const&) noexcept = default;
+  property_exchange_type type = property_exchange_type::get;
+  chunk_info chunk;
+  b7 request;
+  /// The total number of data bytes carried by this chunk.
+  b14 data_length;
+};
+
 template <property_exchange_type Pet> class property_exchange {
 public:
   [[nodiscard]] static constexpr property_exchange make(chunk_info const& chunk, b7 const request,
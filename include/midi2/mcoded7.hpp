@@ -43,10 +43,14 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <span>
+#include <type_traits>
 #include <utility>
 
 /// \brief  MIDI Mcoded7 Encoding and Decoding
@@ -67,6 +71,16 @@ public:
   template <std::output_iterator<std::byte> OutputIterator>
   OutputIterator parse_byte(std::byte value, OutputIterator out);
 
+  /// Encodes a span of bytes. The output is identical to calling parse_byte() for each member of \p input: complete
+  /// groups of seven bytes are encoded a group at a time and any remainder is held until the next call or flush().
+  ///
+  /// \tparam OutputIterator  An output iterator type to which bytes can be written.
+  /// \param input  The values to be encoded.
+  /// \param out  An output iterator to which the output sequence is written.
+  /// \returns  Iterator one past the last element assigned.
+  template <std::output_iterator<std::byte> OutputIterator>
+  OutputIterator encode(std::span<std::byte const> input, OutputIterator out);
+
   /// Call once the entire input sequence has been fed to encoder::parse_byte().
   /// This function flushes any remaining buffered output.
   ///
@@ -108,6 +122,16 @@ public:
   template <std::output_iterator<std::byte> OutputIterator>
   OutputIterator parse_byte(std::byte value, OutputIterator out);
 
+  /// Decodes a span of bytes. The output and good() state are identical to calling parse_byte() for each member of
+  /// \p input: complete groups of eight bytes are decoded a group at a time.
+  ///
+  /// \tparam OutputIterator  An output iterator type to which bytes can be written.
+  /// \param input  The values to be decoded.
+  /// \param out  An output iterator to which the output sequence is written.
+  /// \returns  Iterator one past the last element assigned.
+  template <std::output_iterator<std::byte> OutputIterator>
+  OutputIterator decode(std::span<std::byte const> input, OutputIterator out);
+
   /// Call once the entire input sequence has been fed to decoder::parse_byte().
   /// This function flushes any remaining buffered output.
   ///
@@ -165,6 +189,70 @@ template <std::output_iterator<std::byte> OutputIterator> OutputIterator encoder
   return out;
 }
 
+template <std::output_iterator<std::byte> OutputIterator>
+OutputIterator encoder::encode(std::span<std::byte const> input, OutputIterator out) {
+  // Complete any partially filled group a byte at a time.
+  for (; pos_ != 0U && !input.empty(); input = input.subspan(1)) {
+    out = this->parse_byte(input.front(), out);
+  }
+  if constexpr (std::endian::native == std::endian::little) {
+    for (; input.size() >= 7U; input = input.subspan(7)) {
+      std::uint64_t v = 0;
+      std::memcpy(&v, input.data(), 7U);
+      // Gather the top bit of each of the seven bytes: the multiplication moves that of byte n from bit 8n to bit
+      // 62-n. None of the partial products overlap so there are no carries.
+      auto const msbs = (((v >> 7U) & std::uint64_t{0x0001010101010101}) * std::uint64_t{0x4020100804020100}) >> 56U;
+      auto const group = msbs | ((v & std::uint64_t{0x007F7F7F7F7F7F7F}) << 8U);
+      if constexpr (std::is_same_v<OutputIterator, std::byte*>) {
+        std::memcpy(out, &group, 8U);
+        out += 8;
+      } else {
+        for (auto shift = 0U; shift < 64U; shift += 8U) {
+          *(out++) = static_cast<std::byte>(group >> shift);
+        }
+      }
+    }
+  }
+  for (auto const b : input) {
+    out = this->parse_byte(b, out);
+  }
+  return out;
+}
+
+template <std::output_iterator<std::byte> OutputIterator>
+OutputIterator decoder::decode(std::span<std::byte const> input, OutputIterator out) {
+  // Complete any partially decoded group a byte at a time.
+  for (; pos_ != msbs_byte_pos_ && !input.empty(); input = input.subspan(1)) {
+    out = this->parse_byte(input.front(), out);
+  }
+  if constexpr (std::endian::native == std::endian::little) {
+    for (; input.size() >= 8U; input = input.subspan(8)) {
+      std::uint64_t v = 0;
+      std::memcpy(&v, input.data() + 1, 7U);
+      // The MSB should not be set in mcoded7 data.
+      if ((v & std::uint64_t{0x0080808080808080}) != 0U) {
+        bad_ = 1U;
+      }
+      // Scatter the sign bits: the multiplication moves bit 6-n of the first byte to bit 8n+7. As for encoding, none
+      // of the partial products overlap.
+      auto const msbs = std::to_integer<std::uint64_t>(input.front()) & 0x7FU;
+      v |= (msbs * std::uint64_t{0x0080402010080402}) & std::uint64_t{0x0080808080808080};
+      if constexpr (std::is_same_v<OutputIterator, std::byte*>) {
+        std::memcpy(out, &v, 7U);
+        out += 7;
+      } else {
+        for (auto shift = 0U; shift < 56U; shift += 8U) {
+          *(out++) = static_cast<std::byte>(v >> shift);
+        }
+      }
+    }
+  }
+  for (auto const b : input) {
+    out = this->parse_byte(b, out);
+  }
+  return out;
+}
+
 template <std::output_iterator<std::byte> OutputIterator>
 OutputIterator decoder::parse_byte(std::byte const value, OutputIterator out) {
   if (pos_ == msbs_byte_pos_) {
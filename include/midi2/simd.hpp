@@ -0,0 +1,59 @@
+//===-- SIMD Detection --------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file simd.hpp
+/// \brief Internal to the library: the vector instruction sets enabled by the compiler's target.
+///
+/// This header is included only by the library's own source files, never by a public header. The flags depend on
+/// the options with which a file is compiled, so code which tests them must be compiled once, as part of the
+/// library, rather than in each user's translation units.
+///
+/// Code which uses the intrinsics is enclosed in `#if` for the architecture family, since the intrinsics of one
+/// family are not declared for another. Within a family, `if constexpr` on the flags below selects the widest
+/// instructions available.
+
+#ifndef MIDI2_SIMD_HPP
+#define MIDI2_SIMD_HPP
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+namespace midi2::details {
+
+/// True if SSE2 instructions may be used.
+inline constexpr bool simd_sse2 =
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    true;
+#else
+    false;
+#endif
+
+/// True if AVX2 instructions may be used.
+inline constexpr bool simd_avx2 =
+#if defined(__AVX2__) && __AVX2__
+    true;
+#else
+    false;
+#endif
+
+/// True if AVX-512F instructions may be used.
+inline constexpr bool simd_avx512f =
+#if defined(__AVX512F__) && __AVX512F__
+    true;
+#else
+    false;
+#endif
+
+}  // end namespace midi2::details
+
+#endif  // MIDI2_SIMD_HPP
@@ -14,8 +14,14 @@
 #ifndef MIDI2_TRANSLATOR_HPP
 #define MIDI2_TRANSLATOR_HPP
 
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 namespace midi2 {
 
@@ -34,6 +40,9 @@ namespace midi2 {
 /// - `OutputType pop()`: Pulls a translated value from the object. `empty()` must return false when this function is
 ///   called.
 /// - `void reset()`: restore the translator to its initial state. Any partially translated messages are dropped.
+///
+/// Values may be moved in bulk between spans or output iterators with the translate() function templates which
+/// give the same results as a loop calling `push()` followed by `pop()` until `empty()`.
 template <typename InputType, typename OutputType, typename T>
 concept translator = requires(T v) {
   /// Type of input messages
@@ -51,6 +60,98 @@ concept translator = requires(T v) {
   { v.reset() };
 };
 
+/// \brief The result of a bulk translation performed by translate().
+/// \tparam OutputIterator The type of the output iterator to which translated values were written.
+template <typename OutputIterator> struct translate_result {
+  std::size_t consumed = 0;  ///< The number of input values consumed by the translator.
+  std::size_t produced = 0;  ///< The number of output values written.
+  OutputIterator out;        ///< An iterator one past the last output value written.
+};
+
+namespace details {
+
+/// \brief The generic implementation of bulk translation between two spans.
+///
+/// Output left in the translator by a previous call is written first. An input value is pushed only when the
+/// translator's output has been fully drained so that its internal FIFO can never overflow. Translation stops when
+/// the input is exhausted or there is no space left for output: any output which could not be written remains in the
+/// translator and will be produced by the next call.
+///
+/// \param t  The translator instance.
+/// \param input  The input values to be translated.
+/// \param output  The span to which translated values are written.
+/// \returns The number of values consumed from \p input and written to \p output.
+template <typename T>
+constexpr translate_result<typename std::span<typename T::output_type>::iterator> translate_span(
+    T& t, std::span<typename T::input_type const> const input, std::span<typename T::output_type> const output) {
+  auto in = std::begin(input);
+  auto const in_end = std::end(input);
+  auto out = std::begin(output);
+  auto const out_end = std::end(output);
+  for (;;) {
+    for (; !t.empty() && out != out_end; ++out) {
+      *out = t.pop();
+    }
+    if (in == in_end || out == out_end || !t.empty()) {
+      break;
+    }
+    t.push(*in);
+    ++in;
+  }
+  return {.consumed = static_cast<std::size_t>(in - std::begin(input)),
+          .produced = static_cast<std::size_t>(out - std::begin(output)),
+          .out = out};
+}
+
+}  // end namespace details
+
+/// \brief Translates a span of input values, writing the results to a span of output values.
+///
+/// If the translator provides a member function `translate(input, output)` it is used in preference to the generic
+/// implementation. This enables a translator whose `push()` is not visible to the caller to run the entire loop in a
+/// single call.
+///
+/// \param t  The translator instance.
+/// \param input  The input values to be translated.
+/// \param output  The span to which translated values are written.
+/// \returns The number of values consumed from \p input and written to \p output. If the number consumed is less than
+///   the size of \p input, the output span was filled and the call should be repeated with the remaining input.
+template <typename T>
+  requires translator<typename T::input_type, typename T::output_type, T>
+constexpr translate_result<typename std::span<typename T::output_type>::iterator> translate(
+    T& t, std::span<typename T::input_type const> const input, std::span<typename T::output_type> const output) {
+  if constexpr (requires { t.translate(input, output); }) {
+    return t.translate(input, output);
+  } else {
+    return details::translate_span(t, input, output);
+  }
+}
+
+/// \brief Translates a span of input values, writing all of the results to an output iterator.
+///
+/// All of the input is consumed and all of the resulting output is written.
+///
+/// \param t  The translator instance.
+/// \param input  The input values to be translated.
+/// \param out  The output iterator to which translated values are written.
+/// \returns The number of values consumed from \p input and written to \p out together with the final value of the
+///   output iterator.
+template <typename T, std::output_iterator<typename T::output_type> OutputIterator>
+  requires translator<typename T::input_type, typename T::output_type, T>
+constexpr translate_result<OutputIterator> translate(T& t, std::span<typename T::input_type const> input,
+                                                     OutputIterator out) {
+  translate_result<OutputIterator> result{.consumed = 0, .produced = 0, .out = out};
+  std::array<typename T::output_type, 16> buffer{};
+  do {
+    auto const r = translate(t, input, std::span{buffer});
+    result.out = std::copy_n(std::begin(buffer), r.produced, result.out);
+    result.consumed += r.consumed;
+    result.produced += r.produced;
+    input = input.subspan(r.consumed);
+  } while (!input.empty() || !t.empty());
+  return result;
+}
+
 }  // end namespace midi2
 
 #endif  // MIDI2_TRANSLATOR_HPP
@@ -0,0 +1,196 @@
+//===-- UMP MIDI-CI Demultiplexer ---------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ump_ci_demultiplexer.hpp
+/// \brief A UMP dispatcher backend which passes MIDI-CI messages carried by sysex7 packets directly to per-group
+///   CI dispatchers.
+
+#ifndef MIDI2_UMP_CI_DEMULTIPLEXER_HPP
+#define MIDI2_UMP_CI_DEMULTIPLEXER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "midi2/bytestream/bytestream_types.hpp"
+#include "midi2/ump/ump_dispatcher_backend.hpp"
+#include "midi2/ump/ump_sysex_reassembler.hpp"
+#include "midi2/ump/ump_types.hpp"
+
+namespace midi2::ump::dispatcher_backend {
+
+/// \brief A data64 backend which demultiplexes 7-bit system exclusive messages by group and passes those that
+///   carry MIDI-CI to a CI dispatcher for that group.
+///
+/// The payload of each packet is passed to the CI dispatcher as a single span so there is no need to convert the UMP
+/// stream back to a bytestream first. A message is recognized as MIDI-CI by its universal non-real-time (0x7E) and
+/// MIDI-CI sub-ID #1 (0x0D) bytes. Once these are seen, the group's dispatcher is reset and receives the message;
+/// other system exclusive messages are ignored. The dispatcher is reset again when the message ends or is interrupted
+/// by a new message on the same group so that a truncated message does not hold on to any of its resources. Continue
+/// and end packets which arrive without a preceding start are also ignored.
+///
+/// \tparam Context  The UMP dispatcher context type. It is not used by this backend: each CI dispatcher has its own
+///   context.
+/// \tparam CIDispatcher  The type of the per-group dispatchers. Normally an instance of ci::ci_dispatcher<>. It must
+///   provide dispatch(std::span<std::byte const>) and reset() member functions.
+template <typename Context, typename CIDispatcher>
+  requires requires(CIDispatcher d, std::span<std::byte const> s) {
+    { d.dispatch(s) };
+    { d.reset() };
+  }
+class ci_demultiplexer {
+public:
+  /// The number of groups and therefore the number of CI dispatchers.
+  static constexpr auto groups = std::size_t{16};
+
+  /// Default-constructs each of the CI dispatchers and sets its group.
+  constexpr ci_demultiplexer()
+    requires std::default_initializable<CIDispatcher> && requires(CIDispatcher d) { d.set_group(std::uint8_t{}); }
+  {
+    for (auto group = std::uint8_t{0}; group < groups; ++group) {
+      dispatchers_[group].set_group(group);
+    }
+  }
+  /// Constructs the CI dispatchers by calling \p make with each group number in turn.
+  /// \param make  A function which is called with a group number and returns the CI dispatcher for that group.
+  template <std::invocable<std::uint8_t> Factory>
+    requires std::convertible_to<std::invoke_result_t<Factory &, std::uint8_t>, CIDispatcher>
+  constexpr explicit ci_demultiplexer(Factory make)
+      : dispatchers_{make_dispatchers(make, std::make_index_sequence<groups>{})} {}
+
+  /// \returns The CI dispatcher for \p group.
+  [[nodiscard]] constexpr CIDispatcher &dispatcher(std::uint8_t const group) noexcept {
+    assert(group < groups);
+    return dispatchers_[group];
+  }
+  /// \returns The CI dispatcher for \p group.
+  [[nodiscard]] constexpr CIDispatcher const &dispatcher(std::uint8_t const group) const noexcept {
+    assert(group < groups);
+    return dispatchers_[group];
+  }
+
+  void sysex7_in_1(Context, data64::sysex7_in_1 const &sx) {
+    auto const group = static_cast<std::uint8_t>(sx.group());
+    std::array<std::byte, 6> buffer{};
+    this->start(group, details::payload(sx, buffer));
+    this->end(group);
+  }
+  void sysex7_start(Context, data64::sysex7_start const &sx) {
+    std::array<std::byte, 6> buffer{};
+    this->start(static_cast<std::uint8_t>(sx.group()), details::payload(sx, buffer));
+  }
+  void sysex7_continue(Context, data64::sysex7_continue const &sx) {
+    std::array<std::byte, 6> buffer{};
+    this->next(static_cast<std::uint8_t>(sx.group()), details::payload(sx, buffer));
+  }
+  void sysex7_end(Context, data64::sysex7_end const &sx) {
+    auto const group = static_cast<std::uint8_t>(sx.group());
+    std::array<std::byte, 6> buffer{};
+    this->next(group, details::payload(sx, buffer));
+    this->end(group);
+  }
+
+private:
+  enum class state : std::uint8_t {
+    idle,     ///< No message is in progress.
+    prefix,   ///< Collecting the bytes which determine whether the message is MIDI-CI.
+    ci,       ///< A MIDI-CI message is being passed to the group's dispatcher.
+    ignoring  ///< The message is not MIDI-CI.
+  };
+  /// The number of leading bytes needed to recognize a MIDI-CI message: universal non-real-time, device ID, and
+  /// sub-ID #1.
+  static constexpr auto prefix_size = std::size_t{3};
+
+  struct stream {
+    state status = state::idle;
+    std::uint8_t size = 0;  ///< The number of bytes in prefix.
+    std::array<std::byte, prefix_size> prefix{};
+  };
+
+  template <typename Factory, std::size_t... Groups>
+  static constexpr std::array<CIDispatcher, groups> make_dispatchers(Factory &make, std::index_sequence<Groups...>) {
+    return {{static_cast<CIDispatcher>(std::invoke(make, static_cast<std::uint8_t>(Groups)))...}};
+  }
+  [[nodiscard]] static constexpr bool is_ci(std::span<std::byte const, prefix_size> const prefix) noexcept {
+    return prefix[0] == bytestream::s7_universal_nrt && prefix[2] == bytestream::s7_midi_ci;
+  }
+
+  void start(std::uint8_t const group, std::span<std::byte const> const bytes) {
+    // A message in progress has been cut short by this one, which might not be MIDI-CI.
+    this->end(group);
+    auto &s = streams_[group];
+    s.status = state::prefix;
+    s.size = 0;
+    this->next(group, bytes);
+  }
+  void next(std::uint8_t const group, std::span<std::byte const> bytes) {
+    auto &s = streams_[group];
+    switch (s.status) {
+    case state::idle:
+    case state::ignoring: break;
+    case state::ci: dispatchers_[group].dispatch(bytes); break;
+    case state::prefix:
+      if (s.size == 0 && bytes.size() >= prefix_size) {
+        // The common case: the whole prefix is in the first packet so it can be checked in place.
+        this->begin(group, bytes.first<prefix_size>());
+        if (s.status == state::ci) {
+          dispatchers_[group].dispatch(bytes);
+        }
+        break;
+      }
+      // The prefix is split across packets. Gather it before checking.
+      auto const n = std::min(prefix_size - s.size, bytes.size());
+      std::copy_n(bytes.begin(), n, s.prefix.begin() + s.size);
+      s.size = static_cast<std::uint8_t>(s.size + n);
+      if (s.size == prefix_size) {
+        this->begin(group, s.prefix);
+        if (s.status == state::ci) {
+          dispatchers_[group].dispatch(s.prefix);
+          dispatchers_[group].dispatch(bytes.subspan(n));
+        }
+      }
+      break;
+    }
+  }
+  /// Called when the system exclusive message on \p group ends. A CI dispatcher is reset so that anything it holds for
+  /// a truncated message (such as a buffer taken from a shared pool) is released immediately.
+  void end(std::uint8_t const group) {
+    auto &s = streams_[group];
+    if (s.status == state::ci) {
+      dispatchers_[group].reset();
+    }
+    s.status = state::idle;
+  }
+  /// Decides whether the message on \p group whose first bytes are \p prefix is MIDI-CI. If so, the group's
+  /// dispatcher is readied for the message.
+  void begin(std::uint8_t const group, std::span<std::byte const, prefix_size> const prefix) {
+    auto &s = streams_[group];
+    if (!is_ci(prefix)) {
+      s.status = state::ignoring;
+      return;
+    }
+    s.status = state::ci;
+    dispatchers_[group].reset();
+  }
+
+  std::array<stream, groups> streams_{};
+  std::array<CIDispatcher, groups> dispatchers_;
+};
+
+}  // end namespace midi2::ump::dispatcher_backend
+
+#endif  // MIDI2_UMP_CI_DEMULTIPLEXER_HPP
@@ -18,10 +18,13 @@
 #include <array>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <span>
 #include <type_traits>
+#include <utility>
 
+#include "midi2/adt/inplace_function.hpp"
 #include "midi2/dispatcher.hpp"
 #include "midi2/ump/ump_dispatcher_backend.hpp"
 #include "midi2/ump/ump_types.hpp"
@@ -68,6 +71,44 @@ concept ump_dispatcher_config = requires(T v) {
   { v.flex } -> dispatcher_backend::flex_data<decltype(v.context)>;
 };
 
+/// \returns A mask with bit n set for each argument whose value is n. Suitable for the optional
+///   handled_message_types member of a ump_dispatcher configuration.
+[[nodiscard]] constexpr std::uint16_t message_type_mask(std::same_as<message_type> auto... types) noexcept {
+  return static_cast<std::uint16_t>(((1U << std::to_underlying(types)) | ... | 0U));
+}
+
+namespace details {
+
+/// \returns A mask with bit n set if the dispatcher must decode and deliver messages of type n. A configuration may
+///   give the mask explicitly with a static constexpr member named handled_message_types: messages of any other type,
+///   including those with an unknown status, are then discarded. Otherwise, every message type is decoded unless the
+///   utility backend is one of the dispatcher_backend::*_null types. Messages with an unknown status or a reserved
+///   message type would be passed to utility.unknown(), so they cannot be skipped while it is live. If the utility
+///   backend is null, a message type is ignored if its category's backend is null too.
+template <typename Config> consteval std::uint16_t handled_message_types() {
+  if constexpr (requires {
+                  { Config::handled_message_types } -> std::convertible_to<std::uint16_t>;
+                }) {
+    return Config::handled_message_types;
+  } else {
+    using dispatcher_backend::is_null_v;
+    if constexpr (!is_null_v<decltype(Config::utility)>) {
+      return std::uint16_t{0xFFFF};
+    } else {
+      using enum message_type;
+      auto const mask = [](bool const handled, message_type const type) {
+        return handled ? message_type_mask(type) : std::uint16_t{0};
+      };
+      return mask(!is_null_v<decltype(Config::system)>, system) | mask(!is_null_v<decltype(Config::m1cvm)>, m1cvm) |
+             mask(!is_null_v<decltype(Config::data64)>, data64) | mask(!is_null_v<decltype(Config::m2cvm)>, m2cvm) |
+             mask(!is_null_v<decltype(Config::data128)>, data128) |
+             mask(!is_null_v<decltype(Config::stream)>, stream) | mask(!is_null_v<decltype(Config::flex)>, flex_data);
+    }
+  }
+}
+
+}  // end namespace details
+
 /// A configuration type for the ump_dispatcher which uses std::function<> for all the available callbacks.
 /// \note This is probably the simplest possible configuration type to use, but may not always be the most time and
 ///   space efficient. Use judiciously!
@@ -88,6 +129,61 @@ template <typename Context> struct function_config {
   dispatcher_backend::flex_data_function<Context> flex;
 };
 
+/// A configuration type for the ump_dispatcher which has the same on_*() interface as function_config but holds each
+/// callback in an adt::inplace_function<>. Constructing, copying, and destroying the configuration never allocates
+/// memory and a callback that has not been set is called without first being tested.
+///
+/// A callable whose captures exceed \p CallableSize bytes is rejected at compile time. Where the callbacks for a
+/// category are all member functions of one object, consider deriving that object from the corresponding
+/// dispatcher_backend::*_base<> class instead: every instance then shares a single vtable.
+///
+/// \tparam Context  The type of the context object. This is passed to the callbacks to enable sharing
+///   of context.
+/// \tparam CallableSize  The number of bytes available to each callback for its captures.
+template <typename Context, std::size_t CallableSize = 2 * sizeof(void*)> struct compact_function_config {
+  template <typename Signature> using function = adt::inplace_function<Signature, CallableSize>;
+
+  explicit compact_function_config(Context c) : context{std::move(c)} {}
+
+  [[no_unique_address]] Context context;
+  dispatcher_backend::utility_function<Context, function> utility;
+  dispatcher_backend::system_function<Context, function> system;
+  dispatcher_backend::m1cvm_function<Context, function> m1cvm;
+  dispatcher_backend::data64_function<Context, function> data64;
+  dispatcher_backend::m2cvm_function<Context, function> m2cvm;
+  dispatcher_backend::data128_function<Context, function> data128;
+  dispatcher_backend::stream_function<Context, function> stream;
+  dispatcher_backend::flex_data_function<Context, function> flex;
+};
+
+/// A configuration type for the ump_dispatcher which passes every message to a single overload set, normally built
+/// from captureless lambdas with midi2::overloaded. Each message handler is known at compile time so calls are
+/// inlined into the dispatcher. Messages for which the overload set has no matching function are ignored. A category
+/// none of whose message types the set accepts is given the corresponding *_null backend, so the dispatcher does not
+/// decode its messages at all.
+///
+/// \tparam Context  The type of the context object. The handlers are passed a reference to the configuration's copy
+///   and it is the place for any state: make it a reference or pointer type to share that state with the caller.
+/// \tparam Handler  An empty, default-constructible overload set.
+template <typename Context, dispatcher_backend::overload_handler Handler> struct overload_config {
+  explicit overload_config(Context c)
+    requires(!std::is_reference_v<Context>)
+      : context{std::move(c)} {}
+  explicit overload_config(Context c)
+    requires(std::is_reference_v<Context>)
+      : context{c} {}
+
+  [[no_unique_address]] Context context;
+  [[no_unique_address]] dispatcher_backend::utility_overload_or_null<Context, Handler> utility;
+  [[no_unique_address]] dispatcher_backend::system_overload_or_null<Context, Handler> system;
+  [[no_unique_address]] dispatcher_backend::m1cvm_overload_or_null<Context, Handler> m1cvm;
+  [[no_unique_address]] dispatcher_backend::data64_overload_or_null<Context, Handler> data64;
+  [[no_unique_address]] dispatcher_backend::m2cvm_overload_or_null<Context, Handler> m2cvm;
+  [[no_unique_address]] dispatcher_backend::data128_overload_or_null<Context, Handler> data128;
+  [[no_unique_address]] dispatcher_backend::stream_overload_or_null<Context, Handler> stream;
+  [[no_unique_address]] dispatcher_backend::flex_data_overload_or_null<Context, Handler> flex;
+};
+
 template <typename T>
 concept word_memfun = requires(T a) {
   { a.word() } -> std::convertible_to<std::uint32_t>;
@@ -120,50 +216,126 @@ public:
     assert(pos_ < message_.size());
     message_[pos_] = ump;
     ++pos_;
-    if (auto const mt = static_cast<message_type>((message_[0] >> 28) & 0xF); pos_ >= ump_message_size(mt)) {
-      using enum message_type;
-      switch (mt) {
-      case utility: this->utility_message(); break;
-      case system: this->system_message(); break;
-      case m1cvm: this->m1cvm_message(); break;
-      case m2cvm: this->m2cvm_message(); break;
-      case flex_data: this->flex_data_message(); break;
-      case stream: this->stream_message(); break;
-      case data64: this->data64_message(); break;
-      case data128: this->data128_message(); break;
-
-      case reserved32_06:
-      case reserved32_07:
-      case reserved64_08:
-      case reserved64_09:
-      case reserved64_0a:
-      case reserved96_0b:
-      case reserved96_0c:
-      case reserved128_0e: this->unknown(); break;
-      default:
-        assert(false);
-        unreachable();
+    if (pos_ >= ump_message_size(message_type_of(message_[0]))) {
+      this->message(std::span<std::uint32_t const>{message_.data(), pos_});
+      pos_ = 0;
+    }
+  }
+
+  /// \brief Dispatches a contiguous buffer of UMP words.
+  ///
+  /// Messages which lie entirely within \p umps are delivered directly from the caller's buffer; only a message that
+  /// is split across calls is copied into the dispatcher's internal storage.
+  ///
+  /// The result is the same as calling dispatch() for each word in \p umps unless the backend has a batch() overload
+  /// for a message type (see dispatcher_backend::batch_handler). In that case, a run of two or more consecutive m1cvm
+  /// or m2cvm messages of that type (for example, the note-on messages of a chord, regardless of their channel) is
+  /// passed to batch() in calls of at most batch_size messages instead of to the per-message member function. A
+  /// message that is not part of such a run, or that is split across calls, is delivered on its own as usual. The
+  /// *_overload backends have a batch() overload only for a message type which the overload set accepts as a
+  /// std::span<Message const> and only if the set has no generic catch-all handler.
+  ///
+  /// \param umps  A span of UMP message words.
+  void dispatch(std::span<std::uint32_t const> umps) {
+    // Complete any message left incomplete by an earlier call.
+    for (; pos_ > 0U && !umps.empty(); umps = umps.subspan(1)) {
+      this->dispatch(umps.front());
+    }
+    while (!umps.empty()) {
+      auto const size = ump_message_size(message_type_of(umps.front()));
+      if (umps.size() < size) {
+        // The final message is incomplete: hold its words until the remainder arrives.
+        for (auto const ump : umps) {
+          this->dispatch(ump);
+        }
         break;
       }
-      pos_ = 0;
+      if (auto const consumed = this->batch(umps); consumed > 0U) {
+        umps = umps.subspan(consumed);
+        continue;
+      }
+      this->message(umps.first(size));
+      umps = umps.subspan(size);
     }
   }
 
+  /// The maximum number of messages passed to a single call of a backend's batch() member function.
+  static constexpr std::size_t batch_size = 16;
+
   [[nodiscard]] constexpr config_type& config() noexcept { return config_; }
   [[nodiscard]] constexpr config_type const& config() const noexcept { return config_; }
 
+  /// A mask with bit n set if messages of type n are decoded and delivered to the configuration. Messages of any
+  /// other type are consumed and discarded without being decoded.
+  static constexpr std::uint16_t handled_message_types = details::handled_message_types<config_type>();
+  /// \returns True if messages of type \p mt are decoded and delivered to the configuration.
+  [[nodiscard]] static constexpr bool handles(message_type const mt) noexcept {
+    return ((handled_message_types >> std::to_underlying(mt)) & 1U) != 0U;
+  }
+
 private:
-  void utility_message();
-  void system_message();
-  void m1cvm_message();
-  void data64_message();
-  void m2cvm_message();
-  void stream_message();
-  void data128_message();
-  void flex_data_message();
-  void unknown() {
+  [[nodiscard]] static constexpr message_type message_type_of(std::uint32_t const ump) noexcept {
+    return static_cast<message_type>((ump >> 28) & 0xF);
+  }
+
+  /// Delivers a complete message (whose size matches that required by its message type) to the appropriate handler.
+  void message(std::span<std::uint32_t const> const m) {
+    assert(!m.empty() && m.size() == ump_message_size(message_type_of(m[0])));
+    auto const mt = message_type_of(m[0]);
+    if (!handles(mt)) {
+      return;
+    }
+    // The arms for ignored message types are discarded so that their decoders are never instantiated.
+    using enum message_type;
+    // clang-format off
+    switch (mt) {
+    case utility: if constexpr (handles(utility)) { this->utility_message(m); } break;
+    case system: if constexpr (handles(system)) { this->system_message(m); } break;
+    case m1cvm: if constexpr (handles(m1cvm)) { this->m1cvm_message(m); } break;
+    case m2cvm: if constexpr (handles(m2cvm)) { this->m2cvm_message(m); } break;
+    case flex_data: if constexpr (handles(flex_data)) { this->flex_data_message(m); } break;
+    case stream: if constexpr (handles(stream)) { this->stream_message(m); } break;
+    case data64: if constexpr (handles(data64)) { this->data64_message(m); } break;
+    case data128: if constexpr (handles(data128)) { this->data128_message(m); } break;
+
+    case reserved32_06:
+    case reserved32_07:
+    case reserved64_08:
+    case reserved64_09:
+    case reserved64_0a:
+    case reserved96_0b:
+    case reserved96_0c:
+    case reserved128_0e: this->unknown(m); break;
+    default:
+      assert(false);
+      unreachable();
+      break;
+    }
+    // clang-format on
+  }
+
+  void utility_message(std::span<std::uint32_t const> m);
+  void system_message(std::span<std::uint32_t const> m);
+  void m1cvm_message(std::span<std::uint32_t const> m);
+  void data64_message(std::span<std::uint32_t const> m);
+  void m2cvm_message(std::span<std::uint32_t const> m);
+  void stream_message(std::span<std::uint32_t const> m);
+  void data128_message(std::span<std::uint32_t const> m);
+  void flex_data_message(std::span<std::uint32_t const> m);
+  /// If the backend has a batch() overload for the type of the first message in \p umps and the following message
+  /// shares its message type and status, delivers the run of complete messages with that type and status.
+  /// \returns The number of words consumed: zero if the first message must be delivered on its own.
+  std::size_t batch(std::span<std::uint32_t const> umps);
+  template <message_type Type, typename Message, typename Backend>
+  std::size_t batch_run(Backend& backend, std::span<std::uint32_t const> umps);
+  /// Passes a message to the utility.unknown() handler. The handler is passed a mutable span so the message is copied
+  /// to local storage: this is a rare path.
+  void unknown(std::span<std::uint32_t const> const m) {
+    assert(m.size() <= 4U);
+    std::array<std::uint32_t, 4> copy{};
+    std::ranges::copy(m, copy.begin());
     auto& c = this->config();
-    c.utility.unknown(c.context, std::span{message_.data(), pos_});
+    c.utility.unknown(c.context, std::span{copy.data(), m.size()});
   }
   // TODO: replace message_/pos_ with inplace_vector<> eventually.
   std::array<std::uint32_t, 4> message_{};
@@ -179,14 +351,14 @@ template <typename T> ump_dispatcher(T) -> ump_dispatcher<T>;
 // 32 bit utility messages
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::utility_message() {
+void ump_dispatcher<Config>::utility_message(std::span<std::uint32_t const> const m) {
   constexpr auto size = ump_message_size(message_type::utility);
-  auto const span = std::span<std::uint32_t, size>{message_.data(), size};
-  assert(pos_ == size);
+  auto const span = std::span<std::uint32_t const, size>{m.data(), size};
+  assert(m.size() == size);
 
   auto& c = this->config();
   using enum mt::utility;
-  switch (static_cast<mt::utility>((message_[0] >> 20) & 0x0F)) {
+  switch (static_cast<mt::utility>((m[0] >> 20) & 0x0F)) {
     // 7.2.1 NOOP
   case noop:
     c.utility.noop(c.context);
@@ -205,7 +377,7 @@ void ump_dispatcher<Config>::utility_message() {
     break;
     // 7.2.3.2 Delta Clockstamp (DC): Ticks Since Last Event
   case delta_clock_since: c.utility.delta_clockstamp(c.context, utility::delta_clockstamp{span}); break;
-  default: c.utility.unknown(c.context, span); break;
+  default: this->unknown(m); break;
   }
 }
 
@@ -214,14 +386,14 @@ void ump_dispatcher<Config>::utility_message() {
 // 32-bit System Common and Real Time
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::system_message() {
+void ump_dispatcher<Config>::system_message(std::span<std::uint32_t const> const m) {
   constexpr auto size = ump_message_size(message_type::system);
-  auto const span = std::span<std::uint32_t, size>{message_.data(), size};
-  assert(pos_ == span.size());
+  auto const span = std::span<std::uint32_t const, size>{m.data(), size};
+  assert(m.size() == span.size());
 
   using enum mt::system_crt;
   auto& c = this->config();
-  switch (static_cast<mt::system_crt>((message_[0] >> 16) & 0xFF)) {
+  switch (static_cast<mt::system_crt>((m[0] >> 16) & 0xFF)) {
   case timing_code: c.system.midi_time_code(c.context, system::midi_time_code{span}); break;
   case spp: c.system.song_position_pointer(c.context, system::song_position_pointer{span}); break;
   case song_select: c.system.song_select(c.context, system::song_select{span}); break;
@@ -232,7 +404,7 @@ void ump_dispatcher<Config>::system_message() {
   case sequence_stop: c.system.seq_stop(c.context, system::sequence_stop{span}); break;
   case active_sensing: c.system.active_sensing(c.context, system::active_sensing{span}); break;
   case system_reset: c.system.reset(c.context, system::reset{span}); break;
-  default: c.utility.unknown(c.context, span); break;
+  default: this->unknown(m); break;
   }
 }
 
@@ -241,14 +413,14 @@ void ump_dispatcher<Config>::system_message() {
 // 32 Bit MIDI 1.0 Channel Voice Messages
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::m1cvm_message() {
+void ump_dispatcher<Config>::m1cvm_message(std::span<std::uint32_t const> const m) {
   constexpr auto size = ump_message_size(message_type::system);
-  auto const span = std::span<std::uint32_t, size>{message_.data(), size};
-  assert(pos_ == span.size());
+  auto const span = std::span<std::uint32_t const, size>{m.data(), size};
+  assert(m.size() == span.size());
 
   using enum mt::m1cvm;
   auto& c = this->config();
-  switch (static_cast<mt::m1cvm>((message_[0] >> 20) & 0xF)) {
+  switch (static_cast<mt::m1cvm>((m[0] >> 20) & 0xF)) {
   case note_off: c.m1cvm.note_off(c.context, m1cvm::note_off{span}); break;
   case note_on: c.m1cvm.note_on(c.context, m1cvm::note_on{span}); break;
   case poly_pressure: c.m1cvm.poly_pressure(c.context, m1cvm::poly_pressure{span}); break;
@@ -256,7 +428,7 @@ void ump_dispatcher<Config>::m1cvm_message() {
   case program_change: c.m1cvm.program_change(c.context, m1cvm::program_change{span}); break;
   case channel_pressure: c.m1cvm.channel_pressure(c.context, m1cvm::channel_pressure{span}); break;
   case pitch_bend: c.m1cvm.pitch_bend(c.context, m1cvm::pitch_bend{span}); break;
-  default: c.utility.unknown(c.context, span); break;
+  default: this->unknown(m); break;
   }
 }
 
@@ -264,19 +436,19 @@ void ump_dispatcher<Config>::m1cvm_message() {
 // ~~~~~~~~~~~~~~
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::data64_message() {
+void ump_dispatcher<Config>::data64_message(std::span<std::uint32_t const> const m) {
   constexpr auto size = ump_message_size(message_type::data64);
-  assert(pos_ == size);
+  assert(m.size() == size);
 
   using enum mt::data64;
   auto& c = this->config();
-  auto const span = std::span<std::uint32_t, size>{message_.data(), size};
-  switch (static_cast<mt::data64>((message_[0] >> 20) & 0x0F)) {
+  auto const span = std::span<std::uint32_t const, size>{m.data(), size};
+  switch (static_cast<mt::data64>((m[0] >> 20) & 0x0F)) {
   case sysex7_in_1: c.data64.sysex7_in_1(c.context, data64::sysex7_in_1{span}); break;
   case sysex7_start: c.data64.sysex7_start(c.context, data64::sysex7_start{span}); break;
   case sysex7_continue: c.data64.sysex7_continue(c.context, data64::sysex7_continue{span}); break;
   case sysex7_end: c.data64.sysex7_end(c.context, data64::sysex7_end{span}); break;
-  default: c.utility.unknown(c.context, span); break;
+  default: this->unknown(m); break;
   }
 }
 
@@ -285,12 +457,12 @@ void ump_dispatcher<Config>::data64_message() {
 // 64 bit MIDI 2.0 Channel Voice Messages
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::m2cvm_message() {
+void ump_dispatcher<Config>::m2cvm_message(std::span<std::uint32_t const> const m) {
   static_assert(message_size<message_type::m2cvm>() == 2);
-  auto const span = std::span<std::uint32_t, 2>{message_.data(), 2};
+  auto const span = std::span<std::uint32_t const, 2>{m.data(), 2};
   using enum mt::m2cvm;
   auto& c = this->config();
-  switch (static_cast<mt::m2cvm>((message_[0] >> 20) & 0xF)) {
+  switch (static_cast<mt::m2cvm>((m[0] >> 20) & 0xF)) {
     // 7.4.1 MIDI 2.0 Note Off Message
   case note_off:
     c.m2cvm.note_off(c.context, m2cvm::note_off{span});
@@ -343,7 +515,93 @@ void ump_dispatcher<Config>::m2cvm_message() {
     break;
     // 7.4.12 MIDI 2.0 Per-Note Pitch Bend Message
   case pitch_bend_per_note: c.m2cvm.per_note_pitch_bend(c.context, m2cvm::per_note_pitch_bend{span}); break;
-  default: c.utility.unknown(c.context, std::span{message_.data(), 2}); break;
+  default: this->unknown(m); break;
+  }
+}
+
+// batch
+// ~~~~~
+template <typename Config>
+  requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
+std::size_t ump_dispatcher<Config>::batch(std::span<std::uint32_t const> const umps) {
+  auto& c = this->config();
+  auto const status = (umps.front() >> 20) & 0xF;
+  switch (message_type_of(umps.front())) {
+  case message_type::m1cvm:
+    if constexpr (handles(message_type::m1cvm)) {
+      constexpr auto type = message_type::m1cvm;
+      using enum mt::m1cvm;
+      switch (static_cast<mt::m1cvm>(status)) {
+      case note_off: return this->batch_run<type, m1cvm::note_off>(c.m1cvm, umps);
+      case note_on: return this->batch_run<type, m1cvm::note_on>(c.m1cvm, umps);
+      case poly_pressure: return this->batch_run<type, m1cvm::poly_pressure>(c.m1cvm, umps);
+      case cc: return this->batch_run<type, m1cvm::control_change>(c.m1cvm, umps);
+      case program_change: return this->batch_run<type, m1cvm::program_change>(c.m1cvm, umps);
+      case channel_pressure: return this->batch_run<type, m1cvm::channel_pressure>(c.m1cvm, umps);
+      case pitch_bend: return this->batch_run<type, m1cvm::pitch_bend>(c.m1cvm, umps);
+      default: break;
+      }
+    }
+    break;
+  case message_type::m2cvm:
+    if constexpr (handles(message_type::m2cvm)) {
+      constexpr auto type = message_type::m2cvm;
+      using enum mt::m2cvm;
+      switch (static_cast<mt::m2cvm>(status)) {
+      case note_off: return this->batch_run<type, m2cvm::note_off>(c.m2cvm, umps);
+      case note_on: return this->batch_run<type, m2cvm::note_on>(c.m2cvm, umps);
+      case poly_pressure: return this->batch_run<type, m2cvm::poly_pressure>(c.m2cvm, umps);
+      case rpn_per_note: return this->batch_run<type, m2cvm::rpn_per_note_controller>(c.m2cvm, umps);
+      case nrpn_per_note: return this->batch_run<type, m2cvm::nrpn_per_note_controller>(c.m2cvm, umps);
+      case per_note_manage: return this->batch_run<type, m2cvm::per_note_management>(c.m2cvm, umps);
+      case cc: return this->batch_run<type, m2cvm::control_change>(c.m2cvm, umps);
+      case rpn: return this->batch_run<type, m2cvm::rpn_controller>(c.m2cvm, umps);
+      case nrpn: return this->batch_run<type, m2cvm::nrpn_controller>(c.m2cvm, umps);
+      case rpn_relative: return this->batch_run<type, m2cvm::rpn_relative_controller>(c.m2cvm, umps);
+      case nrpn_relative: return this->batch_run<type, m2cvm::nrpn_relative_controller>(c.m2cvm, umps);
+      case program_change: return this->batch_run<type, m2cvm::program_change>(c.m2cvm, umps);
+      case channel_pressure: return this->batch_run<type, m2cvm::channel_pressure>(c.m2cvm, umps);
+      case pitch_bend: return this->batch_run<type, m2cvm::pitch_bend>(c.m2cvm, umps);
+      case pitch_bend_per_note: return this->batch_run<type, m2cvm::per_note_pitch_bend>(c.m2cvm, umps);
+      default: break;
+      }
+    }
+    break;
+  default: break;
+  }
+  return 0U;
+}
+
+template <typename Config>
+  requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
+template <message_type Type, typename Message, typename Backend>
+std::size_t ump_dispatcher<Config>::batch_run(Backend& backend, std::span<std::uint32_t const> umps) {
+  if constexpr (!dispatcher_backend::batch_handler<Backend, decltype(config_type::context), Message>) {
+    return 0U;
+  } else {
+    constexpr auto size = std::size_t{message_size<Type>()};
+    // The message type and status fields that are shared by every message in the run.
+    constexpr auto key_mask = std::uint32_t{0xF0F00000};
+    auto const key = umps.front() & key_mask;
+    if (umps.size() < 2 * size || (umps[size] & key_mask) != key) {
+      return 0U;  // A run of one message is delivered on its own.
+    }
+    std::array<Message, batch_size> messages;
+    auto& c = this->config();
+    auto count = std::size_t{0};
+    auto consumed = std::size_t{0};
+    for (; umps.size() >= size && (umps.front() & key_mask) == key; umps = umps.subspan(size)) {
+      messages[count] = Message{std::span<std::uint32_t const, size>{umps.data(), size}};
+      consumed += size;
+      if (++count == batch_size) {
+        backend.batch(c.context, std::span<Message const>{messages}.first(count));
+        count = 0;
+      }
+    }
+    if (count > 0U) {
+      backend.batch(c.context, std::span<Message const>{messages}.first(count));
+    }
+    return consumed;
   }
 }
 
@@ -351,7 +609,7 @@ void ump_dispatcher<Config>::m2cvm_message() {
 // ~~~~~~~~~~~~~~~~~~
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::stream_message() {
+void ump_dispatcher<Config>::stream_message(std::span<std::uint32_t const> const m) {
   using stream::device_identity_notification;
   using stream::end_of_clip;
   using stream::endpoint_discovery;
@@ -366,10 +624,10 @@ void ump_dispatcher<Config>::stream_message() {
   using stream::start_of_clip;
 
   static_assert(ump_message_size(message_type::stream) == 4);
-  assert(pos_ >= ump_message_size(message_type::stream));
+  assert(m.size() == ump_message_size(message_type::stream));
   auto& c = this->config();
-  auto const span = std::span<std::uint32_t, 4>{message_.data(), 4};
-  switch (static_cast<mt::stream>((message_[0] >> 16) & ((std::uint32_t{1} << 10) - 1U))) {
+  auto const span = std::span<std::uint32_t const, 4>{m.data(), 4};
+  switch (static_cast<mt::stream>((m[0] >> 16) & ((std::uint32_t{1} << 10) - 1U))) {
     // 7.1.1 Endpoint Discovery Message
   case mt::stream::endpoint_discovery:
     c.stream.endpoint_discovery(c.context, endpoint_discovery{span});
@@ -416,7 +674,7 @@ void ump_dispatcher<Config>::stream_message() {
     break;
     // 7.1.11 End of Clip Message
   case mt::stream::end_of_clip: c.stream.end_of_clip(c.context, end_of_clip{span}); break;
-  default: c.utility.unknown(c.context, std::span{message_.data(), 4}); break;
+  default: this->unknown(m); break;
   }
 }
 
@@ -424,21 +682,21 @@ void ump_dispatcher<Config>::stream_message() {
 // ~~~~~~~~~~~~~~~
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::data128_message() {
+void ump_dispatcher<Config>::data128_message(std::span<std::uint32_t const> const m) {
   static_assert(ump_message_size(message_type::stream) == 4);
-  assert(pos_ >= ump_message_size(message_type::stream));
+  assert(m.size() == ump_message_size(message_type::stream));
 
-  auto const span = std::span<std::uint32_t, 4>{message_.data(), 4};
+  auto const span = std::span<std::uint32_t const, 4>{m.data(), 4};
   using enum mt::data128;
   auto& c = this->config();
-  switch (static_cast<mt::data128>((message_[0] >> 20) & 0x0F)) {
+  switch (static_cast<mt::data128>((m[0] >> 20) & 0x0F)) {
   case sysex8_in_1: c.data128.sysex8_in_1(c.context, data128::sysex8_in_1{span}); break;
   case sysex8_start: c.data128.sysex8_start(c.context, data128::sysex8_start{span}); break;
   case sysex8_continue: c.data128.sysex8_continue(c.context, data128::sysex8_continue{span}); break;
   case sysex8_end: c.data128.sysex8_end(c.context, data128::sysex8_end{span}); break;
   case mixed_data_set_header: c.data128.mds_header(c.context, data128::mds_header{span}); break;
   case mixed_data_set_payload: c.data128.mds_payload(c.context, data128::mds_payload{span}); break;
-  default: c.utility.unknown(c.context, span); break;
+  default: this->unknown(m); break;
   }
 }
 
@@ -446,16 +704,16 @@ void ump_dispatcher<Config>::data128_message() {
 // ~~~~~~~~~~~~~~~~~
 template <typename Config>
   requires ump_dispatcher_config<std::unwrap_reference_t<Config>>
-void ump_dispatcher<Config>::flex_data_message() {
+void ump_dispatcher<Config>::flex_data_message(std::span<std::uint32_t const> const m) {
   static_assert(ump_message_size(message_type::stream) == 4);
-  assert(pos_ >= ump_message_size(message_type::stream));
+  assert(m.size() == ump_message_size(message_type::stream));
 
-  auto const span = std::span<std::uint32_t, 4>{message_.data(), 4};
-  auto const status_bank = (message_[0] >> 8) & 0xFF;
+  auto const span = std::span<std::uint32_t const, 4>{m.data(), 4};
+  auto const status_bank = (m[0] >> 8) & 0xFF;
   auto& c = this->config();
   if (status_bank == 0) {
     using enum mt::flex_data;
-    switch (auto const status = static_cast<mt::flex_data>(message_[0] & 0xFF); status) {
+    switch (auto const status = static_cast<mt::flex_data>(m[0] & 0xFF); status) {
       // 7.5.3 Set Tempo Message
     case set_tempo:
       c.flex.set_tempo(c.context, flex_data::set_tempo{span});
@@ -474,7 +732,7 @@ void ump_dispatcher<Config>::flex_data_message() {
       break;
       // 7.5.8 Set Chord Name Message
     case set_chord_name: c.flex.set_chord_name(c.context, flex_data::set_chord_name{span}); break;
-    default: c.utility.unknown(c.context, span); break;
+    default: this->unknown(m); break;
     }
   } else {
     c.flex.text(c.context, flex_data::text_common{span});
@@ -485,6 +743,28 @@ template <typename Context>
 ump_dispatcher<function_config<Context>> make_ump_function_dispatcher(Context&& context = Context{}) {
   return ump_dispatcher{function_config{std::forward<Context>(context)}};
 }
+template <typename Context>
+ump_dispatcher<compact_function_config<Context>> make_ump_compact_dispatcher(Context&& context = Context{}) {
+  return ump_dispatcher{compact_function_config<Context>{std::forward<Context>(context)}};
+}
+
+/// \brief Creates a UMP dispatcher which passes each message to the matching function of an overload set.
+///
+/// \code
+/// auto d = make_ump_dispatcher(context, midi2::overloaded{
+///   [](context_type& c, m2cvm::note_on const& on) { ... },
+///   [](context_type& c, m2cvm::note_off const& off) { ... },
+/// });
+/// \endcode
+///
+/// \param context  The context object passed to each handler.
+/// \param handler  An empty, default-constructible overload set. Only its type is used.
+/// \returns A dispatcher whose configuration is an overload_config.
+template <typename Context, dispatcher_backend::overload_handler Handler>
+ump_dispatcher<overload_config<Context, Handler>> make_ump_dispatcher(Context&& context,
+                                                                      [[maybe_unused]] Handler const& handler) {
+  return ump_dispatcher{overload_config<Context, Handler>{std::forward<Context>(context)}};
+}
 
 }  // end namespace midi2::ump
 
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <functional>
 #include <span>
+#include <type_traits>
 
 #include "midi2/ump/ump_types.hpp"
 #include "midi2/utils.hpp"
@@ -142,6 +143,16 @@ concept flex_data = requires(T v, Context context) {
 };
 // clang-format on
 
+/// \brief Satisfied by a backend which accepts a run of consecutive messages of type \p Message in a single call.
+///
+/// When a buffer of words is passed to ump_dispatcher::dispatch(), a run of two or more consecutive m1cvm or m2cvm
+/// messages with the same status is delivered to the backend's batch() member function if it has an overload for
+/// that message type. Other messages are delivered one at a time as usual.
+template <typename T, typename Context, typename Message>
+concept batch_handler = requires(T v, Context context, std::span<Message const> messages) {
+  { v.batch(context, messages) } -> std::same_as<void>;
+};
+
 // clang-format off
 template <typename Context> struct utility_null {
   // 7.2.1 NOOP
@@ -279,6 +290,19 @@ template <typename Context> struct flex_data_null {
 
 static_assert(flex_data<flex_data_null<int>, int>, "flex_data_null must implement the flex_data concept");
 
+/// \brief True if \p T is one of the *_null backends. The dispatcher neither decodes nor delivers the messages of a
+///   category whose backend is null.
+template <typename T> struct is_null : std::false_type {};
+template <typename Context> struct is_null<utility_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<system_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<m1cvm_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<data64_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<m2cvm_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<data128_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<stream_null<Context>> : std::true_type {};
+template <typename Context> struct is_null<flex_data_null<Context>> : std::true_type {};
+template <typename T> inline constexpr bool is_null_v = is_null<std::remove_cvref_t<T>>::value;
+
 template <typename Context> struct utility_pure {
   constexpr utility_pure() noexcept = default;
   constexpr utility_pure(utility_pure const &) = default;
@@ -568,14 +592,14 @@ template <typename Context> struct flex_data_base : flex_data_pure<Context> {
 };
 // clang-format on
 
-template <typename Context> class utility_function {
+template <typename Context, template <typename> class Function = std::function> class utility_function {
 public:
-  using noop_fn = std::function<void(Context)>;
-  using jr_clock_fn = std::function<void(Context, utility::jr_clock const &)>;
-  using jr_timestamp_fn = std::function<void(Context, utility::jr_timestamp const &)>;
-  using delta_clockstamp_tpqn_fn = std::function<void(Context, utility::delta_clockstamp_tpqn const &)>;
-  using delta_clockstamp_fn = std::function<void(Context, utility::delta_clockstamp const &)>;
-  using unknown_fn = std::function<void(Context, std::span<std::uint32_t>)>;
+  using noop_fn = Function<void(Context)>;
+  using jr_clock_fn = Function<void(Context, utility::jr_clock const &)>;
+  using jr_timestamp_fn = Function<void(Context, utility::jr_timestamp const &)>;
+  using delta_clockstamp_tpqn_fn = Function<void(Context, utility::delta_clockstamp_tpqn const &)>;
+  using delta_clockstamp_fn = Function<void(Context, utility::delta_clockstamp const &)>;
+  using unknown_fn = Function<void(Context, std::span<std::uint32_t>)>;
 
   // clang-format off
   constexpr utility_function &on_noop(noop_fn noop) noexcept { noop_ = std::move(noop); return *this; }
@@ -605,18 +629,18 @@ private:
 static_assert(utility<utility_function<int>, int>, "utility_function must implement the utility concept");
 
 // 7.6 System Common and System Real Time Messages
-template <typename Context> class system_function {
+template <typename Context, template <typename> class Function = std::function> class system_function {
 public:
-  using midi_time_code_fn = std::function<void(Context, system::midi_time_code const &)>;
-  using song_position_pointer_fn = std::function<void(Context, system::song_position_pointer const &)>;
-  using song_select_fn = std::function<void(Context, system::song_select const &)>;
-  using tune_request_fn = std::function<void(Context, system::tune_request const &)>;
-  using timing_clock_fn = std::function<void(Context, system::timing_clock const &)>;
-  using seq_start_fn = std::function<void(Context, system::sequence_start const &)>;
-  using seq_continue_fn = std::function<void(Context, system::sequence_continue const &)>;
-  using seq_stop_fn = std::function<void(Context, system::sequence_stop const &)>;
-  using active_sensing_fn = std::function<void(Context, system::active_sensing const &)>;
-  using reset_fn = std::function<void(Context, system::reset const &)>;
+  using midi_time_code_fn = Function<void(Context, system::midi_time_code const &)>;
+  using song_position_pointer_fn = Function<void(Context, system::song_position_pointer const &)>;
+  using song_select_fn = Function<void(Context, system::song_select const &)>;
+  using tune_request_fn = Function<void(Context, system::tune_request const &)>;
+  using timing_clock_fn = Function<void(Context, system::timing_clock const &)>;
+  using seq_start_fn = Function<void(Context, system::sequence_start const &)>;
+  using seq_continue_fn = Function<void(Context, system::sequence_continue const &)>;
+  using seq_stop_fn = Function<void(Context, system::sequence_stop const &)>;
+  using active_sensing_fn = Function<void(Context, system::active_sensing const &)>;
+  using reset_fn = Function<void(Context, system::reset const &)>;
 
   // clang-format off
   constexpr system_function &on_midi_time_code(midi_time_code_fn midi_time_code) { midi_time_code_ = std::move(midi_time_code); return *this; }
@@ -657,15 +681,15 @@ private:
 
 static_assert(system<system_function<int>, int>, "system_function must implement the system concept");
 
-template <typename Context> class m1cvm_function {
+template <typename Context, template <typename> class Function = std::function> class m1cvm_function {
 public:
-  using note_off_fn = std::function<void(Context, m1cvm::note_off const &)>;
-  using note_on_fn = std::function<void(Context, m1cvm::note_on const &)>;
-  using poly_pressure_fn = std::function<void(Context, m1cvm::poly_pressure const &)>;
-  using control_change_fn = std::function<void(Context, m1cvm::control_change const &)>;
-  using program_change_fn = std::function<void(Context, m1cvm::program_change const &)>;
-  using channel_pressure_fn = std::function<void(Context, m1cvm::channel_pressure const &)>;
-  using pitch_bend_fn = std::function<void(Context, m1cvm::pitch_bend const &)>;
+  using note_off_fn = Function<void(Context, m1cvm::note_off const &)>;
+  using note_on_fn = Function<void(Context, m1cvm::note_on const &)>;
+  using poly_pressure_fn = Function<void(Context, m1cvm::poly_pressure const &)>;
+  using control_change_fn = Function<void(Context, m1cvm::control_change const &)>;
+  using program_change_fn = Function<void(Context, m1cvm::program_change const &)>;
+  using channel_pressure_fn = Function<void(Context, m1cvm::channel_pressure const &)>;
+  using pitch_bend_fn = Function<void(Context, m1cvm::pitch_bend const &)>;
 
   // clang-format off
   constexpr m1cvm_function &on_note_off(note_off_fn note_off) noexcept { note_off_ = std::move(note_off); return *this; }
@@ -697,12 +721,12 @@ private:
 
 static_assert(m1cvm<m1cvm_function<int>, int>, "m1cvm_function must implement the m1cvm concept");
 
-template <typename Context> class data64_function {
+template <typename Context, template <typename> class Function = std::function> class data64_function {
 public:
-  using sysex7_in_1_fn = std::function<void(Context, data64::sysex7_in_1 const &)>;
-  using sysex7_start_fn = std::function<void(Context, data64::sysex7_start const &)>;
-  using sysex7_continue_fn = std::function<void(Context, data64::sysex7_continue const &)>;
-  using sysex7_end_fn = std::function<void(Context, data64::sysex7_end const &)>;
+  using sysex7_in_1_fn = Function<void(Context, data64::sysex7_in_1 const &)>;
+  using sysex7_start_fn = Function<void(Context, data64::sysex7_start const &)>;
+  using sysex7_continue_fn = Function<void(Context, data64::sysex7_continue const &)>;
+  using sysex7_end_fn = Function<void(Context, data64::sysex7_end const &)>;
 
   // clang-format off
   constexpr data64_function &on_sysex7_in_1(sysex7_in_1_fn sysex7_in_1) noexcept { sysex7_in_1_ = std::move(sysex7_in_1); return *this; }
@@ -725,23 +749,23 @@ private:
 
 static_assert(data64<data64_function<int>, int>, "data64_function must implement the data64 concept");
 
-template <typename Context> class m2cvm_function {
+template <typename Context, template <typename> class Function = std::function> class m2cvm_function {
 public:
-  using note_off_fn = std::function<void(Context, m2cvm::note_off const &)>;
-  using note_on_fn = std::function<void(Context, m2cvm::note_on const &)>;
-  using poly_pressure_fn = std::function<void(Context, m2cvm::poly_pressure const &)>;
-  using program_change_fn = std::function<void(Context, m2cvm::program_change const &)>;
-  using channel_pressure_fn = std::function<void(Context, m2cvm::channel_pressure const &)>;
-  using rpn_per_note_controller_fn = std::function<void(Context, m2cvm::rpn_per_note_controller const &)>;
-  using nrpn_per_note_controller_fn = std::function<void(Context, m2cvm::nrpn_per_note_controller const &)>;
-  using rpn_controller_fn = std::function<void(Context, m2cvm::rpn_controller const &)>;
-  using nrpn_controller_fn = std::function<void(Context, m2cvm::nrpn_controller const &)>;
-  using rpn_relative_controller_fn = std::function<void(Context, m2cvm::rpn_relative_controller const &)>;
-  using nrpn_relative_controller_fn = std::function<void(Context, m2cvm::nrpn_relative_controller const &)>;
-  using per_note_management_fn = std::function<void(Context, m2cvm::per_note_management const &)>;
-  using control_change_fn = std::function<void(Context, m2cvm::control_change const &)>;
-  using pitch_bend_fn = std::function<void(Context, m2cvm::pitch_bend const &)>;
-  using per_note_pitch_bend_fn = std::function<void(Context, m2cvm::per_note_pitch_bend const &)>;
+  using note_off_fn = Function<void(Context, m2cvm::note_off const &)>;
+  using note_on_fn = Function<void(Context, m2cvm::note_on const &)>;
+  using poly_pressure_fn = Function<void(Context, m2cvm::poly_pressure const &)>;
+  using program_change_fn = Function<void(Context, m2cvm::program_change const &)>;
+  using channel_pressure_fn = Function<void(Context, m2cvm::channel_pressure const &)>;
+  using rpn_per_note_controller_fn = Function<void(Context, m2cvm::rpn_per_note_controller const &)>;
+  using nrpn_per_note_controller_fn = Function<void(Context, m2cvm::nrpn_per_note_controller const &)>;
+  using rpn_controller_fn = Function<void(Context, m2cvm::rpn_controller const &)>;
+  using nrpn_controller_fn = Function<void(Context, m2cvm::nrpn_controller const &)>;
+  using rpn_relative_controller_fn = Function<void(Context, m2cvm::rpn_relative_controller const &)>;
+  using nrpn_relative_controller_fn = Function<void(Context, m2cvm::nrpn_relative_controller const &)>;
+  using per_note_management_fn = Function<void(Context, m2cvm::per_note_management const &)>;
+  using control_change_fn = Function<void(Context, m2cvm::control_change const &)>;
+  using pitch_bend_fn = Function<void(Context, m2cvm::pitch_bend const &)>;
+  using per_note_pitch_bend_fn = Function<void(Context, m2cvm::per_note_pitch_bend const &)>;
 
   // clang-format off
   constexpr m2cvm_function &on_note_off(note_off_fn off) noexcept { note_off_ = std::move(off); return *this; }
@@ -797,14 +821,14 @@ private:
 
 static_assert(m2cvm<m2cvm_function<int>, int>, "m2cvm_function must implement the m2cvm concept");
 
-template <typename Context> class data128_function {
+template <typename Context, template <typename> class Function = std::function> class data128_function {
 public:
-  using sysex8_in_1_fn = std::function<void(Context, data128::sysex8_in_1 const &)>;
-  using sysex8_start_fn = std::function<void(Context, data128::sysex8_start const &)>;
-  using sysex8_continue_fn = std::function<void(Context, data128::sysex8_continue const &)>;
-  using sysex8_end_fn = std::function<void(Context, data128::sysex8_end const &)>;
-  using mds_header_fn = std::function<void(Context, data128::mds_header const &)>;
-  using mds_payload_fn = std::function<void(Context, data128::mds_payload const &)>;
+  using sysex8_in_1_fn = Function<void(Context, data128::sysex8_in_1 const &)>;
+  using sysex8_start_fn = Function<void(Context, data128::sysex8_start const &)>;
+  using sysex8_continue_fn = Function<void(Context, data128::sysex8_continue const &)>;
+  using sysex8_end_fn = Function<void(Context, data128::sysex8_end const &)>;
+  using mds_header_fn = Function<void(Context, data128::mds_header const &)>;
+  using mds_payload_fn = Function<void(Context, data128::mds_payload const &)>;
 
   // clang-format off
   constexpr data128_function &on_sysex8_in_1(sysex8_in_1_fn sysex8_in_1) noexcept { sysex8_in_1_ = std::move(sysex8_in_1); return *this; }
@@ -833,23 +857,23 @@ private:
 
 static_assert(data128<data128_function<int>, int>, "data128_function must implement the data128 concept");
 
-template <typename Context> class stream_function {
+template <typename Context, template <typename> class Function = std::function> class stream_function {
 public:
-  using endpoint_discovery_fn = std::function<void(Context, stream::endpoint_discovery const &)>;
-  using endpoint_info_notification_fn = std::function<void(Context, stream::endpoint_info_notification const &)>;
-  using device_identity_notification_fn = std::function<void(Context, stream::device_identity_notification const &)>;
-  using endpoint_name_notification_fn = std::function<void(Context, stream::endpoint_name_notification const &)>;
+  using endpoint_discovery_fn = Function<void(Context, stream::endpoint_discovery const &)>;
+  using endpoint_info_notification_fn = Function<void(Context, stream::endpoint_info_notification const &)>;
+  using device_identity_notification_fn = Function<void(Context, stream::device_identity_notification const &)>;
+  using endpoint_name_notification_fn = Function<void(Context, stream::endpoint_name_notification const &)>;
   using product_instance_id_notification_fn =
-      std::function<void(Context, stream::product_instance_id_notification const &)>;
-  using jr_configuration_request_fn = std::function<void(Context, stream::jr_configuration_request const &)>;
-  using jr_configuration_notification_fn = std::function<void(Context, stream::jr_configuration_notification const &)>;
-  using function_block_discovery_fn = std::function<void(Context, stream::function_block_discovery const &)>;
+      Function<void(Context, stream::product_instance_id_notification const &)>;
+  using jr_configuration_request_fn = Function<void(Context, stream::jr_configuration_request const &)>;
+  using jr_configuration_notification_fn = Function<void(Context, stream::jr_configuration_notification const &)>;
+  using function_block_discovery_fn = Function<void(Context, stream::function_block_discovery const &)>;
   using function_block_info_notification_fn =
-      std::function<void(Context, stream::function_block_info_notification const &)>;
+      Function<void(Context, stream::function_block_info_notification const &)>;
   using function_block_name_notification_fn =
-      std::function<void(Context, stream::function_block_name_notification const &)>;
-  using start_of_clip_fn = std::function<void(Context, stream::start_of_clip const &)>;
-  using end_of_clip_fn = std::function<void(Context, stream::end_of_clip const &)>;
+      Function<void(Context, stream::function_block_name_notification const &)>;
+  using start_of_clip_fn = Function<void(Context, stream::start_of_clip const &)>;
+  using end_of_clip_fn = Function<void(Context, stream::end_of_clip const &)>;
 
   // clang-format off
   constexpr stream_function &on_endpoint_discovery(endpoint_discovery_fn discovery) noexcept { endpoint_discovery_ = std::move(discovery); return *this; }
@@ -898,14 +922,14 @@ private:
 
 static_assert(stream<stream_function<int>, int>, "stream_function must implement the stream concept");
 
-template <typename Context> class flex_data_function {
+template <typename Context, template <typename> class Function = std::function> class flex_data_function {
 public:
-  using set_tempo_fn = std::function<void(Context, flex_data::set_tempo const &)>;
-  using set_time_signature_fn = std::function<void(Context, flex_data::set_time_signature const &)>;
-  using set_metronome_fn = std::function<void(Context, flex_data::set_metronome const &)>;
-  using set_key_signature_fn = std::function<void(Context, flex_data::set_key_signature const &)>;
-  using set_chord_name_fn = std::function<void(Context, flex_data::set_chord_name const &)>;
-  using text_fn = std::function<void(Context, flex_data::text_common const &)>;
+  using set_tempo_fn = Function<void(Context, flex_data::set_tempo const &)>;
+  using set_time_signature_fn = Function<void(Context, flex_data::set_time_signature const &)>;
+  using set_metronome_fn = Function<void(Context, flex_data::set_metronome const &)>;
+  using set_key_signature_fn = Function<void(Context, flex_data::set_key_signature const &)>;
+  using set_chord_name_fn = Function<void(Context, flex_data::set_chord_name const &)>;
+  using text_fn = Function<void(Context, flex_data::text_common const &)>;
 
   // clang-format off
   constexpr flex_data_function &on_set_tempo(set_tempo_fn set_tempo) noexcept { set_tempo_ = std::move(set_tempo); return *this; }
@@ -934,6 +958,253 @@ private:
 
 static_assert(flex_data<flex_data_function<int>, int>, "flex_data_function must implement the flex_data concept");
 
+namespace details {
+/// A type that no handler names, so only a generic (catch-all) handler accepts it.
+struct catch_all_probe {};
+}  // namespace details
+
+/// \brief Satisfied if the overload set \p Handler has a handler for std::span<Message const> and no generic
+///   catch-all handler. A catch-all parameter would also bind to a span, so a set with one is never given a run of
+///   messages: each message reaches it individually, exactly as word-by-word dispatch would deliver it.
+template <typename Handler, typename Context, typename Message>
+concept overload_batch_handler = std::is_invocable_v<Handler, Context &, std::span<Message const>> &&
+                                 !std::is_invocable_v<Handler, Context &, details::catch_all_probe const &>;
+
+/// \brief Calls a default-constructed \p Handler with \p context and \p message if the handler accepts that message
+///   type. A handler which accepts only a span of that message type is passed a span of one message. Otherwise
+///   nothing happens, just as with the *_null backends.
+template <typename Handler, typename Context, typename Message>
+constexpr void invoke_overload(Context &context, Message const &message) {
+  if constexpr (std::is_invocable_v<Handler, Context &, Message const &>) {
+    Handler{}(context, message);
+  } else if constexpr (std::is_invocable_v<Handler, Context &, std::span<Message const>>) {
+    Handler{}(context, std::span<Message const>{&message, 1U});
+  }
+}
+
+/// \brief A handler type for the *_overload backends: an empty, default-constructible callable. This is normally an
+///   overload set of captureless lambdas built with midi2::overloaded. State belongs in the dispatcher's context,
+///   which the *_overload backends pass to the handlers by reference.
+template <typename T>
+concept overload_handler = std::is_empty_v<T> && std::default_initializable<T>;
+
+// clang-format off
+/// \brief Dispatches each utility message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct utility_overload {
+  // 7.2.1 NOOP
+  constexpr static void noop(Context &c) { invoke_overload<Handler>(c, utility::noop{}); }
+  // 7.2.2.1 JR Clock Message
+  constexpr static void jr_clock(Context &c, utility::jr_clock const &m) { invoke_overload<Handler>(c, m); }
+  // 7.2.2.2 JR Timestamp Message
+  constexpr static void jr_timestamp(Context &c, utility::jr_timestamp const &m) { invoke_overload<Handler>(c, m); }
+  // 7.2.3.1 Delta Clockstamp Ticks Per Quarter Note (TPQN)
+  constexpr static void delta_clockstamp_tpqn(Context &c, utility::delta_clockstamp_tpqn const &m) { invoke_overload<Handler>(c, m); }
+  // 7.2.3.2 Delta Clockstamp (DC): Ticks Since Last Event
+  constexpr static void delta_clockstamp(Context &c, utility::delta_clockstamp const &m) { invoke_overload<Handler>(c, m); }
+
+  constexpr static void unknown(Context &c, std::span<std::uint32_t> m) { invoke_overload<Handler>(c, m); }
+};
+// clang-format on
+
+static_assert(utility<utility_overload<int, overloaded<>>, int>,
+              "utility_overload must implement the utility concept");
+
+// clang-format off
+/// \brief Dispatches each system message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct system_overload {
+  // 7.6 System Common and System Real Time Messages
+  constexpr static void midi_time_code(Context &c, system::midi_time_code const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void song_position_pointer(Context &c, system::song_position_pointer const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void song_select(Context &c, system::song_select const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void tune_request(Context &c, system::tune_request const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void timing_clock(Context &c, system::timing_clock const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void seq_start(Context &c, system::sequence_start const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void seq_continue(Context &c, system::sequence_continue const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void seq_stop(Context &c, system::sequence_stop const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void active_sensing(Context &c, system::active_sensing const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void reset(Context &c, system::reset const &m) { invoke_overload<Handler>(c, m); }
+};
+// clang-format on
+
+static_assert(system<system_overload<int, overloaded<>>, int>,
+              "system_overload must implement the system concept");
+
+// clang-format off
+/// \brief Dispatches each m1cvm message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct m1cvm_overload {
+  constexpr static void note_off(Context &c, m1cvm::note_off const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void note_on(Context &c, m1cvm::note_on const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void poly_pressure(Context &c, m1cvm::poly_pressure const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void control_change(Context &c, m1cvm::control_change const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void program_change(Context &c, m1cvm::program_change const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void channel_pressure(Context &c, m1cvm::channel_pressure const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void pitch_bend(Context &c, m1cvm::pitch_bend const &m) { invoke_overload<Handler>(c, m); }
+  // A run of consecutive messages of the same type, delivered if the set has a handler for a span of that type
+  template <typename Message> requires overload_batch_handler<Handler, Context, Message>
+  constexpr static void batch(Context &c, std::span<Message const> m) { Handler{}(c, m); }
+};
+// clang-format on
+
+static_assert(m1cvm<m1cvm_overload<int, overloaded<>>, int>,
+              "m1cvm_overload must implement the m1cvm concept");
+
+// clang-format off
+/// \brief Dispatches each data64 message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct data64_overload {
+  constexpr static void sysex7_in_1(Context &c, data64::sysex7_in_1 const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void sysex7_start(Context &c, data64::sysex7_start const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void sysex7_continue(Context &c, data64::sysex7_continue const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void sysex7_end(Context &c, data64::sysex7_end const &m) { invoke_overload<Handler>(c, m); }
+};
+// clang-format on
+
+static_assert(data64<data64_overload<int, overloaded<>>, int>,
+              "data64_overload must implement the data64 concept");
+
+// clang-format off
+/// \brief Dispatches each m2cvm message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct m2cvm_overload {
+  constexpr static void note_off(Context &c, m2cvm::note_off const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void note_on(Context &c, m2cvm::note_on const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void poly_pressure(Context &c, m2cvm::poly_pressure const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void program_change(Context &c, m2cvm::program_change const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void channel_pressure(Context &c, m2cvm::channel_pressure const &m) { invoke_overload<Handler>(c, m); }
+  // 7.4.4 MIDI 2.0 Registered Per-Note Controller Message (status=0x0)
+  constexpr static void rpn_per_note_controller(Context &c, m2cvm::rpn_per_note_controller const &m) { invoke_overload<Handler>(c, m); }
+  // 7.4.4 MIDI 2.0 Registered Per-Note Controller Message (status=0x1)
+  constexpr static void nrpn_per_note_controller(Context &c, m2cvm::nrpn_per_note_controller const &m) { invoke_overload<Handler>(c, m); }
+  // 7.4.7 MIDI 2.0 Registered Controller (RPN) Message (status=0x2)
+  constexpr static void rpn_controller(Context &c, m2cvm::rpn_controller const &m) { invoke_overload<Handler>(c, m); }
+  // 7.4.7 MIDI 2.0 Assignable Controller (NRPN) Message (status=0x3)
+  constexpr static void nrpn_controller(Context &c, m2cvm::nrpn_controller const &m) { invoke_overload<Handler>(c, m); }
+  // 7.4.8 MIDI 2.0 Relative Registered Controller (RPN) Message (status=0x4)
+  constexpr static void rpn_relative_controller(Context &c, m2cvm::rpn_relative_controller const &m) { invoke_overload<Handler>(c, m); }
+  // 7.4.8 MIDI 2.0 Relative Assignable Controller (NRPN) Message (status=0x5)
+  constexpr static void nrpn_relative_controller(Context &c, m2cvm::nrpn_relative_controller const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void per_note_management(Context &c, m2cvm::per_note_management const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void control_change(Context &c, m2cvm::control_change const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void pitch_bend(Context &c, m2cvm::pitch_bend const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void per_note_pitch_bend(Context &c, m2cvm::per_note_pitch_bend const &m) { invoke_overload<Handler>(c, m); }
+  // A run of consecutive messages of the same type, delivered if the set has a handler for a span of that type
+  template <typename Message> requires overload_batch_handler<Handler, Context, Message>
+  constexpr static void batch(Context &c, std::span<Message const> m) { Handler{}(c, m); }
+};
+// clang-format on
+
+static_assert(m2cvm<m2cvm_overload<int, overloaded<>>, int>,
+              "m2cvm_overload must implement the m2cvm concept");
+
+// clang-format off
+/// \brief Dispatches each data128 message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct data128_overload {
+  constexpr static void sysex8_in_1(Context &c, data128::sysex8_in_1 const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void sysex8_start(Context &c, data128::sysex8_start const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void sysex8_continue(Context &c, data128::sysex8_continue const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void sysex8_end(Context &c, data128::sysex8_end const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void mds_header(Context &c, data128::mds_header const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void mds_payload(Context &c, data128::mds_payload const &m) { invoke_overload<Handler>(c, m); }
+};
+// clang-format on
+
+static_assert(data128<data128_overload<int, overloaded<>>, int>,
+              "data128_overload must implement the data128 concept");
+
+// clang-format off
+/// \brief Dispatches each stream message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct stream_overload {
+  constexpr static void endpoint_discovery(Context &c, stream::endpoint_discovery const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void endpoint_info_notification(Context &c, stream::endpoint_info_notification const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void device_identity_notification(Context &c, stream::device_identity_notification const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void endpoint_name_notification(Context &c, stream::endpoint_name_notification const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void product_instance_id_notification(Context &c, stream::product_instance_id_notification const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void jr_configuration_request(Context &c, stream::jr_configuration_request const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void jr_configuration_notification(Context &c, stream::jr_configuration_notification const &m) { invoke_overload<Handler>(c, m); }
+
+  constexpr static void function_block_discovery(Context &c, stream::function_block_discovery const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void function_block_info_notification(Context &c, stream::function_block_info_notification const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void function_block_name_notification(Context &c, stream::function_block_name_notification const &m) { invoke_overload<Handler>(c, m); }
+
+  constexpr static void start_of_clip(Context &c, stream::start_of_clip const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void end_of_clip(Context &c, stream::end_of_clip const &m) { invoke_overload<Handler>(c, m); }
+};
+// clang-format on
+
+static_assert(stream<stream_overload<int, overloaded<>>, int>,
+              "stream_overload must implement the stream concept");
+
+// clang-format off
+/// \brief Dispatches each flex_data message to an overload set. Message types that the set does not accept are ignored.
+template <typename Context, overload_handler Handler> struct flex_data_overload {
+  constexpr static void set_tempo(Context &c, flex_data::set_tempo const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void set_time_signature(Context &c, flex_data::set_time_signature const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void set_metronome(Context &c, flex_data::set_metronome const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void set_key_signature(Context &c, flex_data::set_key_signature const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void set_chord_name(Context &c, flex_data::set_chord_name const &m) { invoke_overload<Handler>(c, m); }
+  constexpr static void text(Context &c, flex_data::text_common const &m) { invoke_overload<Handler>(c, m); }
+};
+// clang-format on
+
+static_assert(flex_data<flex_data_overload<int, overloaded<>>, int>,
+              "flex_data_overload must implement the flex_data concept");
+
+/// \brief Satisfied if \p Handler accepts at least one of \p Messages, either singly or as a span.
+template <typename Handler, typename Context, typename... Messages>
+concept accepts_any = (... || (std::is_invocable_v<Handler, Context &, Messages const &> ||
+                               std::is_invocable_v<Handler, Context &, std::span<Messages const>>));
+
+// The *_overload_or_null aliases choose the *_overload backend for a category if the overload set accepts any of
+// its message types and the *_null backend otherwise. The dispatcher skips the categories with null backends
+// entirely.
+// clang-format off
+template <typename Context, overload_handler Handler>
+using utility_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, utility::noop, utility::jr_clock, utility::jr_timestamp, utility::delta_clockstamp_tpqn,
+              utility::delta_clockstamp, std::span<std::uint32_t>>,
+  utility_overload<Context, Handler>, utility_null<Context>>;
+template <typename Context, overload_handler Handler>
+using system_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, system::midi_time_code, system::song_position_pointer, system::song_select,
+              system::tune_request, system::timing_clock, system::sequence_start, system::sequence_continue,
+              system::sequence_stop, system::active_sensing, system::reset>,
+  system_overload<Context, Handler>, system_null<Context>>;
+template <typename Context, overload_handler Handler>
+using m1cvm_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, m1cvm::note_off, m1cvm::note_on, m1cvm::poly_pressure, m1cvm::control_change,
+              m1cvm::program_change, m1cvm::channel_pressure, m1cvm::pitch_bend>,
+  m1cvm_overload<Context, Handler>, m1cvm_null<Context>>;
+template <typename Context, overload_handler Handler>
+using data64_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, data64::sysex7_in_1, data64::sysex7_start, data64::sysex7_continue, data64::sysex7_end>,
+  data64_overload<Context, Handler>, data64_null<Context>>;
+template <typename Context, overload_handler Handler>
+using m2cvm_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, m2cvm::note_off, m2cvm::note_on, m2cvm::poly_pressure, m2cvm::program_change,
+              m2cvm::channel_pressure, m2cvm::rpn_per_note_controller, m2cvm::nrpn_per_note_controller,
+              m2cvm::rpn_controller, m2cvm::nrpn_controller, m2cvm::rpn_relative_controller,
+              m2cvm::nrpn_relative_controller, m2cvm::per_note_management, m2cvm::control_change, m2cvm::pitch_bend,
+              m2cvm::per_note_pitch_bend>,
+  m2cvm_overload<Context, Handler>, m2cvm_null<Context>>;
+template <typename Context, overload_handler Handler>
+using data128_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, data128::sysex8_in_1, data128::sysex8_start, data128::sysex8_continue,
+              data128::sysex8_end, data128::mds_header, data128::mds_payload>,
+  data128_overload<Context, Handler>, data128_null<Context>>;
+template <typename Context, overload_handler Handler>
+using stream_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, stream::endpoint_discovery, stream::endpoint_info_notification,
+              stream::device_identity_notification, stream::endpoint_name_notification,
+              stream::product_instance_id_notification, stream::jr_configuration_request,
+              stream::jr_configuration_notification, stream::function_block_discovery,
+              stream::function_block_info_notification, stream::function_block_name_notification,
+              stream::start_of_clip, stream::end_of_clip>,
+  stream_overload<Context, Handler>, stream_null<Context>>;
+template <typename Context, overload_handler Handler>
+using flex_data_overload_or_null = std::conditional_t<
+  accepts_any<Handler, Context, flex_data::set_tempo, flex_data::set_time_signature, flex_data::set_metronome,
+              flex_data::set_key_signature, flex_data::set_chord_name, flex_data::text_common>,
+  flex_data_overload<Context, Handler>, flex_data_null<Context>>;
+// clang-format on
+
 }  // end namespace midi2::ump::dispatcher_backend
 
 #endif  // MIDI2_UMP_DISPATCHER_BACKEND_HPP
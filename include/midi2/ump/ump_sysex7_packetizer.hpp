@@ -0,0 +1,137 @@
+//===-- UMP Sysex7 Packetizer -------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ump_sysex7_packetizer.hpp
+/// \brief Converts the bytes of a 7-bit system exclusive message directly to data64 sysex7 UMP packets.
+
+#ifndef MIDI2_UMP_SYSEX7_PACKETIZER_HPP
+#define MIDI2_UMP_SYSEX7_PACKETIZER_HPP
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include "midi2/ump/ump_types.hpp"
+
+namespace midi2::ump {
+
+/// \brief Packs the bytes of a 7-bit system exclusive message into data64 sysex7_in_1, sysex7_start,
+///   sysex7_continue, and sysex7_end UMP packets.
+///
+/// The message body is written either with push() or through the output iterator returned by inserter() so that
+/// functions such as ci::create_message() can write to it directly. Each packet is emitted as soon as it is known
+/// to be complete. Because the final packet of a message has a different status from its predecessors, the most
+/// recent six bytes are held back until either another byte arrives or flush() is called to end the message.
+///
+/// The bytes written must be the body of the message excluding the 0xF0 and 0xF7 delimiters.
+///
+/// \tparam OutputIterator  An output iterator to which the 32-bit words of each UMP packet are written.
+template <std::output_iterator<std::uint32_t> OutputIterator> class sysex7_packetizer {
+public:
+  /// An output iterator which passes each byte assigned to it to the packetizer's push() member function.
+  class iterator {
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    constexpr iterator() noexcept = default;
+    constexpr explicit iterator(sysex7_packetizer *const packetizer) noexcept : packetizer_{packetizer} {}
+
+    constexpr iterator &operator=(std::byte const b) {
+      assert(packetizer_ != nullptr);
+      packetizer_->push(b);
+      return *this;
+    }
+    constexpr iterator &operator*() noexcept { return *this; }
+    constexpr iterator &operator++() noexcept { return *this; }
+    constexpr iterator operator++(int) noexcept { return *this; }
+
+  private:
+    sysex7_packetizer *packetizer_ = nullptr;
+  };
+
+  /// \param out  The output iterator to which UMP words are written.
+  /// \param group  The UMP group of the packets.
+  constexpr explicit sysex7_packetizer(OutputIterator out, std::uint8_t const group = 0)
+      : out_{std::move(out)}, group_{group} {
+    assert(group < 16U);
+  }
+
+  /// \returns An output iterator which appends bytes to the message.
+  [[nodiscard]] constexpr iterator inserter() noexcept { return iterator{this}; }
+
+  /// \brief Appends a byte to the message. Complete packets are written to the output iterator.
+  /// \param b  The byte to be appended. Must be a 7-bit value.
+  constexpr void push(std::byte const b) {
+    assert(std::to_integer<std::uint8_t>(b) < 0x80U && "sysex7 data bytes must be 7 bit values");
+    if (pos_ == bytes_.size()) {
+      // There is more to come so the packet we're holding is not the last.
+      if (started_) {
+        this->emit<mt::data64::sysex7_continue>();
+      } else {
+        this->emit<mt::data64::sysex7_start>();
+      }
+      started_ = true;
+      pos_ = 0;
+    }
+    bytes_[pos_] = std::to_integer<std::uint8_t>(b);
+    ++pos_;
+  }
+
+  /// \brief Ends the message by writing its final packet. This will be a sysex7_end packet or, if the message
+  ///   fitted in a single packet, a sysex7_in_1 packet. (As with bytestream::to_ump, an empty message produces a
+  ///   sysex7_in_1 packet with no data.) The packetizer is then ready to accept another message.
+  /// \returns The output iterator.
+  constexpr OutputIterator flush() {
+    if (started_) {
+      this->emit<mt::data64::sysex7_end>();
+    } else {
+      this->emit<mt::data64::sysex7_in_1>();
+    }
+    started_ = false;
+    pos_ = 0;
+    return out_;
+  }
+
+private:
+  template <mt::data64 Status> constexpr void emit() {
+    auto const data = [this](std::size_t const index) { return index < pos_ ? bytes_[index] : std::uint8_t{0}; };
+    auto const packet = data64::details::sysex7<Status>{}
+                            .group(group_)
+                            .number_of_bytes(pos_)
+                            .data0(data(0U))
+                            .data1(data(1U))
+                            .data2(data(2U))
+                            .data3(data(3U))
+                            .data4(data(4U))
+                            .data5(data(5U));
+    apply(packet, [this](auto const w) {
+      *out_ = static_cast<std::uint32_t>(w);
+      ++out_;
+      return false;
+    });
+  }
+
+  OutputIterator out_;
+  std::array<std::uint8_t, 6> bytes_{};
+  std::uint8_t pos_ = 0;
+  std::uint8_t group_;
+  bool started_ = false;
+};
+
+}  // end namespace midi2::ump
+
+#endif  // MIDI2_UMP_SYSEX7_PACKETIZER_HPP
@@ -0,0 +1,264 @@
+//===-- UMP System Exclusive Reassembler --------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+/// \file ump_sysex_reassembler.hpp
+/// \brief UMP dispatcher backends which reassemble multi-packet system exclusive messages into contiguous
+///   buffers.
+
+#ifndef MIDI2_UMP_SYSEX_REASSEMBLER_HPP
+#define MIDI2_UMP_SYSEX_REASSEMBLER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+
+#include "midi2/adt/arena.hpp"
+#include "midi2/ump/ump_dispatcher_backend.hpp"
+#include "midi2/ump/ump_types.hpp"
+#include "midi2/utils.hpp"
+
+namespace midi2::ump::dispatcher_backend {
+
+namespace details {
+
+/// \brief Tracks up to \p Streams concurrent system exclusive messages whose payloads are accumulated in an
+///   adt::arena of \p ArenaSize bytes.
+///
+/// A message whose payload cannot be accommodated is discarded and counted as an overflow. Payloads never outgrow
+/// the arena, which is part of the backend object.
+///
+/// \tparam Streams  The number of independent streams.
+/// \tparam ArenaSize  The number of bytes available for the payloads of all in-progress messages.
+template <std::size_t Streams, std::size_t ArenaSize>
+  requires(Streams > 0 && ArenaSize > 0)
+class sysex_arena {
+public:
+  /// \brief Starts a new message on \p stream with an initial payload of \p bytes.
+  /// An unfinished message on the same stream is abandoned and counted as truncated.
+  void start(std::size_t const stream, std::span<std::byte const> const bytes) noexcept {
+    this->abandon(stream);
+    states_[stream] = state::active;
+    this->append(stream, bytes);
+  }
+  /// \brief Appends \p bytes to the message in progress on \p stream.
+  /// If there is no message in progress, the bytes are ignored and counted as a truncation.
+  void next(std::size_t const stream, std::span<std::byte const> const bytes) noexcept {
+    switch (states_[stream]) {
+    case state::idle: ++truncations_; break;
+    case state::discarding: break;
+    case state::active: this->append(stream, bytes); break;
+    }
+  }
+  /// \brief Appends \p bytes to the message in progress on \p stream and passes the complete payload to \p deliver.
+  /// The span passed to \p deliver is valid only for the duration of that call.
+  template <typename Function>
+  void end(std::size_t const stream, std::span<std::byte const> const bytes, Function&& deliver) {
+    switch (states_[stream]) {
+    case state::idle: ++truncations_; break;
+    case state::discarding: break;
+    case state::active:
+      if (this->append(stream, bytes)) {
+        std::invoke(std::forward<Function>(deliver), arena_.gather(stream));
+        arena_.clear(stream);
+      }
+      break;
+    }
+    states_[stream] = state::idle;
+  }
+  /// \brief Abandons any message in progress on \p stream. A message that was in progress is counted as truncated.
+  void abandon(std::size_t const stream) noexcept {
+    if (states_[stream] == state::active) {
+      ++truncations_;
+      arena_.clear(stream);
+    }
+    states_[stream] = state::idle;
+  }
+
+  /// \returns The number of messages that were discarded because the arena had insufficient space.
+  [[nodiscard]] constexpr std::size_t overflows() const noexcept { return overflows_; }
+  /// \returns The number of messages that were cut short or continued without having been started.
+  [[nodiscard]] constexpr std::size_t truncations() const noexcept { return truncations_; }
+
+private:
+  enum class state : std::uint8_t { idle, active, discarding };
+
+  /// \returns True if the bytes were appended, false if the message overflowed and was discarded.
+  bool append(std::size_t const stream, std::span<std::byte const> const bytes) noexcept {
+    assert(states_[stream] == state::active);
+    if (!arena_.append(stream, bytes)) {
+      ++overflows_;
+      arena_.clear(stream);
+      states_[stream] = state::discarding;
+      return false;
+    }
+    return true;
+  }
+
+  std::array<state, Streams> states_{};
+  std::size_t overflows_ = 0;
+  std::size_t truncations_ = 0;
+  /// Small blocks limit the space left unused at the end of each message in progress, which matters when there are
+  /// thousands of streams.
+  adt::arena<std::byte, Streams, ArenaSize, 16> arena_;
+};
+
+/// Copies the payload bytes of system exclusive packet \p sx to \p buffer.
+/// \returns The portion of \p buffer that was written.
+template <typename Sysex, std::size_t Size>
+constexpr std::span<std::byte const> payload(Sysex const& sx, std::array<std::byte, Size>& buffer) noexcept {
+  auto const n = std::min({sx.size(), sx.max_size(), Size});
+  for (auto ctr = std::size_t{0}; ctr < n; ++ctr) {
+    buffer[ctr] = static_cast<std::byte>(sx.data(ctr));
+  }
+  return std::span<std::byte const>{buffer}.first(n);
+}
+
+}  // end namespace details
+
+/// \brief A data64 backend which reassembles 7-bit system exclusive messages.
+///
+/// Messages are accumulated independently for each of the 16 groups in an arena of \p ArenaSize bytes and
+/// delivered as a single contiguous span once the sysex7_end (or sysex7_in_1) packet is received. The arena is
+/// shared by all groups and is part of the object, so no memory is allocated per message. Each message in progress
+/// holds a whole number of the arena's 16-byte blocks, so the cost of a packet does not depend on how the groups
+/// interleave.
+///
+/// A message whose payload does not fit in the remaining arena space is dropped and counted by overflows(). A
+/// message interrupted by a new start or complete packet on the same group, and continue or end packets that arrive
+/// without a preceding start, are counted by truncations().
+///
+/// \tparam Context  The dispatcher context type.
+/// \tparam ArenaSize  The number of bytes available for messages in progress.
+template <typename Context, std::size_t ArenaSize = 1024> class sysex7_reassembler {
+public:
+  /// The type of the function called with each complete message. The span is valid only for the duration of the
+  /// call.
+  using message_fn = std::function<void(Context, std::uint8_t group, std::span<std::byte const>)>;
+
+  // clang-format off
+  constexpr sysex7_reassembler &on_message(message_fn message) noexcept { message_ = std::move(message); return *this; }
+  // clang-format on
+
+  void sysex7_in_1(Context c, data64::sysex7_in_1 const &sx) {
+    auto const group = static_cast<std::uint8_t>(sx.group());
+    arena_.abandon(group);
+    std::array<std::byte, 6> buffer{};
+    call(message_, c, group, details::payload(sx, buffer));
+  }
+  void sysex7_start(Context, data64::sysex7_start const &sx) {
+    std::array<std::byte, 6> buffer{};
+    arena_.start(sx.group(), details::payload(sx, buffer));
+  }
+  void sysex7_continue(Context, data64::sysex7_continue const &sx) {
+    std::array<std::byte, 6> buffer{};
+    arena_.next(sx.group(), details::payload(sx, buffer));
+  }
+  void sysex7_end(Context c, data64::sysex7_end const &sx) {
+    auto const group = static_cast<std::uint8_t>(sx.group());
+    std::array<std::byte, 6> buffer{};
+    arena_.end(group, details::payload(sx, buffer),
+               [this, &c, group](std::span<std::byte const> message) { call(message_, c, group, message); });
+  }
+
+  /// \returns The number of messages that were discarded because the arena had insufficient space.
+  [[nodiscard]] constexpr std::size_t overflows() const noexcept { return arena_.overflows(); }
+  /// \returns The number of messages that were cut short or continued without having been started.
+  [[nodiscard]] constexpr std::size_t truncations() const noexcept { return arena_.truncations(); }
+
+private:
+  static constexpr auto groups_ = std::size_t{16};
+  details::sysex_arena<groups_, ArenaSize> arena_;
+  message_fn message_;
+};
+
+static_assert(data64<sysex7_reassembler<int>, int>, "sysex7_reassembler must implement the data64 concept");
+
+/// \brief A data128 backend which reassembles 8-bit system exclusive messages.
+///
+/// Messages are accumulated independently for each of the 256 stream IDs in each of the 16 groups. Their payloads
+/// share an arena of \p ArenaSize bytes which is part of the object, so no memory is allocated per message. Each
+/// message in progress holds at least one of the arena's 16-byte blocks. As with sysex7_reassembler, complete
+/// messages are delivered as a single contiguous span and messages that are lost are counted by overflows() and
+/// truncations(). Mixed data set packets are passed unchanged to the functions supplied to on_mds_header() and
+/// on_mds_payload().
+///
+/// \tparam Context  The dispatcher context type.
+/// \tparam ArenaSize  The number of bytes available for messages in progress.
+template <typename Context, std::size_t ArenaSize = 4096> class sysex8_reassembler {
+public:
+  /// The type of the function called with each complete message. The span is valid only for the duration of the
+  /// call.
+  using message_fn =
+      std::function<void(Context, std::uint8_t group, std::uint8_t stream_id, std::span<std::byte const>)>;
+  using mds_header_fn = std::function<void(Context, data128::mds_header const &)>;
+  using mds_payload_fn = std::function<void(Context, data128::mds_payload const &)>;
+
+  // clang-format off
+  constexpr sysex8_reassembler &on_message(message_fn message) noexcept { message_ = std::move(message); return *this; }
+  constexpr sysex8_reassembler &on_mds_header(mds_header_fn mds_header) noexcept { mds_header_ = std::move(mds_header); return *this; }
+  constexpr sysex8_reassembler &on_mds_payload(mds_payload_fn mds_payload) noexcept { mds_payload_ = std::move(mds_payload); return *this; }
+  // clang-format on
+
+  void sysex8_in_1(Context c, data128::sysex8_in_1 const &sx) {
+    auto const group = static_cast<std::uint8_t>(sx.group());
+    auto const stream_id = static_cast<std::uint8_t>(sx.stream_id());
+    arena_.abandon(key(group, stream_id));
+    std::array<std::byte, 13> buffer{};
+    call(message_, c, group, stream_id, details::payload(sx, buffer));
+  }
+  void sysex8_start(Context, data128::sysex8_start const &sx) {
+    std::array<std::byte, 13> buffer{};
+    arena_.start(key(sx.group(), sx.stream_id()), details::payload(sx, buffer));
+  }
+  void sysex8_continue(Context, data128::sysex8_continue const &sx) {
+    std::array<std::byte, 13> buffer{};
+    arena_.next(key(sx.group(), sx.stream_id()), details::payload(sx, buffer));
+  }
+  void sysex8_end(Context c, data128::sysex8_end const &sx) {
+    auto const group = static_cast<std::uint8_t>(sx.group());
+    auto const stream_id = static_cast<std::uint8_t>(sx.stream_id());
+    std::array<std::byte, 13> buffer{};
+    arena_.end(key(group, stream_id), details::payload(sx, buffer),
+               [this, &c, group, stream_id](std::span<std::byte const> message) {
+                 call(message_, c, group, stream_id, message);
+               });
+  }
+  void mds_header(Context c, data128::mds_header const &mds) const { call(mds_header_, c, mds); }
+  void mds_payload(Context c, data128::mds_payload const &mds) const { call(mds_payload_, c, mds); }
+
+  /// \returns The number of messages that were discarded because the arena had insufficient space.
+  [[nodiscard]] constexpr std::size_t overflows() const noexcept { return arena_.overflows(); }
+  /// \returns The number of messages that were cut short or continued without having been started.
+  [[nodiscard]] constexpr std::size_t truncations() const noexcept { return arena_.truncations(); }
+
+private:
+  static constexpr auto groups_ = std::size_t{16};
+  static constexpr auto stream_ids_ = std::size_t{256};
+  [[nodiscard]] static constexpr std::size_t key(std::size_t const group, std::size_t const stream_id) noexcept {
+    assert(group < groups_ && stream_id < stream_ids_);
+    return group * stream_ids_ + stream_id;
+  }
+
+  details::sysex_arena<groups_ * stream_ids_, ArenaSize> arena_;
+  message_fn message_;
+  mds_header_fn mds_header_;
+  mds_payload_fn mds_payload_;
+};
+
+static_assert(data128<sysex8_reassembler<int>, int>, "sysex8_reassembler must implement the data128 concept");
+
+}  // end namespace midi2::ump::dispatcher_backend
+
+#endif  // MIDI2_UMP_SYSEX_REASSEMBLER_HPP
@@ -385,11 +385,11 @@ constexpr bool check(T const& message) {
 /// Defines a constructor for the class specified by the \p group and \p message parameters which takes a span of
 /// std::uint32_t with a size equal to the number of words in the message. The constructor initialises the message from
 /// the span and checks that the message type and status fields are correct.
-#define MIDI2_SPAN_CTOR(group, message)                                            \
-  constexpr ::midi2::ump::group::message::message(                                 \
-      ::std::span<::std::uint32_t, ::std::tuple_size_v<message>> const m) noexcept \
-      : words_{span_to_tuple(m)} {                                                 \
-    assert(get<0>(words_).check());                                                \
+#define MIDI2_SPAN_CTOR(group, message)                                                  \
+  constexpr ::midi2::ump::group::message::message(                                       \
+      ::std::span<::std::uint32_t const, ::std::tuple_size_v<message>> const m) noexcept \
+      : words_{span_to_tuple(m)} {                                                       \
+    assert(get<0>(words_).check());                                                      \
   }
 
 namespace midi2::ump {
@@ -506,7 +506,7 @@ public:
   constexpr jr_clock() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit jr_clock(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit jr_clock(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(jr_clock const&, jr_clock const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::utility.
@@ -571,7 +571,7 @@ public:
   constexpr jr_timestamp() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit jr_timestamp(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit jr_timestamp(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(jr_timestamp const&, jr_timestamp const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::utility.
@@ -636,7 +636,7 @@ public:
   constexpr delta_clockstamp_tpqn() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit delta_clockstamp_tpqn(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit delta_clockstamp_tpqn(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(delta_clockstamp_tpqn const&, delta_clockstamp_tpqn const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::utility.
@@ -700,7 +700,7 @@ public:
   constexpr delta_clockstamp() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit delta_clockstamp(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit delta_clockstamp(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(delta_clockstamp const&, delta_clockstamp const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::utility.
@@ -797,7 +797,7 @@ public:
   constexpr midi_time_code() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit midi_time_code(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit midi_time_code(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(midi_time_code const&, midi_time_code const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -861,7 +861,7 @@ public:
   constexpr song_position_pointer() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit song_position_pointer(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit song_position_pointer(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(song_position_pointer const&, song_position_pointer const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -928,7 +928,7 @@ public:
   constexpr song_select() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit song_select(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit song_select(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(song_select const&, song_select const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -988,7 +988,7 @@ public:
   constexpr tune_request() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit tune_request(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit tune_request(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(tune_request const&, tune_request const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1047,7 +1047,7 @@ public:
   constexpr timing_clock() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit timing_clock(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit timing_clock(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(timing_clock const&, timing_clock const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1106,7 +1106,7 @@ public:
   constexpr sequence_start() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit sequence_start(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit sequence_start(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(sequence_start const&, sequence_start const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1165,7 +1165,7 @@ public:
   constexpr sequence_continue() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit sequence_continue(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit sequence_continue(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(sequence_continue const&, sequence_continue const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1223,7 +1223,7 @@ public:
   constexpr sequence_stop() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit sequence_stop(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit sequence_stop(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(sequence_stop const&, sequence_stop const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1281,7 +1281,7 @@ public:
   constexpr active_sensing() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit active_sensing(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit active_sensing(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(active_sensing const&, active_sensing const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1339,7 +1339,7 @@ public:
   constexpr reset() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit reset(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit reset(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(reset const&, reset const&) noexcept = default;
 
   /// \brief Returns the value of the word0::mt field. Always message_type::system.
@@ -1439,7 +1439,7 @@ public:
   constexpr note_on() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit note_on(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit note_on(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(note_on const&, note_on const&) noexcept = default;
 
   /// \brief Returns the value of the word0::status field. Always message_type::m1cvm.
@@ -1505,7 +1505,7 @@ public:
   constexpr note_off() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit note_off(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit note_off(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(note_off const&, note_off const&) noexcept = default;
 
   /// \brief Returns the value of the word0::status field. Always message_type::m1cvm.
@@ -1570,7 +1570,7 @@ public:
   constexpr poly_pressure() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit poly_pressure(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit poly_pressure(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(poly_pressure const&, poly_pressure const&) noexcept = default;
 
   /// \fn constexpr auto midi2::ump::m1cvm::poly_pressure::mt() const noexcept
@@ -1637,7 +1637,7 @@ public:
   constexpr control_change() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit control_change(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit control_change(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(control_change const&, control_change const&) noexcept = default;
 
   /// \fn constexpr auto midi2::ump::m1cvm::control_change::mt() const noexcept
@@ -1705,7 +1705,7 @@ public:
   constexpr program_change() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit program_change(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit program_change(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(program_change const&, program_change const&) noexcept = default;
 
   /// \fn constexpr auto midi2::ump::m1cvm::program_change::mt() const noexcept
@@ -1780,7 +1780,7 @@ public:
   constexpr channel_pressure() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit channel_pressure(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit channel_pressure(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(channel_pressure const&, channel_pressure const&) noexcept = default;
 
   /// \brief Returns the value of the word0::status field. Always message_type::m1cvm.
@@ -1840,7 +1840,7 @@ public:
   constexpr pitch_bend() noexcept = default;
   /// Constructs from a raw 32-bit message.
   /// In a debug build, checks that the class invariants hold.
-  constexpr explicit pitch_bend(std::span<std::uint32_t, 1> m) noexcept;
+  constexpr explicit pitch_bend(std::span<std::uint32_t const, 1> m) noexcept;
   friend constexpr bool operator==(pitch_bend const&, pitch_bend const&) noexcept = default;
 
   /// \fn constexpr auto midi2::ump::m1cvm::pitch_bend::mt() const noexcept
@@ -1941,7 +1941,7 @@ public:
   };
 
   constexpr sysex7() noexcept = default;
-  constexpr explicit sysex7(std::span<std::uint32_t, 2> const m) noexcept : words_{span_to_tuple(m)} {
+  constexpr explicit sysex7(std::span<std::uint32_t const, 2> const m) noexcept : words_{span_to_tuple(m)} {
     assert(get<0>(words_).check());
   }
   friend constexpr bool operator==(sysex7 const&, sysex7 const&) noexcept = default;
@@ -2176,7 +2176,7 @@ public:
   };
 
   constexpr note_off() noexcept = default;
-  constexpr explicit note_off(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit note_off(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(note_off const& a, note_off const& b) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2233,7 +2233,7 @@ public:
   };
 
   constexpr note_on() noexcept = default;
-  constexpr explicit note_on(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit note_on(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(note_on const& a, note_on const& b) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2290,7 +2290,7 @@ public:
   };
 
   constexpr poly_pressure() noexcept = default;
-  constexpr explicit poly_pressure(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit poly_pressure(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(poly_pressure const& a, poly_pressure const& b) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2345,7 +2345,7 @@ public:
   };
 
   constexpr rpn_per_note_controller() noexcept = default;
-  constexpr explicit rpn_per_note_controller(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit rpn_per_note_controller(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(rpn_per_note_controller const&, rpn_per_note_controller const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2403,7 +2403,7 @@ public:
   };
 
   constexpr nrpn_per_note_controller() noexcept = default;
-  constexpr explicit nrpn_per_note_controller(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit nrpn_per_note_controller(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(nrpn_per_note_controller const&, nrpn_per_note_controller const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2466,7 +2466,7 @@ public:
   };
 
   constexpr rpn_controller() noexcept = default;
-  constexpr explicit rpn_controller(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit rpn_controller(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(rpn_controller const&, rpn_controller const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2523,7 +2523,7 @@ public:
   };
 
   constexpr nrpn_controller() noexcept = default;
-  constexpr explicit nrpn_controller(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit nrpn_controller(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(nrpn_controller const&, nrpn_controller const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2580,7 +2580,7 @@ public:
   };
 
   constexpr rpn_relative_controller() noexcept = default;
-  constexpr explicit rpn_relative_controller(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit rpn_relative_controller(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(rpn_relative_controller const&, rpn_relative_controller const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2638,7 +2638,7 @@ public:
   };
 
   constexpr nrpn_relative_controller() noexcept = default;
-  constexpr explicit nrpn_relative_controller(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit nrpn_relative_controller(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(nrpn_relative_controller const&, nrpn_relative_controller const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2699,7 +2699,7 @@ public:
   };
 
   constexpr per_note_management() noexcept = default;
-  constexpr explicit per_note_management(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit per_note_management(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(per_note_management const&, per_note_management const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2758,7 +2758,7 @@ public:
   };
 
   constexpr control_change() noexcept = default;
-  constexpr explicit control_change(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit control_change(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(control_change const&, control_change const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2821,7 +2821,7 @@ public:
   };
 
   constexpr program_change() noexcept = default;
-  constexpr explicit program_change(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit program_change(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(program_change const&, program_change const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2878,7 +2878,7 @@ public:
   };
 
   constexpr channel_pressure() noexcept = default;
-  constexpr explicit channel_pressure(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit channel_pressure(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(channel_pressure const&, channel_pressure const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2931,7 +2931,7 @@ public:
   };
 
   constexpr pitch_bend() noexcept = default;
-  constexpr explicit pitch_bend(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit pitch_bend(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(pitch_bend const& a, pitch_bend const& b) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -2985,7 +2985,7 @@ public:
   };
 
   constexpr per_note_pitch_bend() noexcept = default;
-  constexpr explicit per_note_pitch_bend(std::span<std::uint32_t, 2> m) noexcept;
+  constexpr explicit per_note_pitch_bend(std::span<std::uint32_t const, 2> m) noexcept;
   friend constexpr bool operator==(per_note_pitch_bend const&, per_note_pitch_bend const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -3085,7 +3085,7 @@ public:
   };
 
   constexpr endpoint_discovery() noexcept = default;
-  constexpr explicit endpoint_discovery(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit endpoint_discovery(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(endpoint_discovery const&, endpoint_discovery const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -3160,7 +3160,7 @@ public:
   };
 
   constexpr endpoint_info_notification() noexcept = default;
-  constexpr explicit endpoint_info_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit endpoint_info_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(endpoint_info_notification const&,
                                    endpoint_info_notification const&) noexcept = default;
 
@@ -3258,7 +3258,7 @@ public:
   };
 
   constexpr device_identity_notification() noexcept = default;
-  constexpr explicit device_identity_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit device_identity_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(device_identity_notification const&,
                                    device_identity_notification const&) noexcept = default;
 
@@ -3347,7 +3347,7 @@ public:
   };
 
   constexpr endpoint_name_notification() noexcept = default;
-  constexpr explicit endpoint_name_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit endpoint_name_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(endpoint_name_notification const&,
                                    endpoint_name_notification const&) noexcept = default;
 
@@ -3439,7 +3439,7 @@ public:
   };
 
   constexpr product_instance_id_notification() noexcept = default;
-  constexpr explicit product_instance_id_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit product_instance_id_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(product_instance_id_notification const&,
                                    product_instance_id_notification const&) noexcept = default;
 
@@ -3518,7 +3518,7 @@ public:
   };
 
   constexpr jr_configuration_request() noexcept = default;
-  constexpr explicit jr_configuration_request(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit jr_configuration_request(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(jr_configuration_request const&, jr_configuration_request const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -3586,7 +3586,7 @@ public:
   };
 
   constexpr jr_configuration_notification() noexcept = default;
-  constexpr explicit jr_configuration_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit jr_configuration_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(jr_configuration_notification const&,
                                    jr_configuration_notification const&) noexcept = default;
 
@@ -3653,7 +3653,7 @@ public:
   };
 
   constexpr function_block_discovery() noexcept = default;
-  constexpr explicit function_block_discovery(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit function_block_discovery(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(function_block_discovery const&, function_block_discovery const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -3725,7 +3725,7 @@ public:
   };
 
   constexpr function_block_info_notification() noexcept = default;
-  constexpr explicit function_block_info_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit function_block_info_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(function_block_info_notification const&,
                                    function_block_info_notification const&) noexcept = default;
 
@@ -3809,7 +3809,7 @@ public:
   };
 
   constexpr function_block_name_notification() noexcept = default;
-  constexpr explicit function_block_name_notification(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit function_block_name_notification(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(function_block_name_notification const&,
                                    function_block_name_notification const&) noexcept = default;
 
@@ -3883,7 +3883,7 @@ public:
   };
 
   constexpr start_of_clip() noexcept = default;
-  constexpr explicit start_of_clip(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit start_of_clip(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(start_of_clip const&, start_of_clip const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -3943,7 +3943,7 @@ public:
   };
 
   constexpr end_of_clip() noexcept = default;
-  constexpr explicit end_of_clip(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit end_of_clip(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(end_of_clip const&, end_of_clip const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -4036,7 +4036,7 @@ public:
   };
 
   constexpr set_tempo() noexcept = default;
-  constexpr explicit set_tempo(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit set_tempo(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(set_tempo const&, set_tempo const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -4107,7 +4107,7 @@ public:
   };
 
   constexpr set_time_signature() noexcept = default;
-  constexpr explicit set_time_signature(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit set_time_signature(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(set_time_signature const&, set_time_signature const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -4182,7 +4182,7 @@ public:
   };
 
   constexpr set_metronome() noexcept = default;
-  constexpr explicit set_metronome(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit set_metronome(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(set_metronome const&, set_metronome const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -4366,7 +4366,7 @@ public:
   };
 
   constexpr set_key_signature() noexcept = default;
-  constexpr explicit set_key_signature(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit set_key_signature(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(set_key_signature const&, set_key_signature const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -4498,7 +4498,7 @@ public:
   /// Defaults constructs a set_chord_name message with all fields set to zero.
   constexpr set_chord_name() noexcept = default;
   /// Constructs a set_chord_name message from a raw span of four uint32_t words.
-  constexpr explicit set_chord_name(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit set_chord_name(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(set_chord_name const&, set_chord_name const&) noexcept = default;
 
   /// \fn midi2::ump::flex_data::set_chord_name::mt
@@ -4810,7 +4810,7 @@ public:
   };
 
   constexpr text_common() noexcept = default;
-  constexpr explicit text_common(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit text_common(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(text_common const&, text_common const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -5056,7 +5056,7 @@ public:
   };
 
   constexpr sysex8() noexcept = default;
-  constexpr explicit sysex8(std::span<std::uint32_t, 4> const m) noexcept : words_{span_to_tuple(m)} {
+  constexpr explicit sysex8(std::span<std::uint32_t const, 4> const m) noexcept : words_{span_to_tuple(m)} {
     assert(get<0>(words_).check());
   }
   friend constexpr bool operator==(sysex8 const&, sysex8 const&) noexcept = default;
@@ -5276,7 +5276,7 @@ public:
   };
 
   constexpr mds_header() noexcept = default;
-  constexpr explicit mds_header(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit mds_header(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(mds_header const&, mds_header const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -5351,7 +5351,7 @@ public:
   };
 
   constexpr mds_payload() noexcept = default;
-  constexpr explicit mds_payload(std::span<std::uint32_t, 4> m) noexcept;
+  constexpr explicit mds_payload(std::span<std::uint32_t const, 4> m) noexcept;
   friend constexpr bool operator==(mds_payload const&, mds_payload const&) noexcept = default;
 
   MIDI2_UMP_GETTER(word0, mt)
@@ -84,6 +84,15 @@ inline void call(Function&& function, Args&&... args) {
   }
 }
 
+/// \brief Combines a number of callables (typically lambdas) into a single overload set.
+///
+/// \code
+/// auto const f = midi2::overloaded{[](int) { return 1; }, [](float) { return 2; }};
+/// \endcode
+template <typename... Ts> struct overloaded : Ts... {
+  using Ts::operator()...;
+};
+
 /// \brief Returns the low 7 bits (that is, the bits in the interval [0..7] of the unsigned integral argument \p v.
 /// \param v  A value from which the low 7 bits will be extracted.
 /// \returns The low 7 bits of the unsigned integral argument \p v.
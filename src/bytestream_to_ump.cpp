@@ -10,12 +10,18 @@
 
 #include "midi2/bytestream/bytestream_to_ump.hpp"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <span>
 #include <utility>
 
 #include "midi2/bytestream/bytestream_types.hpp"
+#include "midi2/simd.hpp"
+#include "midi2/translator.hpp"
 #include "midi2/ump/ump_types.hpp"
 #include "midi2/utils.hpp"
 
@@ -32,6 +38,62 @@ namespace {
          value == std::to_underlying(timing_code) || value == std::to_underlying(song_select);
 }
 
+/// \brief Returns the number of data bytes (those with the top bit clear) at the start of a span.
+/// \param bytes The bytes to be searched.
+/// \returns The index of the first status byte in \p bytes or its size if there is none.
+[[nodiscard]] std::size_t data_run(std::span<std::byte const> const bytes) noexcept {
+  auto const* const first = bytes.data();
+  auto const size = bytes.size();
+  auto index = std::size_t{0};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  if constexpr (midi2::details::simd_avx2) {
+    for (; size - index >= 32U; index += 32U) {
+      // The movemask instruction gathers the top bit of each byte: exactly the bit that marks a status byte.
+      auto const v = _mm256_loadu_si256(std::bit_cast<__m256i const*>(first + index));
+      if (auto const mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); mask != 0U) {
+        return index + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+    }
+  }
+  if constexpr (midi2::details::simd_sse2) {
+    for (; size - index >= 16U; index += 16U) {
+      auto const v = _mm_loadu_si128(std::bit_cast<__m128i const*>(first + index));
+      if (auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(v)); mask != 0U) {
+        return index + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+    }
+  }
+#elif defined(__ARM_NEON) && __ARM_NEON
+  for (; size - index >= 16U; index += 16U) {
+    // An arithmetic shift turns each status byte into 0xFF and each data byte into 0. Narrowing each 16-bit lane
+    // with a shift by 4 then leaves a 64-bit value with a nibble per input byte.
+    auto const v = vshrq_n_s8(vld1q_s8(std::bit_cast<std::int8_t const*>(first + index)), 7);
+    auto const narrow = vshrn_n_u16(vreinterpretq_u16_s8(v), 4);
+    if (auto const mask = vget_lane_u64(vreinterpret_u64_u8(narrow), 0); mask != 0U) {
+      return index + static_cast<std::size_t>(std::countr_zero(mask)) / 4U;
+    }
+  }
+#endif
+  // Test the remaining bytes eight at a time.
+  for (; size - index >= 8U; index += 8U) {
+    std::uint64_t v = 0;
+    std::memcpy(&v, first + index, sizeof(v));
+    if (auto const mask = v & std::uint64_t{0x8080808080808080}; mask != 0U) {
+      if constexpr (std::endian::native == std::endian::little) {
+        return index + static_cast<std::size_t>(std::countr_zero(mask)) / 8U;
+      } else {
+        return index + static_cast<std::size_t>(std::countl_zero(mask)) / 8U;
+      }
+    }
+  }
+  for (; index < size; ++index) {
+    if (midi2::bytestream::is_status_byte(first[index])) {
+      break;
+    }
+  }
+  return index;
+}
+
 }  // end anonymous namespace
 
 namespace midi2::bytestream {
@@ -42,7 +104,7 @@ void to_ump::set_group(std::uint8_t const group) noexcept {
   group_ = static_cast<std::byte>(group);
 }
 
-void to_ump::convert(std::byte b0, std::byte b1, std::byte b2) noexcept {
+auto to_ump::message(std::byte b0, std::byte b1, std::byte b2) const noexcept -> output_type {
   assert((b0 & std::byte{0x80}) != std::byte{0U} && "Top bit of b0 must be set");
   assert((b1 & std::byte{0x80}) == std::byte{0U} && (b2 & std::byte{0x80U}) == std::byte{0U} &&
          "The top bit of b1 and b2 must be zero");
@@ -51,9 +113,13 @@ void to_ump::convert(std::byte b0, std::byte b1, std::byte b2) noexcept {
 
   auto const mt = to_underlying(b0) >= std::to_underlying(status::sysex_start) ? ump::message_type::system
                                                                                : ump::message_type::m1cvm;
-  output_.push_back((static_cast<std::uint32_t>(std::to_underlying(mt)) << 28) |
-                    (std::to_integer<std::uint32_t>(group_) << 24) | (std::to_integer<std::uint32_t>(b0) << 16) |
-                    (std::to_integer<std::uint32_t>(b1) << 8) | std::to_integer<std::uint32_t>(b2));
+  return (static_cast<std::uint32_t>(std::to_underlying(mt)) << 28) | (std::to_integer<std::uint32_t>(group_) << 24) |
+         (std::to_integer<std::uint32_t>(b0) << 16) | (std::to_integer<std::uint32_t>(b1) << 8) |
+         std::to_integer<std::uint32_t>(b2);
+}
+
+void to_ump::convert(std::byte b0, std::byte b1, std::byte b2) noexcept {
+  output_.push_back(this->message(b0, b1, b2));
 }
 
 using sysex7_in_1 = midi2::ump::data64::details::sysex7<midi2::ump::mt::data64::sysex7_in_1>;
@@ -61,21 +127,29 @@ using sysex7_start = midi2::ump::data64::details::sysex7<midi2::ump::mt::data64:
 using sysex7_continue = midi2::ump::data64::details::sysex7<midi2::ump::mt::data64::sysex7_continue>;
 using sysex7_end = midi2::ump::data64::details::sysex7<midi2::ump::mt::data64::sysex7_end>;
 
-template <ump::mt::data64 T> void to_ump::push_sysex7() noexcept {
+/// Builds a sysex7 UMP of type \p T from the bytes gathered in sysex7_ and passes each of its words to \p function.
+template <ump::mt::data64 T, typename Function> void to_ump::sysex7_words(Function function) const noexcept {
+  // Bytes beyond pos are left over from an earlier UMP and must be sent as zero.
+  auto const data = [this](std::size_t const index) {
+    return index < sysex7_.pos ? to_integer<std::uint8_t>(sysex7_.bytes[index]) : std::uint8_t{0};
+  };
   auto const t = ump::data64::details::sysex7<T>{}
                      .group(to_integer<std::uint8_t>(group_))
                      .number_of_bytes(sysex7_.pos)
-                     .data0(to_integer<std::uint8_t>(sysex7_.bytes[0U]))
-                     .data1(to_integer<std::uint8_t>(sysex7_.bytes[1U]))
-                     .data2(to_integer<std::uint8_t>(sysex7_.bytes[2U]))
-                     .data3(to_integer<std::uint8_t>(sysex7_.bytes[3U]))
-                     .data4(to_integer<std::uint8_t>(sysex7_.bytes[4U]))
-                     .data5(to_integer<std::uint8_t>(sysex7_.bytes[5U]));
-  ump::apply(t, [this](auto const w) noexcept {
-    output_.push_back(static_cast<std::uint32_t>(w));
+                     .data0(data(0U))
+                     .data1(data(1U))
+                     .data2(data(2U))
+                     .data3(data(3U))
+                     .data4(data(4U))
+                     .data5(data(5U));
+  ump::apply(t, [&function](auto const w) noexcept {
+    function(static_cast<std::uint32_t>(w));
     return false;
   });
+}
 
+template <ump::mt::data64 T> void to_ump::push_sysex7() noexcept {
+  this->sysex7_words<T>([this](std::uint32_t const w) { output_.push_back(w); });
   sysex7_.reset();
 }
 
@@ -87,7 +161,6 @@ void to_ump::sysex_data_byte(std::byte const b) noexcept {
     case cont: push_sysex7<ump::mt::data64::sysex7_continue>(); break;
     default: assert(false); break;
     }
-    sysex7_.reset();
     sysex7_.state = sysex7::status::cont;
     sysex7_.pos = 0U;
   }
@@ -141,6 +214,87 @@ void to_ump::push(std::byte const b) noexcept {
   }
 }
 
+translate_result<std::span<to_ump::output_type>::iterator> to_ump::translate_data(
+    std::span<input_type const> const data, std::span<output_type> const output) noexcept {
+  assert(output_.empty());
+  auto in = std::begin(data);
+  auto const in_end = std::end(data);
+  auto out = std::begin(output);
+  auto const out_end = std::end(output);
+  auto const consumed = [&]() {
+    return translate_result<std::span<output_type>::iterator>{
+        .consumed = static_cast<std::size_t>(in - std::begin(data)),
+        .produced = static_cast<std::size_t>(out - std::begin(output)),
+        .out = out};
+  };
+
+  if (sysex7_.state == sysex7::status::start || sysex7_.state == sysex7::status::cont) {
+    // Fill the current UMP. This never produces output because a full UMP is only sent when the following byte
+    // shows whether it is a "continue" or an "end" message.
+    for (; sysex7_.pos < sysex7_.bytes.size() && in != in_end; ++in) {
+      this->sysex_data_byte(*in);
+    }
+    // While there are at least six more data bytes, the full UMP that we're holding can be sent and its bytes
+    // replaced in a single step.
+    for (; in_end - in >= 6 && out_end - out >= 2; in += 6) {
+      assert(sysex7_.pos == sysex7_.bytes.size());
+      if (sysex7_.state == sysex7::status::start) {
+        this->sysex7_words<ump::mt::data64::sysex7_start>([&out](std::uint32_t const w) { *(out++) = w; });
+      } else {
+        this->sysex7_words<ump::mt::data64::sysex7_continue>([&out](std::uint32_t const w) { *(out++) = w; });
+      }
+      std::copy_n(in, sysex7_.bytes.size(), std::begin(sysex7_.bytes));
+      sysex7_.state = sysex7::status::cont;
+    }
+    return consumed();
+  }
+  if (d0_ == std::byte{0U} || d1_ != unknown) {
+    return consumed();
+  }
+  // Running status: the data bytes repeat the message given by the most recent status byte.
+  if (is_one_byte_message(d0_)) {
+    for (; in != in_end && out != out_end; ++in, ++out) {
+      *out = this->message(d0_, *in, std::byte{0U});
+    }
+  } else if (d0_ < to_byte(status::sysex_start) || d0_ == to_byte(status::spp)) {
+    for (; in_end - in >= 2 && out != out_end; in += 2, ++out) {
+      *out = this->message(d0_, *in, *(in + 1));
+    }
+  }
+  return consumed();
+}
+
+translate_result<std::span<to_ump::output_type>::iterator> to_ump::translate(std::span<input_type const> const input,
+                                                                          std::span<output_type> const output) noexcept {
+  auto in = std::begin(input);
+  auto const in_end = std::end(input);
+  auto out = std::begin(output);
+  auto const out_end = std::end(output);
+  for (;;) {
+    for (; !this->empty() && out != out_end; ++out) {
+      *out = this->pop();
+    }
+    if (in == in_end || out == out_end || !this->empty()) {
+      break;
+    }
+    // Runs of data bytes (sysex payloads and running status) are translated in bulk. Anything else, including a
+    // partial message left at the end of a run, goes through push().
+    if (!is_status_byte(*in)) {
+      auto const r = this->translate_data(std::span{in, data_run(std::span{in, in_end})}, std::span{out, out_end});
+      if (r.consumed > 0U) {
+        in += static_cast<std::ptrdiff_t>(r.consumed);
+        out = r.out;
+        continue;
+      }
+    }
+    this->push(*in);
+    ++in;
+  }
+  return {.consumed = static_cast<std::size_t>(in - std::begin(input)),
+          .produced = static_cast<std::size_t>(out - std::begin(output)),
+          .out = out};
+}
+
 void to_ump::reset() noexcept {
   group_ = std::byte{0U};
   d0_ = std::byte{0U};
@@ -0,0 +1,68 @@
+//===-- CI Text Codec ---------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+#include "midi2/ci/ci7text.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "midi2/simd.hpp"
+
+namespace midi2::ci::details {
+
+std::size_t plain_ascii_bytes(std::span<std::byte const> const str) noexcept {
+  auto const* const first = str.data();
+  auto const size = str.size();
+  auto index = std::size_t{0};
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  if constexpr (midi2::details::simd_avx2) {
+    for (auto const backslash = _mm256_set1_epi8('\\'); size - index >= 32U; index += 32U) {
+      auto const v = _mm256_loadu_si256(std::bit_cast<__m256i const*>(first + index));
+      // The movemask gathers the top bit of each byte. Or'ing with the backslash comparison gives the set of bytes
+      // which end the run.
+      auto const stop = _mm256_or_si256(v, _mm256_cmpeq_epi8(v, backslash));
+      auto const mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(stop));
+      if (mask != 0U) {
+        return index + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+    }
+  }
+  if constexpr (midi2::details::simd_sse2) {
+    for (auto const backslash = _mm_set1_epi8('\\'); size - index >= 16U; index += 16U) {
+      auto const v = _mm_loadu_si128(std::bit_cast<__m128i const*>(first + index));
+      auto const stop = _mm_or_si128(v, _mm_cmpeq_epi8(v, backslash));
+      auto const mask = static_cast<std::uint32_t>(_mm_movemask_epi8(stop));
+      if (mask != 0U) {
+        return index + static_cast<std::size_t>(std::countr_zero(mask));
+      }
+    }
+  }
+#elif defined(__ARM_NEON) && __ARM_NEON
+  for (auto const backslash = vdupq_n_u8('\\'); size - index >= 16U; index += 16U) {
+    auto const v = vld1q_u8(std::bit_cast<std::uint8_t const*>(first + index));
+    auto const stop = vorrq_u8(vcgeq_u8(v, vdupq_n_u8(0x80)), vceqq_u8(v, backslash));
+    // Narrowing each 16-bit lane with a shift by 4 leaves a 64-bit value with a nibble per input byte.
+    auto const narrow = vshrn_n_u16(vreinterpretq_u16_u8(stop), 4);
+    if (auto const mask = vget_lane_u64(vreinterpret_u64_u8(narrow), 0); mask != 0U) {
+      return index + static_cast<std::size_t>(std::countr_zero(mask)) / 4U;
+    }
+  }
+#endif
+  for (; index < size; ++index) {
+    if (auto const c = std::to_integer<unsigned>(first[index]); c >= 0x80U || c == '\\') {
+      break;
+    }
+  }
+  return index;
+}
+
+}  // end namespace midi2::ci::details
@@ -0,0 +1,149 @@
+//===-- Pseudo LRU Cache ------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+#include "midi2/adt/plru_cache.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "midi2/simd.hpp"
+
+namespace {
+
+template <typename T> [[nodiscard]] std::size_t find_scalar(T const tag, std::span<T const> const lanes) noexcept {
+  return static_cast<std::size_t>(std::ranges::find(lanes, tag) - lanes.begin());
+}
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+/// Compares each lane of \p b with \p tag and returns a 16-bit byte mask of the matching lanes.
+template <typename T> [[nodiscard]] std::uint32_t compare128(T const tag, __m128i const b) noexcept {
+  __m128i cmp;
+  if constexpr (sizeof(T) == 2) {
+    cmp = _mm_cmpeq_epi16(_mm_set1_epi16(static_cast<short>(tag)), b);
+  } else {
+    cmp = _mm_cmpeq_epi32(_mm_set1_epi32(static_cast<int>(tag)), b);
+  }
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(cmp));
+}
+
+/// Compares each lane of \p b with \p tag and returns a 32-bit byte mask of the matching lanes.
+template <typename T> [[nodiscard]] std::uint32_t compare256(T const tag, __m256i const b) noexcept {
+  __m256i cmp;
+  if constexpr (sizeof(T) == 2) {
+    cmp = _mm256_cmpeq_epi16(_mm256_set1_epi16(static_cast<short>(tag)), b);
+  } else {
+    cmp = _mm256_cmpeq_epi32(_mm256_set1_epi32(static_cast<int>(tag)), b);
+  }
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(cmp));
+}
+
+/// An x86 implementation of find_lane() for arrays of 8, 16, 32, or 64 bytes. SSE2 is always used; AVX2 and
+/// AVX-512F are used for the wider arrays where the library's target enables them.
+template <typename T> [[nodiscard]] std::size_t find_x86(T const tag, std::span<T const> const lanes) noexcept {
+  auto const bytes = lanes.size_bytes();
+  auto const* const data = std::bit_cast<std::byte const*>(lanes.data());
+  if constexpr (midi2::details::simd_avx512f && sizeof(T) == 4) {
+    if (bytes == 64) {
+      // A single compare of all 16 lanes produces a mask with one bit per lane.
+      auto const a = _mm512_set1_epi32(static_cast<int>(tag));
+      auto const b = _mm512_loadu_si512(data);
+      auto const mask = static_cast<unsigned>(_mm512_cmpeq_epi32_mask(a, b));
+      return static_cast<std::size_t>(std::countr_zero(mask | (1U << lanes.size())));
+    }
+  }
+  // Build a mask with one bit per byte of the keys array: all of the bits belonging to a matching lane are set.
+  std::uint64_t mask = 0;
+  auto offset = std::size_t{0};
+  if (bytes == 8) {
+    mask = compare128(tag, _mm_loadl_epi64(std::bit_cast<__m128i const*>(data))) & 0xFFU;
+    offset = bytes;
+  }
+  if constexpr (midi2::details::simd_avx2) {
+    for (; bytes - offset >= 32; offset += 32) {
+      auto const b = _mm256_loadu_si256(std::bit_cast<__m256i const*>(data + offset));
+      mask |= std::uint64_t{compare256(tag, b)} << offset;
+    }
+  }
+  for (; offset < bytes; offset += 16) {
+    auto const b = _mm_loadu_si128(std::bit_cast<__m128i const*>(data + offset));
+    mask |= std::uint64_t{compare128(tag, b)} << offset;
+  }
+  // If no lane matched, the sentinel bit just beyond the array yields the number of lanes. A 64-byte array needs no
+  // sentinel because countr_zero(0) is 64.
+  auto const sentinel = bytes < 64U ? std::uint64_t{1} << bytes : std::uint64_t{0};
+  return static_cast<std::size_t>(std::countr_zero(mask | sentinel)) / sizeof(T);
+}
+
+#elif defined(__ARM_NEON) && __ARM_NEON
+
+// Each of the NEON implementations narrows the lane comparison to a single 64-bit value in which every lane of the
+// input is represented by a group of bits that are all set if it matched. If the value is zero, no lane matched: the
+// sentinel top bit then makes the count of trailing zeros give the number of lanes.
+
+[[nodiscard]] std::size_t find_neon(std::uint16_t const tag, std::span<std::uint16_t const> const lanes) noexcept {
+  if (lanes.size() == 4) {
+    uint16x4_t const cmp = vceq_u16(vdup_n_u16(tag), vld1_u16(lanes.data()));  // 0xFFFF if equal
+    std::uint64_t const packed = vget_lane_u64(vreinterpret_u64_u16(cmp), 0);
+    std::uint64_t const nz_or = packed | (static_cast<std::uint64_t>(packed == 0) << 63);
+    return (static_cast<std::size_t>(static_cast<unsigned>(std::countr_zero(nz_or)) + 1U)) >> 4;
+  }
+  if (lanes.size() == 8) {
+    uint16x8_t const cmp = vceqq_u16(vdupq_n_u16(tag), vld1q_u16(lanes.data()));
+    uint8x8_t const narrow = vmovn_u16(cmp);  // Narrow to 8-bit: 0xFF if equal, 0x00 if not
+    std::uint64_t const packed = vget_lane_u64(vreinterpret_u64_u8(narrow), 0);
+    std::uint64_t const nz_or = packed | (static_cast<std::uint64_t>(packed == 0) << 63);
+    return (static_cast<std::size_t>(static_cast<unsigned>(std::countr_zero(nz_or)) + 1U)) >> 3;
+  }
+  return find_scalar(tag, lanes);
+}
+
+[[nodiscard]] std::size_t find_neon(std::uint32_t const tag, std::span<std::uint32_t const> const lanes) noexcept {
+  if (lanes.size() == 4) {
+    uint32x4_t const cmp = vceqq_u32(vdupq_n_u32(tag), vld1q_u32(lanes.data()));
+    uint16x4_t const narrow = vmovn_u32(cmp);  // Narrow to 16-bit: 0xFFFF if equal, 0x0000 if not
+    std::uint64_t const packed = vget_lane_u64(vreinterpret_u64_u16(narrow), 0);
+    std::uint64_t const nz_or = packed | (static_cast<std::uint64_t>(packed == 0) << 63);
+    return (static_cast<unsigned>(std::countr_zero(nz_or)) + 1U) / 16U;
+  }
+  return find_scalar(tag, lanes);
+}
+
+#endif
+
+template <typename T> [[nodiscard]] std::size_t find_tag(T const tag, std::span<T const> const lanes) noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  if constexpr (midi2::details::simd_sse2) {
+    return find_x86(tag, lanes);
+  } else {
+    return find_scalar(tag, lanes);
+  }
+#elif defined(__ARM_NEON) && __ARM_NEON
+  return find_neon(tag, lanes);
+#else
+  return find_scalar(tag, lanes);
+#endif
+}
+
+}  // end anonymous namespace
+
+namespace midi2::adt::details {
+
+std::size_t find_lane(std::uint16_t const tag, std::span<std::uint16_t const> const lanes) noexcept {
+  return find_tag(tag, lanes);
+}
+std::size_t find_lane(std::uint32_t const tag, std::span<std::uint32_t const> const lanes) noexcept {
+  return find_tag(tag, lanes);
+}
+
+}  // end namespace midi2::adt::details
@@ -0,0 +1,39 @@
+//===-- Fake Clock ------------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+#ifndef MIDI2_UNITTESTS_FAKE_CLOCK_HPP
+#define MIDI2_UNITTESTS_FAKE_CLOCK_HPP
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+namespace midi2::test {
+
+/// A clock whose time is advanced explicitly by the tests.
+struct fake_clock {
+  using duration = std::chrono::milliseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<fake_clock>;
+  static constexpr bool is_steady = true;
+  static time_point now() noexcept { return current; }
+  static inline time_point current{};
+};
+
+/// A test fixture which starts each test with fake_clock at its epoch.
+class fake_clock_test : public testing::Test {
+protected:
+  void SetUp() override { fake_clock::current = fake_clock::time_point{}; }
+};
+
+}  // end namespace midi2::test
+
+#endif  // MIDI2_UNITTESTS_FAKE_CLOCK_HPP
@@ -0,0 +1,135 @@
+//===-- arena -----------------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/adt/arena.hpp"
+
+// Standard library
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using namespace std::string_view_literals;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+std::string_view as_string(std::span<char const> const s) {
+  return {s.data(), s.size()};
+}
+
+// NOLINTNEXTLINE
+TEST(Arena, Empty) {
+  midi2::adt::arena<char, 2, 8, 4> arena;
+  EXPECT_EQ(arena.capacity(), 8U);
+  EXPECT_EQ(arena.size(0), 0U);
+  EXPECT_THAT(arena.gather(1), IsEmpty());
+}
+// NOLINTNEXTLINE
+TEST(Arena, CapacityIsWholeBlocks) {
+  EXPECT_EQ((midi2::adt::arena<char, 1, 9, 4>::capacity()), 12U);
+  EXPECT_EQ((midi2::adt::arena<char, 1, 9, 4>::blocks), 3U);
+}
+// NOLINTNEXTLINE
+TEST(Arena, AppendInterleaved) {
+  midi2::adt::arena<char, 3, 32, 4> arena;
+  EXPECT_TRUE(arena.append(0, "ab"sv));
+  EXPECT_TRUE(arena.append(1, "cd"sv));
+  EXPECT_TRUE(arena.append(0, "ef"sv));
+  EXPECT_TRUE(arena.append(2, "g"sv));
+  EXPECT_TRUE(arena.append(1, "hij"sv));
+  EXPECT_TRUE(arena.append(0, "klm"sv));
+  EXPECT_EQ(arena.size(0), 7U);
+  EXPECT_EQ(as_string(arena.gather(0)), "abefklm"sv);
+  EXPECT_EQ(as_string(arena.gather(1)), "cdhij"sv);
+  EXPECT_EQ(as_string(arena.gather(2)), "g"sv);
+  // Gathering one segment must not disturb the others.
+  EXPECT_EQ(as_string(arena.gather(0)), "abefklm"sv);
+}
+// NOLINTNEXTLINE
+TEST(Arena, FullWhenNoFreeBlocks) {
+  midi2::adt::arena<char, 2, 8, 2> arena;
+  // Alternating appends give each segment every other block.
+  EXPECT_TRUE(arena.append(0, "ab"sv));
+  EXPECT_TRUE(arena.append(1, "cd"sv));
+  EXPECT_TRUE(arena.append(0, "ef"sv));
+  EXPECT_TRUE(arena.append(1, "gh"sv));
+  // The arena is now full.
+  EXPECT_FALSE(arena.append(0, "i"sv));
+  EXPECT_EQ(as_string(arena.gather(0)), "abef"sv);
+  EXPECT_EQ(as_string(arena.gather(1)), "cdgh"sv);
+}
+// NOLINTNEXTLINE
+TEST(Arena, PartBlockIsFilledFirst) {
+  midi2::adt::arena<char, 2, 12, 4> arena;
+  EXPECT_TRUE(arena.append(0, "a"sv));
+  EXPECT_TRUE(arena.append(1, "bcde"sv));
+  // Segment 0 has three free elements in its block and the arena has one free block.
+  EXPECT_TRUE(arena.append(0, "fgh"sv));
+  EXPECT_FALSE(arena.append(1, "ijklm"sv));
+  EXPECT_TRUE(arena.append(1, "ijkl"sv));
+  EXPECT_FALSE(arena.append(0, "n"sv));
+  EXPECT_EQ(as_string(arena.gather(0)), "afgh"sv);
+  EXPECT_EQ(as_string(arena.gather(1)), "bcdeijkl"sv);
+}
+// NOLINTNEXTLINE
+TEST(Arena, ClearReleasesSpace) {
+  midi2::adt::arena<char, 2, 8, 4> arena;
+  EXPECT_TRUE(arena.append(0, "abcd"sv));
+  EXPECT_TRUE(arena.append(1, "efgh"sv));
+  EXPECT_FALSE(arena.append(1, "i"sv));
+  arena.clear(0);
+  EXPECT_EQ(arena.size(0), 0U);
+  EXPECT_TRUE(arena.append(1, "ijkl"sv));
+  EXPECT_EQ(as_string(arena.gather(1)), "efghijkl"sv);
+  arena.clear(1);
+  EXPECT_TRUE(arena.append(0, "mnopqrst"sv));
+  EXPECT_EQ(as_string(arena.gather(0)), "mnopqrst"sv);
+}
+// NOLINTNEXTLINE
+TEST(Arena, InterleavedLongSegments) {
+  constexpr auto segments = std::size_t{16};
+  constexpr auto per_segment = std::size_t{600};
+  midi2::adt::arena<char, segments, segments * per_segment, 8> arena;
+  // Append a few characters at a time to each segment in turn so that every segment's blocks are scattered
+  // throughout the arena.
+  std::array<std::string, segments> expected;
+  for (auto round = std::size_t{0}; round < per_segment / 6; ++round) {
+    for (auto seg = std::size_t{0}; seg < segments; ++seg) {
+      std::string chunk;
+      for (auto ctr = std::size_t{0}; ctr < 6; ++ctr) {
+        chunk += static_cast<char>('A' + (seg + round + ctr) % 26);
+      }
+      ASSERT_TRUE(arena.append(seg, chunk));
+      expected[seg] += chunk;
+    }
+  }
+  // Gather the segments in an order unrelated to that of their blocks, releasing some as we go.
+  for (auto const seg : {std::size_t{5}, std::size_t{0}, std::size_t{15}, std::size_t{9}}) {
+    EXPECT_EQ(as_string(arena.gather(seg)), expected[seg]) << "segment " << seg;
+    arena.clear(seg);
+    expected[seg].clear();
+  }
+  // Space released by the cleared segments is available to the survivors.
+  ASSERT_TRUE(arena.append(3, std::string(per_segment, '*')));
+  expected[3] += std::string(per_segment, '*');
+  for (auto seg = std::size_t{0}; seg < segments; ++seg) {
+    EXPECT_EQ(as_string(arena.gather(seg)), expected[seg]) << "segment " << seg;
+  }
+}
+
+}  // end anonymous namespace
@@ -11,6 +11,7 @@
 // DUT
 #include "midi2/bytestream/bytestream_to_ump.hpp"
 #include "midi2/bytestream/bytestream_types.hpp"
+#include "midi2/translator.hpp"
 #include "midi2/ump/ump_types.hpp"
 #include "midi2/utils.hpp"
 
@@ -20,7 +21,9 @@
 #include <cassert>
 #include <cstdint>
 #include <format>
+#include <iterator>
 #include <ostream>
+#include <span>
 #include <type_traits>
 #include <vector>
 
@@ -563,9 +566,49 @@ void NeverCrashes(std::vector<std::byte> const& bytes) {
   }
 }
 
+void BulkMatchesPush(std::vector<std::byte> const& bytes) {
+  std::vector<std::uint32_t> expected;
+  {
+    midi2::bytestream::to_ump bs2ump;
+    for (auto const b : bytes) {
+      bs2ump.push(b);
+      while (!bs2ump.empty()) {
+        expected.push_back(bs2ump.pop());
+      }
+    }
+  }
+  {
+    // Translate through an output iterator.
+    midi2::bytestream::to_ump bs2ump;
+    std::vector<std::uint32_t> actual;
+    auto const result = midi2::translate(bs2ump, std::span{bytes}, std::back_inserter(actual));
+    EXPECT_EQ(result.consumed, bytes.size());
+    EXPECT_EQ(result.produced, actual.size());
+    EXPECT_THAT(actual, ElementsAreArray(expected));
+  }
+  {
+    // Translate into a span which is too small to hold all of the output. This exercises the code which holds output
+    // in the translator until the following call.
+    midi2::bytestream::to_ump bs2ump;
+    std::vector<std::uint32_t> actual;
+    std::array<std::uint32_t, 3> buffer{};
+    std::span<std::byte const> input{bytes};
+    do {
+      auto const result = midi2::translate(bs2ump, input, std::span{buffer});
+      auto const produced = std::span{buffer}.first(result.produced);
+      EXPECT_EQ(result.out, std::end(produced));
+      actual.insert(std::end(actual), std::begin(produced), std::end(produced));
+      input = input.subspan(result.consumed);
+    } while (!input.empty() || !bs2ump.empty());
+    EXPECT_THAT(actual, ElementsAreArray(expected));
+  }
+}
+
 #if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
 // NOLINTNEXTLINE
 FUZZ_TEST(BytestreamToUMPFuzz, NeverCrashes);
+// NOLINTNEXTLINE
+FUZZ_TEST(BytestreamToUMPFuzz, BulkMatchesPush);
 #endif
 TEST(BytestreamToUMPFuzz, Empty) {
   NeverCrashes({});
@@ -573,5 +616,47 @@ TEST(BytestreamToUMPFuzz, Empty) {
 TEST(BytestreamToUMPFuzz, OneByte) {
   NeverCrashes({static_cast<std::byte>(std::to_underlying(midi2::bytestream::status::tune_request))});
 }
+TEST(BytestreamToUMPFuzz, BulkMatchesPushEmpty) {
+  BulkMatchesPush({});
+}
+TEST(BytestreamToUMPFuzz, BulkMatchesPushSysExAndRunningStatus) {
+  BulkMatchesPush({0xF0_b, 0x7E_b, 0x7F_b, 0x0D_b, 0x70_b, 0x02_b, 0xF8_b, 0x01_b, 0x02_b, 0x03_b, 0x04_b, 0x05_b,
+                   0x06_b, 0x07_b, 0xF7_b, 0x91_b, 0x3C_b, 0x7F_b, 0x3E_b, 0x7F_b, 0xFE_b, 0x40_b, 0x00_b, 0xC2_b,
+                   0x05_b, 0x06_b, 0xF0_b, 0x01_b, 0xF7_b});
+}
+
+TEST(BytestreamToUMPFuzz, BulkMatchesPushLongSysEx) {
+  // A long sysex message with real-time messages embedded at various points. Each length exercises a different
+  // split between the bulk path and the byte-at-a-time path.
+  for (auto length = std::size_t{0}; length < 80U; ++length) {
+    std::vector<std::byte> bytes{0xF0_b};
+    for (auto ctr = std::size_t{0}; ctr < length; ++ctr) {
+      bytes.push_back(static_cast<std::byte>(ctr % 0x80U));
+      if (ctr % 37U == 36U) {
+        bytes.push_back(0xF8_b);
+      }
+    }
+    bytes.push_back(0xF7_b);
+    BulkMatchesPush(bytes);
+  }
+}
+TEST(BytestreamToUMPFuzz, BulkMatchesPushRunningStatus) {
+  std::vector<std::byte> bytes{0x90_b};
+  for (auto ctr = 0U; ctr < 75U; ++ctr) {
+    bytes.push_back(static_cast<std::byte>(ctr % 0x80U));
+    if (ctr % 20U == 19U) {
+      bytes.push_back(0xFE_b);
+    }
+  }
+  bytes.push_back(0xD3_b);
+  for (auto ctr = 0U; ctr < 41U; ++ctr) {
+    bytes.push_back(static_cast<std::byte>(ctr % 0x80U));
+  }
+  bytes.push_back(0xF2_b);
+  for (auto ctr = 0U; ctr < 9U; ++ctr) {
+    bytes.push_back(static_cast<std::byte>(ctr % 0x80U));
+  }
+  BulkMatchesPush(bytes);
+}
 
 }  // end anonymous namespace
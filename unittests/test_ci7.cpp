@@ -13,6 +13,7 @@
 #include "midi2/utils.hpp"
 
 // Standard library
+#include <span>
 #include <string>
 
 // Google Test/Mock/FuzzTest
@@ -154,6 +155,31 @@ TYPED_TEST(CI7TextEncode, Utf16SurrogatePairs) {
   EXPECT_EQ(this->convert(str32), R"(\uD800\uDC17\uD800\uDC1B)");
 }
 
+// NOLINTNEXTLINE
+TYPED_TEST(CI7TextEncode, BulkMatchesCodeUnit) {
+  // Long runs of plain ASCII interrupted by characters which must be escaped at various offsets.
+  std::u32string str32;
+  for (auto ctr = 0U; ctr < 100U; ++ctr) {
+    str32 += static_cast<char32_t>('a' + ctr % 26U);
+    if (ctr % 41U == 40U) {
+      str32 += '\\';
+    }
+    if (ctr % 23U == 22U) {
+      str32 += char32_t{0x266A};
+    }
+  }
+  str32 += char32_t{0x10017};
+  std::basic_string<TypeParam> in;
+  std::ranges::copy(str32 | icubaby::views::transcode<char32_t, TypeParam>, std::back_inserter(in));
+
+  midi2::transcoder<TypeParam, char> t;
+  std::string output;
+  t.end_cp(t.transcode(std::span{in}, std::back_inserter(output)));
+  EXPECT_EQ(output, this->convert(str32));
+  EXPECT_TRUE(t.well_formed());
+  EXPECT_FALSE(t.partial());
+}
+
 template <typename T> class CI7TextDecode : public testing::Test {
 protected:
   std::basic_string<T> convert(midi2::transcoder<char, T>& t2, std::string_view input) {
@@ -336,6 +362,31 @@ TYPED_TEST(CI7TextDecode, MissingLowSurrogateFollowedByNormal) {
   EXPECT_FALSE(t2.partial());
 }
 
+// NOLINTNEXTLINE
+TYPED_TEST(CI7TextDecode, BulkMatchesCodeUnit) {
+  auto const long_run = std::string(70, 'x');
+  for (auto const& input : {
+           std::string{"Hello"},
+           long_run + R"(\\)" + long_run + R"(\n\t\/)" + long_run,
+           long_run + R"(\u266A)" + long_run,
+           long_run + R"(\uD800\uDC17\uD800\uDC1B)" + long_run,
+           long_run + R"(\uD800)" + long_run,
+           long_run + R"(\u26)" + long_run,
+           long_run + "\x80" + long_run,
+           long_run + R"(\q)" + long_run + "\\",
+       }) {
+    midi2::transcoder<char, TypeParam> expected_t2;
+    auto const expected = this->convert(expected_t2, input);
+
+    midi2::transcoder<char, TypeParam> t2;
+    std::basic_string<TypeParam> output;
+    t2.end_cp(t2.transcode(std::span{input}, std::back_inserter(output)));
+    EXPECT_EQ(output, expected);
+    EXPECT_EQ(t2.well_formed(), expected_t2.well_formed());
+    EXPECT_FALSE(t2.partial());
+  }
+}
+
 template <typename OutputEncoding, typename InputEncoding>
 std::vector<OutputEncoding> convert(std::vector<InputEncoding> const& input) {
   midi2::transcoder<InputEncoding, OutputEncoding> t2;
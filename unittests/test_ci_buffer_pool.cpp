@@ -0,0 +1,176 @@
+//===-- CI Buffer Pool --------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_buffer_pool.hpp"
+
+// MIDI2
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_dispatcher.hpp"
+
+// Standard library
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using testing::ElementsAre;
+
+// NOLINTNEXTLINE
+TEST(CIBufferPool, AcquireAndRelease) {
+  midi2::ci::buffer_pool<16, 2> pool;
+  EXPECT_EQ(pool.capacity(), 2U);
+  auto const a = pool.acquire();
+  auto const b = pool.acquire();
+  EXPECT_EQ(a.size(), 16U);
+  EXPECT_EQ(b.size(), 16U);
+  EXPECT_NE(a.data(), b.data());
+  EXPECT_EQ(pool.in_use(), 2U);
+  EXPECT_TRUE(pool.acquire().empty());
+  EXPECT_EQ(pool.exhausted(), 1U);
+
+  pool.release(a);
+  EXPECT_EQ(pool.in_use(), 1U);
+  auto const c = pool.acquire();
+  EXPECT_EQ(c.data(), a.data());
+  pool.release(b);
+  pool.release(c);
+  EXPECT_EQ(pool.in_use(), 0U);
+  EXPECT_EQ(pool.high_water_mark(), 2U);
+}
+
+using context_type = int;
+using pool_type = midi2::ci::buffer_pool<64, 2>;
+
+using base_config = midi2::ci::function_config<context_type, pool_type::buffer_size>;
+struct pooled_config : base_config {
+  pool_type* buffer_pool = nullptr;
+};
+static_assert(midi2::ci::ci_dispatcher_pool_config<pooled_config>);
+
+struct mismatched_config : midi2::ci::function_config<context_type, pool_type::buffer_size / 2U> {
+  pool_type* buffer_pool = nullptr;
+};
+static_assert(!midi2::ci::ci_dispatcher_pool_config<mismatched_config>,
+              "The pool's buffers must be the configuration's buffer_size");
+
+using pooled_dispatcher = midi2::ci::ci_dispatcher<pooled_config>;
+
+constexpr auto my_muid = midi2::ci::muid{0x01234567U};
+
+constexpr midi2::ci::header make_header(std::uint32_t const remote, midi2::ci::muid const local) {
+  return {.device_id = midi2::ci::b7{0x7FU},
+          .version = midi2::ci::b7{2U},
+          .remote_muid = midi2::ci::muid{remote},
+          .local_muid = local};
+}
+
+std::vector<std::byte> make_discovery(midi2::ci::header const& hdr) {
+  using midi2::ci::b7;
+  constexpr midi2::ci::discovery discovery{.manufacturer = {b7{0x12U}, b7{0x23U}, b7{0x34U}},
+                                           .family = midi2::ci::b14{0x1779U},
+                                           .model = midi2::ci::b14{0x2B5DU},
+                                           .version = {b7{0x4EU}, b7{0x3CU}, b7{0x2AU}, b7{0x18U}},
+                                           .capability = b7{0x7FU},
+                                           .max_sysex_size = midi2::ci::b28{512U},
+                                           .output_path_id = b7{0x71U}};
+  std::vector<std::byte> message;
+  midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{}, hdr, discovery);
+  return message;
+}
+
+class CIPooledDispatcher : public testing::Test {
+protected:
+  CIPooledDispatcher() {
+    for (auto index = 0U; index < dispatchers_.size(); ++index) {
+      pooled_config config{base_config{static_cast<context_type>(index)}};
+      config.buffer_pool = &pool_;
+      config.system.on_check_muid([](context_type, std::uint8_t, midi2::ci::muid const m) { return m == my_muid; });
+      config.system.on_buffer_overflow([this](context_type const c) { overflows_.push_back(c); });
+      config.management.on_discovery(
+          [this](context_type const c, midi2::ci::header const& h, midi2::ci::discovery const&) {
+            received_.emplace_back(c, h.remote_muid);
+          });
+      dispatchers_[index].emplace(midi2::ci::b7{0x7FU}, static_cast<std::uint8_t>(index), std::move(config));
+    }
+  }
+  pooled_dispatcher& dispatcher(std::size_t const index) { return *dispatchers_[index]; }
+
+  pool_type pool_;
+  std::vector<std::pair<context_type, midi2::ci::muid>> received_;
+  std::vector<context_type> overflows_;
+  // Declared after pool_ so that the dispatchers are destroyed first.
+  std::array<std::optional<pooled_dispatcher>, 4> dispatchers_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CIPooledDispatcher, BufferIsReleasedWhenMessageIsHandled) {
+  for (auto index = 0U; index < dispatchers_.size(); ++index) {
+    this->dispatcher(index).dispatch(make_discovery(make_header(index, midi2::ci::broadcast_muid)));
+    EXPECT_EQ(pool_.in_use(), 0U);
+  }
+  EXPECT_THAT(received_, ElementsAre(std::pair{0, midi2::ci::muid{0U}}, std::pair{1, midi2::ci::muid{1U}},
+                                     std::pair{2, midi2::ci::muid{2U}}, std::pair{3, midi2::ci::muid{3U}}));
+  EXPECT_EQ(pool_.high_water_mark(), 1U);
+  EXPECT_THAT(overflows_, testing::IsEmpty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIPooledDispatcher, PoolExhausted) {
+  // Start three messages at once. Only two buffers are available so the third message is reported as an overflow.
+  std::array<std::vector<std::byte>, 3> messages;
+  for (auto index = 0U; index < messages.size(); ++index) {
+    messages[index] = make_discovery(make_header(index, my_muid));
+    this->dispatcher(index).dispatch(std::span{messages[index]}.first(20));
+  }
+  EXPECT_EQ(pool_.in_use(), 2U);
+  EXPECT_EQ(pool_.exhausted(), 1U);
+  EXPECT_THAT(overflows_, ElementsAre(2));
+  for (auto index = 0U; index < messages.size(); ++index) {
+    this->dispatcher(index).dispatch(std::span{messages[index]}.subspan(20));
+  }
+  EXPECT_THAT(received_, ElementsAre(std::pair{0, midi2::ci::muid{0U}}, std::pair{1, midi2::ci::muid{1U}}));
+  EXPECT_EQ(pool_.in_use(), 0U);
+
+  // The dispatcher which overflowed can take a buffer for its next message.
+  this->dispatcher(2).reset();
+  this->dispatcher(2).dispatch(messages[2]);
+  EXPECT_THAT(received_, ElementsAre(std::pair{0, midi2::ci::muid{0U}}, std::pair{1, midi2::ci::muid{1U}},
+                                     std::pair{2, midi2::ci::muid{2U}}));
+}
+// NOLINTNEXTLINE
+TEST_F(CIPooledDispatcher, MessageForAnotherReceiverDoesNotTakeABuffer) {
+  auto const message = make_discovery(make_header(1U, midi2::ci::muid{0x7654321U}));
+  this->dispatcher(0).dispatch(std::span{message}.first(20));
+  EXPECT_EQ(pool_.in_use(), 0U);
+  EXPECT_EQ(pool_.high_water_mark(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(CIPooledDispatcher, ResetAndDestructionReleaseBuffers) {
+  auto const message = make_discovery(make_header(1U, my_muid));
+  this->dispatcher(0).dispatch(std::span{message}.first(20));
+  this->dispatcher(1).dispatch(std::span{message}.first(20));
+  EXPECT_EQ(pool_.in_use(), 2U);
+  this->dispatcher(0).reset();
+  EXPECT_EQ(pool_.in_use(), 1U);
+  dispatchers_[1].reset();
+  EXPECT_EQ(pool_.in_use(), 0U);
+}
+
+}  // end anonymous namespace
@@ -16,13 +16,18 @@
 #include "midi2/utils.hpp"
 
 // Standard library
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <ostream>
 #include <ranges>
 #include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 // google mock/test/fuzz
 #include <gmock/gmock.h>
@@ -1276,4 +1281,106 @@ TEST_F(CICreateMessage, ProcessInquiryMidiMessageReportEnd) {
               testing::ElementsAreArray(expected));
 }
 
+class CIPropertyExchangeChunker : public CICreateMessage {
+protected:
+  static constexpr midi2::ci::header hdr_{
+      .device_id = 0x7F_b7,
+      .version = 2_b7,
+      .remote_muid = from_le7(sender_muid_),
+      .local_muid = from_le7(destination_muid_),
+  };
+  /// The number of bytes in a chunk other than the property header and data, including F0 and F7.
+  static constexpr auto overhead_ = std::size_t{2 + 13 + 3 + 6};
+};
+
+// NOLINTNEXTLINE
+TEST_F(CIPropertyExchangeChunker, SplitsData) {
+  constexpr auto header = R"({"status":200})"sv;
+  constexpr auto data = "abcdefghijklmnopqrstuvwxyz0123456789"sv;
+  // Allow 20 bytes of header and data per chunk: the first chunk carries the header plus 6 bytes of data.
+  constexpr auto max_sysex_size = midi2::ci::b28{overhead_ + 20U};
+  constexpr auto reply = midi2::ci::property_exchange::get_reply::make({}, 3_b7, header, data);
+
+  midi2::ci::property_exchange_chunker chunker{hdr_, reply, max_sysex_size};
+  ASSERT_TRUE(chunker.valid());
+  EXPECT_EQ(chunker.number_of_chunks(), 3U);
+  EXPECT_EQ(chunker.max_chunk_size(), overhead_ + 20U - 2U);
+
+  std::vector<std::byte> buffer(chunker.max_chunk_size());
+  auto const expected_chunk = [](unsigned const number, std::string_view const h, std::string_view const d) {
+    return make_message(hdr_, midi2::ci::property_exchange::get_reply{
+                                  .chunk = {.number_of_chunks = midi2::ci::b14{3U},
+                                            .chunk_number = midi2::ci::b14{number}},
+                                  .request = 3_b7,
+                                  .header = h,
+                                  .data = d,
+                              });
+  };
+  EXPECT_THAT(chunker.next(buffer), testing::ElementsAreArray(expected_chunk(1U, header, data.substr(0, 6))));
+  EXPECT_FALSE(chunker.done());
+  EXPECT_THAT(chunker.next(buffer), testing::ElementsAreArray(expected_chunk(2U, ""sv, data.substr(6, 20))));
+  EXPECT_THAT(chunker.next(buffer), testing::ElementsAreArray(expected_chunk(3U, ""sv, data.substr(26))));
+  EXPECT_TRUE(chunker.done());
+  EXPECT_TRUE(chunker.next(buffer).empty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyExchangeChunker, SingleChunk) {
+  constexpr auto header = R"({"resource":"DeviceInfo"})"sv;
+  constexpr auto get = midi2::ci::property_exchange::get::make({}, 1_b7, header);
+  midi2::ci::property_exchange_chunker chunker{hdr_, get, midi2::ci::b28{512U}};
+  EXPECT_EQ(chunker.number_of_chunks(), 1U);
+  std::array<std::byte, 512> buffer{};
+  EXPECT_THAT(chunker.next(buffer),
+              testing::ElementsAreArray(make_message(
+                  hdr_, midi2::ci::property_exchange::get::make(
+                            {.number_of_chunks = midi2::ci::b14{1U}, .chunk_number = midi2::ci::b14{1U}}, 1_b7,
+                            header))));
+  EXPECT_TRUE(chunker.done());
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyExchangeChunker, BufferTooSmall) {
+  constexpr auto data = "0123456789"sv;
+  constexpr auto set = midi2::ci::property_exchange::set::make({}, 1_b7, "{}"sv, data);
+  // The first chunk has space for 4 bytes of data and the second for the remaining 6.
+  midi2::ci::property_exchange_chunker chunker{hdr_, set, midi2::ci::b28{overhead_ + 6U}};
+  EXPECT_EQ(chunker.number_of_chunks(), 2U);
+  std::vector<std::byte> buffer(chunker.max_chunk_size() - 1U);
+  // Nothing is written and the chunker does not advance until a large enough buffer is supplied.
+  EXPECT_TRUE(chunker.next(buffer).empty());
+  EXPECT_FALSE(chunker.done());
+  buffer.resize(chunker.max_chunk_size());
+  std::string received;
+  for (auto chunk = chunker.next(buffer); !chunk.empty(); chunk = chunker.next(buffer)) {
+    // The property data follows the 6 byte chunk information block which itself follows the header.
+    auto const header_length = static_cast<std::size_t>(chunk[14]) | (static_cast<std::size_t>(chunk[15]) << 7U);
+    auto const pt2 = 13U + 3U + header_length;
+    auto const length = static_cast<std::size_t>(chunk[pt2 + 4U]) | (static_cast<std::size_t>(chunk[pt2 + 5U]) << 7U);
+    ASSERT_EQ(chunk.size(), pt2 + 6U + length);
+    std::ranges::transform(chunk.subspan(pt2 + 6U), std::back_inserter(received),
+                           [](std::byte const b) { return static_cast<char>(b); });
+  }
+  EXPECT_EQ(received, data);
+  EXPECT_TRUE(chunker.done());
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyExchangeChunker, HeaderTooLarge) {
+  constexpr auto set = midi2::ci::property_exchange::set::make({}, 1_b7, R"({"resource":"X"})"sv);
+  midi2::ci::property_exchange_chunker chunker{hdr_, set, midi2::ci::b28{overhead_ + 4U}};
+  EXPECT_FALSE(chunker.valid());
+  EXPECT_TRUE(chunker.done());
+  std::array<std::byte, 64> buffer{};
+  EXPECT_TRUE(chunker.next(buffer).empty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyExchangeChunker, NoRoomForData) {
+  // A limit equal to the fixed overhead leaves no room for data in any chunk.
+  constexpr auto set = midi2::ci::property_exchange::set::make({}, 1_b7, ""sv, "data"sv);
+  midi2::ci::property_exchange_chunker chunker{hdr_, set, midi2::ci::b28{overhead_}};
+  EXPECT_FALSE(chunker.valid());
+  EXPECT_EQ(chunker.number_of_chunks(), 0U);
+  EXPECT_TRUE(chunker.done());
+  std::array<std::byte, 64> buffer{};
+  EXPECT_TRUE(chunker.next(buffer).empty());
+}
+
 }  // end anonymous namespace
@@ -0,0 +1,206 @@
+//===-- CI Discovery Responder ------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_discovery_responder.hpp"
+
+// MIDI2
+#include "midi2/ci/ci_create_message.hpp"
+
+// Standard library
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Test helpers
+#include "fake_clock.hpp"
+
+namespace {
+
+using midi2::ci::b7;
+using midi2::ci::muid;
+using midi2::test::fake_clock;
+using testing::ElementsAre;
+
+using responder_type = midi2::ci::discovery_responder<8, 4, 4, fake_clock>;
+using limiter_type = midi2::ci::reply_rate_limiter<fake_clock>;
+
+constexpr auto local_muid = muid{0x0123456U};
+
+constexpr midi2::ci::discovery_reply reply{.manufacturer = {b7{0x12U}, b7{0x23U}, b7{0x34U}},
+                                           .family = midi2::ci::b14{0x1779U},
+                                           .model = midi2::ci::b14{0x2B5DU},
+                                           .version = {b7{0x4EU}, b7{0x3CU}, b7{0x2AU}, b7{0x18U}},
+                                           .capability = b7{0x7FU},
+                                           .max_sysex_size = midi2::ci::b28{512U},
+                                           .output_path_id = b7{0U},
+                                           .function_block = b7{0x7FU}};
+
+constexpr midi2::ci::header request_header(std::uint32_t const remote) {
+  return {.device_id = b7{0x7FU}, .version = b7{2U}, .remote_muid = muid{remote}, .local_muid = local_muid};
+}
+constexpr midi2::ci::discovery make_discovery(std::uint8_t const output_path_id) {
+  return {.manufacturer = {b7{0x01U}, b7{0x02U}, b7{0x03U}},
+          .family = midi2::ci::b14{0x0001U},
+          .model = midi2::ci::b14{0x0002U},
+          .version = {b7{0x01U}, b7{0x00U}, b7{0x00U}, b7{0x00U}},
+          .capability = b7{0x7FU},
+          .max_sysex_size = midi2::ci::b28{256U},
+          .output_path_id = b7{output_path_id}};
+}
+
+/// Builds the reply that create_message() would produce for a request from \p remote.
+template <typename Content> std::vector<std::byte> expected_reply(std::uint32_t const remote, Content const& content) {
+  std::vector<std::byte> message;
+  midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{},
+                            midi2::ci::header{.device_id = b7{0x7FU},
+                                              .version = b7{2U},
+                                              .remote_muid = local_muid,
+                                              .local_muid = muid{remote}},
+                            content);
+  return message;
+}
+
+class CIDiscoveryResponder : public midi2::test::fake_clock_test {
+protected:
+  std::size_t flush() {
+    return responder_.flush(
+        [this](std::span<std::byte const> const bytes) { sent_.emplace_back(bytes.begin(), bytes.end()); });
+  }
+  std::size_t flush(limiter_type& port) {
+    return responder_.flush(
+        port, [this](std::span<std::byte const> const bytes) { sent_.emplace_back(bytes.begin(), bytes.end()); });
+  }
+
+  responder_type responder_{local_muid, reply};
+  std::vector<std::vector<std::byte>> sent_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, MatchesCreateMessage) {
+  EXPECT_TRUE(responder_.discovery(request_header(0x1111U), make_discovery(3)));
+  EXPECT_TRUE(responder_.discovery(request_header(0x2222U), make_discovery(5)));
+  EXPECT_EQ(this->flush(), 2U);
+  auto r1 = reply;
+  r1.output_path_id = b7{3U};
+  auto r2 = reply;
+  r2.output_path_id = b7{5U};
+  EXPECT_THAT(sent_, ElementsAre(expected_reply(0x1111U, r1), expected_reply(0x2222U, r2)));
+  EXPECT_EQ(responder_.pending(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, CoalescesWithinWindow) {
+  responder_.window(std::chrono::milliseconds{500});
+  EXPECT_TRUE(responder_.discovery(request_header(0x1111U), make_discovery(1)));
+  EXPECT_FALSE(responder_.discovery(request_header(0x1111U), make_discovery(1)));
+  EXPECT_EQ(this->flush(), 1U);
+  fake_clock::current += std::chrono::milliseconds{499};
+  EXPECT_FALSE(responder_.discovery(request_header(0x1111U), make_discovery(1)));
+  EXPECT_EQ(responder_.coalesced(), 2U);
+  fake_clock::current += std::chrono::milliseconds{1};
+  EXPECT_TRUE(responder_.discovery(request_header(0x1111U), make_discovery(1)));
+  EXPECT_EQ(this->flush(), 1U);
+  EXPECT_EQ(sent_.size(), 2U);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, ForgetsLeastRecentlySeen) {
+  responder_.window(std::chrono::milliseconds{500});
+  // Fill the four remembered entries, each a little later than the one before.
+  for (auto remote = 1U; remote <= 4U; ++remote) {
+    EXPECT_TRUE(responder_.discovery(request_header(remote), make_discovery(0)));
+    fake_clock::current += std::chrono::milliseconds{1};
+  }
+  EXPECT_EQ(this->flush(), 4U);
+  // A fifth remote MUID replaces the oldest entry: that of the first.
+  EXPECT_TRUE(responder_.discovery(request_header(5U), make_discovery(0)));
+  EXPECT_FALSE(responder_.discovery(request_header(2U), make_discovery(0)));
+  EXPECT_TRUE(responder_.discovery(request_header(1U), make_discovery(0)));
+  EXPECT_EQ(responder_.coalesced(), 1U);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, QueueFull) {
+  for (auto remote = 1U; remote <= 4U; ++remote) {
+    EXPECT_TRUE(responder_.discovery(request_header(remote), make_discovery(0)));
+  }
+  EXPECT_FALSE(responder_.discovery(request_header(5U), make_discovery(0)));
+  EXPECT_EQ(responder_.dropped(), 1U);
+  EXPECT_EQ(this->flush(), 4U);
+  // The dropped request was not remembered so a retry is answered.
+  EXPECT_TRUE(responder_.discovery(request_header(5U), make_discovery(0)));
+}
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, RateLimit) {
+  limiter_type port{std::chrono::milliseconds{10}, 2};
+  for (auto remote = 1U; remote <= 4U; ++remote) {
+    EXPECT_TRUE(responder_.discovery(request_header(remote), make_discovery(0)));
+  }
+  EXPECT_EQ(this->flush(port), 2U) << "A burst of two is permitted";
+  EXPECT_EQ(this->flush(port), 0U);
+  fake_clock::current += std::chrono::milliseconds{10};
+  EXPECT_EQ(this->flush(port), 1U);
+  fake_clock::current += std::chrono::milliseconds{5};
+  EXPECT_EQ(this->flush(port), 0U);
+  fake_clock::current += std::chrono::milliseconds{5};
+  EXPECT_EQ(this->flush(port), 1U);
+  EXPECT_EQ(responder_.pending(), 0U);
+  ASSERT_EQ(sent_.size(), 4U);
+  EXPECT_EQ(sent_[3], expected_reply(4U, reply));
+}
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, SharedPortLimit) {
+  // Two local identities served by the same port share its limit.
+  constexpr auto other_muid = muid{0x0654321U};
+  responder_type other{other_muid, reply};
+  limiter_type port{std::chrono::milliseconds{10}, 2};
+  for (auto remote = 1U; remote <= 2U; ++remote) {
+    EXPECT_TRUE(responder_.discovery(request_header(remote), make_discovery(0)));
+    EXPECT_TRUE(other.discovery(request_header(remote), make_discovery(0)));
+  }
+  auto const send_other = [this](std::span<std::byte const> const bytes) {
+    sent_.emplace_back(bytes.begin(), bytes.end());
+  };
+  EXPECT_EQ(this->flush(port), 2U) << "The first responder uses the whole burst";
+  EXPECT_EQ(other.flush(port, send_other), 0U);
+  fake_clock::current += std::chrono::milliseconds{10};
+  EXPECT_EQ(other.flush(port, send_other), 1U);
+  EXPECT_EQ(this->flush(port), 0U);
+  fake_clock::current += std::chrono::milliseconds{10};
+  EXPECT_EQ(other.flush(port, send_other), 1U);
+  EXPECT_EQ(other.pending(), 0U);
+  EXPECT_EQ(sent_.size(), 4U);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDiscoveryResponder, Endpoint) {
+  constexpr auto information = std::array{b7{0x41U}, b7{0x42U}, b7{0x43U}};
+  EXPECT_FALSE(responder_.endpoint(request_header(0x1111U), midi2::ci::endpoint{.status = b7{0U}}))
+      << "There is no endpoint reply yet";
+  EXPECT_TRUE(responder_.endpoint_reply(midi2::ci::endpoint_reply{.status = b7{0U}, .information = information}));
+  EXPECT_FALSE(responder_.endpoint(request_header(0x1111U), midi2::ci::endpoint{.status = b7{1U}}));
+  EXPECT_TRUE(responder_.endpoint(request_header(0x1111U), midi2::ci::endpoint{.status = b7{0U}}));
+  EXPECT_FALSE(responder_.endpoint(request_header(0x1111U), midi2::ci::endpoint{.status = b7{0U}}));
+  EXPECT_EQ(this->flush(), 1U);
+  EXPECT_THAT(sent_, ElementsAre(expected_reply(
+                         0x1111U, midi2::ci::endpoint_reply{.status = b7{0U}, .information = information})));
+
+  constexpr std::array<b7, 9> too_big{};
+  EXPECT_FALSE(responder_.endpoint_reply(midi2::ci::endpoint_reply{.status = b7{0U}, .information = too_big}));
+  EXPECT_FALSE(responder_.endpoint(request_header(0x1111U), midi2::ci::endpoint{.status = b7{0U}}));
+  EXPECT_EQ(responder_.pending(), 0U);
+}
+
+}  // end anonymous namespace
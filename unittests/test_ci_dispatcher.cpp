@@ -17,13 +17,18 @@
 #include "midi2/utils.hpp"
 
 // Standard library
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <ostream>
 #include <ranges>
 #include <span>
+#include <string>
+#include <tuple>
+#include <vector>
 
 // google mock/test/fuzz
 #include <gmock/gmock.h>
@@ -109,6 +114,7 @@ using testing::AllOf;
 using testing::ElementsAreArray;
 using testing::Eq;
 using testing::Field;
+using testing::InSequence;
 using testing::IsEmpty;
 using testing::Return;
 using testing::StrictMock;
@@ -201,6 +207,20 @@ public:
   MOCK_METHOD(void, midi_message_report_end, (context_type, header const&), (override));
 };
 
+class mock_property_exchange_stream_callbacks
+    : public midi2::ci::dispatcher_backend::property_exchange_stream_pure<context_type> {
+public:
+  MOCK_METHOD(void, begin,
+              (context_type, header const&, midi2::ci::property_exchange::stream_info const&, std::span<char const>),
+              (override));
+  MOCK_METHOD(void, data,
+              (context_type, header const&, midi2::ci::property_exchange::stream_info const&, std::span<char const>),
+              (override));
+  MOCK_METHOD(void, end, (context_type, header const&, midi2::ci::property_exchange::stream_info const&), (override));
+  MOCK_METHOD(void, abort, (context_type, header const&, midi2::ci::property_exchange::stream_info const&),
+              (override));
+};
+
 constexpr auto broadcast_muid = midi2::ci::broadcast_muid;
 
 class CIDispatcher : public testing::Test {
@@ -236,6 +256,17 @@ protected:
     auto const message = make_message(hdr, content);
     std::ranges::for_each(message, [this](std::byte const b) { processor_.dispatch(b); });
   }
+  /// Dispatches a message as two spans split at byte \p split.
+  template <typename Content>
+  void dispatch_ci_span(std::uint8_t group, header const& hdr, Content const& content, std::size_t split) {
+    processor_.set_group(group);
+    processor_.set_device_id(hdr.device_id);
+    auto const message = make_message(hdr, content);
+    auto const span = std::span{message};
+    split = std::min(split, span.size());
+    processor_.dispatch(span.first(split));
+    processor_.dispatch(span.subspan(split));
+  }
 };
 // NOLINTNEXTLINE
 TEST_F(CIDispatcher, Empty) {
@@ -274,6 +305,29 @@ TEST_F(CIDispatcher, DiscoveryV2) {
   this->dispatch_ci(0xFF_u8, hdr, discovery);
 }
 // NOLINTNEXTLINE
+TEST_F(CIDispatcher, ResetBetweenMessages) {
+  constexpr header hdr{.device_id = 0x7F_b7,
+                       .version = 2_b7,
+                       .remote_muid = midi2::ci::muid{0U},
+                       .local_muid = midi2::ci::broadcast_muid};
+  constexpr midi2::ci::discovery discovery{.manufacturer = std::array{0x12_b7, 0x23_b7, 0x34_b7},
+                                           .family = 0x1779_b14,
+                                           .model = 0x1B5D_b14,
+                                           .version = from_byte_array(std::array{0x4E_b, 0x3C_b, 0x2A_b, 0x18_b}),
+                                           .capability = 0x7F_b7,
+                                           .max_sysex_size = 0x07654321_b28,
+                                           .output_path_id = 0x71_b7};
+  EXPECT_CALL(config_.management, discovery(config_.context, hdr, discovery)).Times(2);
+  // A message which is cut short followed by two complete messages.
+  processor_.set_device_id(hdr.device_id);
+  auto const message = make_message(hdr, discovery);
+  processor_.dispatch(std::span{message}.first(8));
+  processor_.reset();
+  processor_.dispatch(message);
+  processor_.reset();
+  processor_.dispatch(message);
+}
+// NOLINTNEXTLINE
 TEST_F(CIDispatcher, DiscoveryReplyV2) {
   constexpr auto device_id = 0x7F_b7;
   constexpr auto manufacturer = std::array{0x12_b, 0x23_b, 0x34_b};
@@ -384,6 +438,36 @@ TEST_F(CIDispatcher, AckMessageTooLong) {
   this->dispatch_ci(group, hdr, ack);
 }
 // NOLINTNEXTLINE
+TEST_F(CIDispatcher, AckMessageTooLongSpan) {
+  constexpr auto group = 0x01_u8;
+  constexpr auto receiver_muid = midi2::ci::muid{0x012345EFU};
+
+  constexpr auto text_length = decltype(config_)::buffer_size;
+  std::vector<midi2::ci::b7> text{text_length, 'a'_b7};
+
+  constexpr header hdr{.device_id = 0x7F_b7, .version = 1_b7, .remote_muid = sender_muid_, .local_muid = receiver_muid};
+  midi2::ci::ack const ack{.original_id = 0x34_b7,
+                           .status_code = 0x17_b7,
+                           .status_data = 0x7F_b7,
+                           .details = std::array{0x01_b7, 0x02_b7, 0x03_b7, 0x04_b7, 0x05_b7},
+                           .message = text};
+
+  EXPECT_CALL(config_.system, check_muid(config_.context, group, receiver_muid)).WillRepeatedly(Return(true));
+  EXPECT_CALL(config_.system, buffer_overflow(config_.context)).Times(1);
+
+  this->dispatch_ci_span(group, hdr, ack, std::numeric_limits<std::size_t>::max());
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcher, UnknownMessageSpan) {
+  constexpr header hdr{
+      .device_id = 0x7F_b7, .version = 2_b7, .remote_muid = sender_muid_, .local_muid = destination_muid_};
+  auto message = make_message(hdr, midi2::ci::process_inquiry::capabilities{});
+  message[offsetof(midi2::ci::packed::header, sub_id_2)] = 0x7B_b;  // not a defined message type.
+  processor_.set_device_id(hdr.device_id);
+  EXPECT_CALL(config_.system, unknown_midici(config_.context, hdr)).Times(1);
+  processor_.dispatch(std::span{message});
+}
+// NOLINTNEXTLINE
 TEST_F(CIDispatcher, NakV1) {
   constexpr auto group = 0x01_u8;
   constexpr auto device_id = 0x7F_b7;
@@ -707,6 +791,34 @@ TEST_F(CIDispatcher, PropertyExchangeGetPropertyDataReply) {
   this->dispatch_ci(group, hdr, gr);
 }
 // NOLINTNEXTLINE
+TEST_F(CIDispatcher, PropertyExchangeGetPropertyDataReplySpan) {
+  constexpr auto group = 0x01_u8;
+
+  constexpr header hdr{
+      .device_id = 0x0F_b7,
+      .version = 2_b7,
+      .remote_muid = sender_muid_,
+      .local_muid = destination_muid_,
+  };
+  using get_reply = midi2::ci::property_exchange::get_reply;
+  constexpr get_reply gr{
+      .chunk = midi2::ci::property_exchange::chunk_info{2_b14, 1_b14},
+      .request = 3_b7,
+      .header = R"({"status":200})"sv,
+      .data = R"([{"resource":"DeviceInfo"},{"resource":"ChannelList"},{"resource":"CMList"}])"sv,
+  };
+  EXPECT_CALL(config_.system, check_muid(config_.context, group, destination_muid_)).WillRepeatedly(Return(true));
+  EXPECT_CALL(config_.property_exchange,
+              get_reply(config_.context, hdr,
+                        AllOf(Field("chunk", &get_reply::chunk, Eq(gr.chunk)),
+                              Field("request", &get_reply::request, Eq(gr.request)),
+                              Field("header", &get_reply::header, ElementsAreArray(gr.header)),
+                              Field("data", &get_reply::data, ElementsAreArray(gr.data)))));
+
+  // Split the message part way through the header data.
+  this->dispatch_ci_span(group, hdr, gr, 20);
+}
+// NOLINTNEXTLINE
 TEST_F(CIDispatcher, PropertyExchangeSetPropertyData) {
   constexpr auto group = 0x01_u8;
 
@@ -954,6 +1066,183 @@ TEST_F(CIDispatcher, ProcessInquiryMidiMessageReportEnd) {
   this->dispatch_ci(group, hdr, midi2::ci::process_inquiry::midi_message_report_end{});
 }
 
+class CIDispatcherStream : public testing::Test {
+public:
+  CIDispatcherStream() : processor_{config_} {}
+
+protected:
+  struct mocked_config {
+    [[no_unique_address]] context_type context;
+    // Large enough for the property exchange header but much smaller than the message data.
+    static constexpr auto buffer_size = std::size_t{32};
+    StrictMock<mock_system_callbacks> system;
+    StrictMock<mock_management_callbacks> management;
+    StrictMock<mock_profile_callbacks> profile;
+    StrictMock<mock_property_exchange_callbacks> property_exchange;
+    StrictMock<mock_property_exchange_stream_callbacks> property_exchange_stream;
+    StrictMock<mock_process_inquiry_callbacks> process_inquiry;
+  };
+  static_assert(midi2::ci::ci_dispatcher_stream_config<mocked_config>);
+  mocked_config config_;
+  midi2::ci::ci_dispatcher<std::reference_wrapper<mocked_config>> processor_;
+
+  static constexpr auto group_ = 0x01_u8;
+  static constexpr header hdr_{
+      .device_id = 0x0F_b7,
+      .version = 2_b7,
+      .remote_muid = midi2::ci::muid{from_le7(std::array{0x7F_b, 0x7E_b, 0x7D_b, 0x7C_b})},
+      .local_muid = midi2::ci::muid{from_le7(std::array{0x62_b, 0x16_b, 0x63_b, 0x26_b})},
+  };
+  static constexpr auto get_reply_ = midi2::ci::property_exchange::get_reply{
+      .chunk = midi2::ci::property_exchange::chunk_info{2_b14, 1_b14},
+      .request = 3_b7,
+      .header = R"({"status":200})"sv,
+      .data = R"([{"resource":"DeviceInfo"},{"resource":"ChannelList"},{"resource":"CMList"},{"resource":"X"}])"sv,
+  };
+  static constexpr auto info_ = midi2::ci::property_exchange::stream_info{
+      .type = midi2::ci::property_exchange::property_exchange_type::get_reply,
+      .chunk = get_reply_.chunk,
+      .request = get_reply_.request,
+      .data_length = midi2::ci::b14{static_cast<std::uint16_t>(get_reply_.data.size())},
+  };
+
+  static std::vector<std::byte> make_message(midi2::ci::property_exchange::get_reply const& content) {
+    std::vector<std::byte> message;
+    midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{}, hdr_, content);
+    message.push_back(0_b);  // a stray extra byte
+    return message;
+  }
+
+  /// Sets up the expected sequence of streaming callbacks and returns the string to which data fragments are
+  /// appended.
+  void expect_stream(std::string& data, std::size_t fragments) {
+    InSequence const seq;
+    EXPECT_CALL(config_.property_exchange_stream,
+                begin(config_.context, hdr_, info_, ElementsAreArray(get_reply_.header)))
+        .Times(1);
+    EXPECT_CALL(config_.property_exchange_stream, data(config_.context, hdr_, info_, testing::_))
+        .Times(static_cast<int>(fragments))
+        .WillRepeatedly([&data](context_type, header const&, midi2::ci::property_exchange::stream_info const&,
+                                std::span<char const> fragment) {
+          EXPECT_LE(fragment.size(), mocked_config::buffer_size);
+          data.append(fragment.begin(), fragment.end());
+        });
+    EXPECT_CALL(config_.property_exchange_stream, end(config_.context, hdr_, info_)).Times(1);
+  }
+};
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherStream, GetReplyByteAtATime) {
+  EXPECT_CALL(config_.system, check_muid(config_.context, group_, hdr_.local_muid)).WillRepeatedly(Return(true));
+  std::string data;
+  constexpr auto buffer_size = mocked_config::buffer_size;
+  this->expect_stream(data, (get_reply_.data.size() + buffer_size - 1) / buffer_size);
+
+  processor_.set_group(group_);
+  processor_.set_device_id(hdr_.device_id);
+  std::ranges::for_each(make_message(get_reply_), [this](std::byte const b) { processor_.dispatch(b); });
+  EXPECT_THAT(data, ElementsAreArray(get_reply_.data));
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherStream, GetReplySpan) {
+  EXPECT_CALL(config_.system, check_muid(config_.context, group_, hdr_.local_muid)).WillRepeatedly(Return(true));
+  std::string data;
+  // Splitting the message part way through the data does not change the fragments delivered: they are only passed
+  // to the backend once the buffer is full or the data is complete.
+  constexpr auto buffer_size = mocked_config::buffer_size;
+  this->expect_stream(data, (get_reply_.data.size() + buffer_size - 1) / buffer_size);
+
+  processor_.set_group(group_);
+  processor_.set_device_id(hdr_.device_id);
+  auto const message = make_message(get_reply_);
+  auto const span = std::span{message};
+  auto const split = span.size() - 40;
+  processor_.dispatch(span.first(split));
+  processor_.dispatch(span.subspan(split));
+  EXPECT_THAT(data, ElementsAreArray(get_reply_.data));
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherStream, NoData) {
+  EXPECT_CALL(config_.system, check_muid(config_.context, group_, hdr_.local_muid)).WillRepeatedly(Return(true));
+  auto const gr = midi2::ci::property_exchange::get_reply{
+      .chunk = get_reply_.chunk, .request = get_reply_.request, .header = get_reply_.header, .data = {}};
+  auto info = info_;
+  info.data_length = 0_b14;
+  InSequence const seq;
+  EXPECT_CALL(config_.property_exchange_stream, begin(config_.context, hdr_, info, ElementsAreArray(gr.header)))
+      .Times(1);
+  EXPECT_CALL(config_.property_exchange_stream, end(config_.context, hdr_, info)).Times(1);
+
+  processor_.set_group(group_);
+  processor_.set_device_id(hdr_.device_id);
+  auto const message = make_message(gr);
+  processor_.dispatch(std::span{message});
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherStream, TruncatedByReset) {
+  EXPECT_CALL(config_.system, check_muid(config_.context, group_, hdr_.local_muid)).WillRepeatedly(Return(true));
+  InSequence const seq;
+  EXPECT_CALL(config_.property_exchange_stream,
+              begin(config_.context, hdr_, info_, ElementsAreArray(get_reply_.header)))
+      .Times(1);
+  EXPECT_CALL(config_.property_exchange_stream, data(config_.context, hdr_, info_, testing::_))
+      .Times(testing::AtLeast(1));
+  EXPECT_CALL(config_.property_exchange_stream, abort(config_.context, hdr_, info_)).Times(1);
+
+  processor_.set_group(group_);
+  processor_.set_device_id(hdr_.device_id);
+  auto const message = make_message(get_reply_);
+  // Stop part way through the data. The backend is told that the rest of the message will not arrive.
+  processor_.dispatch(std::span{message}.first(message.size() - 40));
+  processor_.reset();
+  // There is no longer a stream to abort.
+  processor_.reset();
+}
+
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherStream, ProfileSpecificDataIsNotStreamed) {
+  EXPECT_CALL(config_.system, check_muid(config_.context, group_, hdr_.local_muid)).WillRepeatedly(Return(true));
+  using midi2::ci::profile_configuration::specific_data;
+  constexpr auto pid = midi2::ci::profile_configuration::profile{0x7E_b7, 0x11_b7, 0x22_b7, 0x33_b7, 0x44_b7};
+  // The buffer holds the profile ID, the data length, and up to buffer_size - 7 bytes of data.
+  std::array<midi2::ci::b7, mocked_config::buffer_size - 7> fits{};
+  std::ranges::fill(fits, 0x55_b7);
+  std::array<midi2::ci::b7, mocked_config::buffer_size - 6> too_long{};
+  InSequence const seq;
+  EXPECT_CALL(config_.profile, specific_data(config_.context, hdr_,
+                                             AllOf(Field("pid", &specific_data::pid, Eq(pid)),
+                                                   Field("data", &specific_data::data, ElementsAreArray(fits)))))
+      .Times(1);
+  EXPECT_CALL(config_.system, buffer_overflow(config_.context)).Times(1);
+
+  processor_.set_group(group_);
+  processor_.set_device_id(hdr_.device_id);
+  for (auto const& content : {specific_data{pid, fits}, specific_data{pid, too_long}}) {
+    std::vector<std::byte> message;
+    midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{}, hdr_, content);
+    processor_.reset();
+    processor_.dispatch(std::span{message});
+  }
+}
+// NOLINTNEXTLINE
+TEST(CIDispatcherCompact, CallsInstalledCallbacks) {
+  constexpr header hdr{.device_id = 0x7F_b7,
+                       .version = 2_b7,
+                       .remote_muid = midi2::ci::muid{0x10U},
+                       .local_muid = midi2::ci::broadcast_muid};
+  constexpr midi2::ci::invalidate_muid im{.target_muid = midi2::ci::muid{0x1234U}};
+  std::vector<std::byte> message;
+  midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{}, hdr, im);
+
+  auto dispatcher = midi2::ci::make_compact_dispatcher<int, 64>(0x7F_b7, 0, 5);
+  std::vector<std::tuple<int, header, midi2::ci::invalidate_muid>> calls;
+  dispatcher.config().management.on_invalidate_muid(
+      [&calls](int const context, header const& h, midi2::ci::invalidate_muid const& m) {
+        calls.emplace_back(context, h, m);
+      });
+  dispatcher.dispatch(std::span{message});
+  EXPECT_THAT(calls, testing::ElementsAre(std::tuple{5, hdr, im}));
+}
+
 // This test simply gets ci_dispatcher to consume a random buffer.
 void NeverCrashes(std::vector<std::byte> const& message) {
   // Ensure the top bit of each byte of the incoming message stream is clear.
@@ -968,16 +1257,35 @@ void NeverCrashes(std::vector<std::byte> const& message) {
   auto dispatcher = midi2::ci::make_function_dispatcher<empty, buffer_size>();
 
   dispatcher.config().system.on_check_muid([](empty, std::uint8_t, midi2::ci::muid) { return true; });
-  std::ranges::for_each(message2, std::bind_front(&decltype(dispatcher)::dispatch, &dispatcher));
+  std::ranges::for_each(message2, [&dispatcher](std::byte const b) { dispatcher.dispatch(b); });
+}
+
+// This test gets ci_dispatcher to consume a random buffer in two bulk calls.
+void SpanNeverCrashes(std::vector<std::byte> const& message, std::size_t split) {
+  struct empty {};
+  static constexpr auto buffer_size = std::size_t{64};
+  auto dispatcher = midi2::ci::make_function_dispatcher<empty, buffer_size>();
+  dispatcher.config().system.on_check_muid([](empty, std::uint8_t, midi2::ci::muid) { return true; });
+
+  auto const span = std::span{message};
+  split = std::min(split, span.size());
+  dispatcher.dispatch(span.first(split));
+  dispatcher.dispatch(span.subspan(split));
 }
 
 #if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
 // NOLINTNEXTLINE
 FUZZ_TEST(CIProcessorFuzz, NeverCrashes);
+// NOLINTNEXTLINE
+FUZZ_TEST(CIProcessorFuzz, SpanNeverCrashes);
 #endif
 // NOLINTNEXTLINE
 TEST(CIProcessorFuzz, Empty) {
   NeverCrashes({});
 }
+// NOLINTNEXTLINE
+TEST(CIProcessorFuzz, SpanEmpty) {
+  SpanNeverCrashes({}, 0);
+}
 
 }  // end anonymous namespace
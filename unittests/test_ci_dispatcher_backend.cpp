@@ -23,6 +23,7 @@ struct context_type {
   [[maybe_unused]] int value = 23;
 };
 
+using testing::ElementsAreArray;
 using testing::MockFunction;
 using testing::StrictMock;
 
@@ -322,6 +323,54 @@ TEST_F(CIDispatcherBackendPropertyExchange, Notify) {
   be_.notify(context_, hdr, notify);
 }
 
+class CIDispatcherBackendPropertyExchangeStream : public testing::Test {
+protected:
+  context_type context_;
+  midi2::ci::dispatcher_backend::property_exchange_stream_function<context_type> be_;
+};
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherBackendPropertyExchangeStream, Begin) {
+  StrictMock<MockFunction<decltype(be_)::begin_fn>> fn;
+  constexpr midi2::ci::header hdr;
+  constexpr midi2::ci::property_exchange::stream_info info;
+  constexpr auto pe_header = std::array{'{', '}'};
+  be_.begin(context_, hdr, info, pe_header);
+  be_.on_begin(fn.AsStdFunction());
+  EXPECT_CALL(fn, Call(context_, hdr, info, ElementsAreArray(pe_header))).Times(1);
+  be_.begin(context_, hdr, info, pe_header);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherBackendPropertyExchangeStream, Data) {
+  StrictMock<MockFunction<decltype(be_)::data_fn>> fn;
+  constexpr midi2::ci::header hdr;
+  constexpr midi2::ci::property_exchange::stream_info info;
+  constexpr auto fragment = std::array{'a', 'b', 'c'};
+  be_.data(context_, hdr, info, fragment);
+  be_.on_data(fn.AsStdFunction());
+  EXPECT_CALL(fn, Call(context_, hdr, info, ElementsAreArray(fragment))).Times(1);
+  be_.data(context_, hdr, info, fragment);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherBackendPropertyExchangeStream, End) {
+  StrictMock<MockFunction<decltype(be_)::end_fn>> fn;
+  constexpr midi2::ci::header hdr;
+  constexpr midi2::ci::property_exchange::stream_info info;
+  be_.end(context_, hdr, info);
+  be_.on_end(fn.AsStdFunction());
+  EXPECT_CALL(fn, Call(context_, hdr, info)).Times(1);
+  be_.end(context_, hdr, info);
+}
+// NOLINTNEXTLINE
+TEST_F(CIDispatcherBackendPropertyExchangeStream, Abort) {
+  StrictMock<MockFunction<decltype(be_)::abort_fn>> fn;
+  constexpr midi2::ci::header hdr;
+  constexpr midi2::ci::property_exchange::stream_info info;
+  be_.abort(context_, hdr, info);
+  be_.on_abort(fn.AsStdFunction());
+  EXPECT_CALL(fn, Call(context_, hdr, info)).Times(1);
+  be_.abort(context_, hdr, info);
+}
+
 class CIDispatcherBackendProcessInquiry : public testing::Test {
 protected:
   context_type context_;
@@ -0,0 +1,191 @@
+//===-- CI MUID Registry ------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_muid_registry.hpp"
+
+// MIDI2
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_dispatcher.hpp"
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <random>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
+#include <fuzztest/fuzztest.h>
+#endif
+
+namespace {
+
+using midi2::ci::muid;
+using testing::Optional;
+
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, InsertAndLookup) {
+  midi2::ci::muid_registry<16> registry;
+  EXPECT_TRUE(registry.empty());
+  EXPECT_TRUE(registry.insert(muid{0x1234U}, 3));
+  EXPECT_TRUE(registry.insert(muid{0x5678U}, 7));
+  EXPECT_FALSE(registry.insert(muid{0x1234U}, 4)) << "A MUID may only be registered once";
+  EXPECT_EQ(registry.size(), 2U);
+  EXPECT_THAT(registry.owner(muid{0x1234U}), Optional(3));
+  EXPECT_THAT(registry.owner(muid{0x5678U}), Optional(7));
+  EXPECT_EQ(registry.owner(muid{0x9ABCU}), std::nullopt);
+  EXPECT_TRUE(registry.check_muid(3, muid{0x1234U}));
+  EXPECT_FALSE(registry.check_muid(7, muid{0x1234U})) << "The MUID belongs to a different group";
+  EXPECT_FALSE(registry.check_muid(3, midi2::ci::broadcast_muid));
+}
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, Full) {
+  midi2::ci::muid_registry<8> registry;
+  for (auto m = 0U; m < registry.max_size(); ++m) {
+    EXPECT_TRUE(registry.insert(muid{m}, 0));
+  }
+  EXPECT_FALSE(registry.insert(muid{100U}, 0));
+  std::mt19937 gen{1};
+  EXPECT_EQ(registry.generate(0, gen), std::nullopt);
+  EXPECT_TRUE(registry.erase(muid{0U}).has_value());
+  EXPECT_TRUE(registry.insert(muid{100U}, 0));
+}
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, Invalidate) {
+  midi2::ci::muid_registry<16> registry;
+  EXPECT_TRUE(registry.insert(muid{0x1234U}, 5));
+  EXPECT_EQ(registry.invalidate(midi2::ci::invalidate_muid{.target_muid = muid{0x4321U}}), std::nullopt);
+  EXPECT_THAT(registry.invalidate(midi2::ci::invalidate_muid{.target_muid = muid{0x1234U}}), Optional(5));
+  EXPECT_FALSE(registry.contains(muid{0x1234U}));
+  EXPECT_TRUE(registry.empty());
+}
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, Generate) {
+  midi2::ci::muid_registry<256> registry;
+  std::mt19937 gen{42};
+  for (auto group = std::uint8_t{0}; group < 16U; ++group) {
+    auto const m = registry.generate(group, gen);
+    ASSERT_TRUE(m.has_value());
+    EXPECT_LE(*m, midi2::ci::max_user_muid);
+    EXPECT_THAT(registry.owner(*m), Optional(group));
+  }
+  EXPECT_EQ(registry.size(), 16U);
+}
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, GenerateDetectsCollisions) {
+  // A "random" generator that always produces the same value.
+  struct constant_generator {
+    using result_type = std::uint32_t;
+    static constexpr result_type min() noexcept { return 0U; }
+    static constexpr result_type max() noexcept { return 0xFFFFFFFFU; }
+    constexpr result_type operator()() const noexcept { return 0x12345678U; }
+  };
+  midi2::ci::muid_registry<16> registry;
+  constant_generator gen;
+  auto const m = registry.generate(1, gen);
+  ASSERT_TRUE(m.has_value());
+  EXPECT_EQ(registry.generate(1, gen), std::nullopt);
+  EXPECT_EQ(registry.collisions(), registry.generate_attempts);
+  EXPECT_EQ(registry.size(), 1U);
+}
+
+/// Performs a sequence of insertions and deletions on both the registry and a std::map and checks that they agree.
+/// Each value encodes an operation: the top bit selects erase or insert, the next four bits the group, and the
+/// remainder a MUID drawn from a small range so that probe sequences overlap.
+void MatchesMap(std::vector<std::uint16_t> const& ops) {
+  midi2::ci::muid_registry<64> registry;
+  std::map<std::uint32_t, std::uint8_t> expected;
+  for (auto const op : ops) {
+    auto const m = muid{op & 0x7FFU};
+    auto const group = static_cast<std::uint8_t>((op >> 11U) & 0x0FU);
+    if ((op & 0x8000U) != 0U) {
+      auto const erased = registry.erase(m);
+      auto const pos = expected.find(m.get());
+      EXPECT_EQ(erased.has_value(), pos != expected.end());
+      if (pos != expected.end()) {
+        EXPECT_EQ(*erased, pos->second);
+        expected.erase(pos);
+      }
+    } else if (expected.size() < registry.max_size()) {
+      EXPECT_EQ(registry.insert(m, group), expected.try_emplace(m.get(), group).second);
+    }
+    ASSERT_EQ(registry.size(), expected.size());
+  }
+  for (auto m = 0U; m <= 0x7FFU; ++m) {
+    auto const pos = expected.find(m);
+    EXPECT_EQ(registry.owner(muid{m}), pos == expected.end() ? std::nullopt : std::optional{pos->second});
+  }
+}
+#if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
+// NOLINTNEXTLINE
+FUZZ_TEST(CIMuidRegistry, MatchesMap);
+#endif
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, MatchesMap) {
+  std::mt19937 gen{7};
+  std::uniform_int_distribution<std::uint16_t> dist;
+  std::vector<std::uint16_t> ops;
+  for (auto ctr = 0; ctr < 2000; ++ctr) {
+    // Keep the MUIDs in a tiny range so that the table is busy and probe sequences wrap.
+    ops.push_back(static_cast<std::uint16_t>(dist(gen) & 0xF83FU));
+  }
+  MatchesMap(ops);
+}
+
+using registry_type = midi2::ci::muid_registry<16>;
+struct registry_config {
+  int context = 0;
+  static constexpr auto buffer_size = std::size_t{64};
+  midi2::ci::dispatcher_backend::system_muid_registry<int, registry_type> system;
+  midi2::ci::dispatcher_backend::management_function<int> management{};
+  midi2::ci::dispatcher_backend::profile_null<int> profile{};
+  midi2::ci::dispatcher_backend::property_exchange_null<int> property_exchange{};
+  midi2::ci::dispatcher_backend::process_inquiry_null<int> process_inquiry{};
+};
+
+// NOLINTNEXTLINE
+TEST(CIMuidRegistry, DispatcherSystemBackend) {
+  registry_type registry;
+  constexpr auto local = muid{0x0ABCDEFU};
+  ASSERT_TRUE(registry.insert(local, 2));
+
+  auto calls = 0U;
+  registry_config c{.context = 0,
+                    .system = midi2::ci::dispatcher_backend::system_muid_registry<int, registry_type>{registry}};
+  c.management.on_invalidate_muid([&calls](int, midi2::ci::header const&, midi2::ci::invalidate_muid const&) {
+    ++calls;
+  });
+
+  auto const send = [&c](std::uint8_t const group, muid const destination) {
+    midi2::ci::ci_dispatcher dispatcher{midi2::ci::b7{0x7FU}, group, std::ref(c)};
+    std::vector<std::byte> message;
+    midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{},
+                              midi2::ci::header{.device_id = midi2::ci::b7{0x7FU},
+                                                .version = midi2::ci::b7{2U},
+                                                .remote_muid = muid{0x1U},
+                                                .local_muid = destination},
+                              midi2::ci::invalidate_muid{.target_muid = muid{0x2U}});
+    dispatcher.dispatch(message);
+  };
+  send(2, local);
+  EXPECT_EQ(calls, 1U);
+  send(3, local);  // The wrong group.
+  send(2, muid{0x1234U});  // An unknown MUID.
+  EXPECT_EQ(calls, 1U);
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,198 @@
+//===-- CI Profile Registry ---------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_profile_registry.hpp"
+
+// MIDI2
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_dispatcher.hpp"
+
+// Standard library
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using midi2::ci::b7;
+using midi2::ci::muid;
+using profile = midi2::ci::profile_configuration::profile;
+using testing::ElementsAreArray;
+
+using registry_type = midi2::ci::profile_registry<70, 16>;
+
+constexpr auto pid_a = profile{b7{0x7EU}, b7{0x01U}, b7{0x02U}, b7{0x03U}, b7{0x04U}};
+constexpr auto pid_b = profile{b7{0x7EU}, b7{0x11U}, b7{0x12U}, b7{0x13U}, b7{0x14U}};
+constexpr auto pid_c = profile{b7{0x7EU}, b7{0x21U}, b7{0x22U}, b7{0x23U}, b7{0x24U}};
+
+constexpr midi2::ci::header reply_header(b7 const destination) {
+  return {.device_id = destination, .version = b7{2U}, .remote_muid = muid{0x0123456U}, .local_muid = muid{0x10U}};
+}
+
+std::vector<std::byte> expected_reply(b7 const destination, std::span<profile const> const enabled,
+                                      std::span<profile const> const disabled) {
+  std::vector<std::byte> message;
+  midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{}, reply_header(destination),
+                            midi2::ci::profile_configuration::inquiry_reply{.enabled = enabled, .disabled = disabled});
+  return message;
+}
+
+std::vector<std::byte> actual_reply(registry_type const& registry, std::uint8_t const group, b7 const destination) {
+  std::vector<std::byte> message;
+  // The reply takes its device ID from the destination rather than from the header.
+  registry.inquiry_reply(std::back_inserter(message), midi2::ci::trivial_sentinel{}, group, destination,
+                         reply_header(registry_type::function_block_destination));
+  return message;
+}
+
+// NOLINTNEXTLINE
+TEST(CIProfileRegistry, InquiryReply) {
+  registry_type registry;
+  EXPECT_TRUE(registry.add(0, b7{0U}, pid_a));
+  EXPECT_TRUE(registry.add(0, b7{0U}, pid_b));
+  EXPECT_TRUE(registry.add(0, b7{0U}, pid_c));
+  EXPECT_TRUE(registry.add(3, registry_type::group_destination, pid_b));
+  EXPECT_TRUE(registry.add(3, registry_type::function_block_destination, pid_c));
+  EXPECT_FALSE(registry.add(16, b7{0U}, pid_a)) << "There are only 16 groups";
+  EXPECT_FALSE(registry.add(0, b7{0x20U}, pid_a)) << "Not a channel, group, or function block";
+
+  EXPECT_TRUE(registry.on(0, b7{0U}, {.pid = pid_b, .num_channels = midi2::ci::b14{1U}}));
+  EXPECT_FALSE(registry.on(0, b7{0U}, {.pid = pid_b, .num_channels = midi2::ci::b14{1U}}))
+      << "Already on";
+  EXPECT_FALSE(registry.on(0, b7{1U}, {.pid = pid_b, .num_channels = midi2::ci::b14{1U}}))
+      << "Not supported on channel 1";
+  EXPECT_TRUE(registry.enabled(0, b7{0U}, pid_b));
+  EXPECT_FALSE(registry.enabled(0, b7{1U}, pid_b));
+
+  EXPECT_EQ(actual_reply(registry, 0, b7{0U}),
+            expected_reply(b7{0U}, std::vector<profile>{pid_b}, std::vector<profile>{pid_a, pid_c}));
+  EXPECT_EQ(actual_reply(registry, 0, b7{1U}), expected_reply(b7{1U}, {}, {}));
+  EXPECT_EQ(actual_reply(registry, 3, registry_type::group_destination),
+            expected_reply(registry_type::group_destination, {}, std::vector<profile>{pid_b}));
+  EXPECT_EQ(actual_reply(registry, 7, registry_type::function_block_destination),
+            expected_reply(registry_type::function_block_destination, {}, std::vector<profile>{pid_c}));
+
+  EXPECT_TRUE(registry.off(0, b7{0U}, {.pid = pid_b}));
+  EXPECT_FALSE(registry.off(0, b7{0U}, {.pid = pid_b}));
+  EXPECT_EQ(actual_reply(registry, 0, b7{0U}),
+            expected_reply(b7{0U}, {}, std::vector<profile>{pid_a, pid_b, pid_c}));
+}
+// NOLINTNEXTLINE
+TEST(CIProfileRegistry, RemoveReleasesIndex) {
+  registry_type registry;
+  EXPECT_TRUE(registry.add(0, b7{0U}, pid_a));
+  EXPECT_TRUE(registry.add(0, b7{0U}, pid_b));
+  EXPECT_TRUE(registry.add(1, b7{2U}, pid_c));
+  EXPECT_TRUE(registry.set(1, b7{2U}, pid_c, true));
+  EXPECT_TRUE(registry.remove(0, b7{0U}, pid_a));
+  EXPECT_FALSE(registry.remove(0, b7{0U}, pid_a));
+  // pid_c moved into pid_a's index: its state must have moved with it.
+  EXPECT_TRUE(registry.enabled(1, b7{2U}, pid_c));
+  EXPECT_FALSE(registry.supported(0, b7{0U}, pid_c));
+  EXPECT_TRUE(registry.supported(0, b7{0U}, pid_b));
+  EXPECT_EQ(actual_reply(registry, 1, b7{2U}), expected_reply(b7{2U}, std::vector<profile>{pid_c}, {}));
+}
+// NOLINTNEXTLINE
+TEST(CIProfileRegistry, ManyProfiles) {
+  // More than 64 profiles spans multiple words of each bitset.
+  registry_type registry;
+  std::vector<profile> enabled;
+  std::vector<profile> disabled;
+  for (auto index = 0U; index < 70U; ++index) {
+    auto const pid = profile{b7{0x7EU}, b7{static_cast<std::uint8_t>(index)}, b7{0U}, b7{0U}, b7{0U}};
+    EXPECT_TRUE(registry.add(15, b7{15U}, pid));
+    if (index % 3U == 0U) {
+      EXPECT_TRUE(registry.set(15, b7{15U}, pid, true));
+      enabled.push_back(pid);
+    } else {
+      disabled.push_back(pid);
+    }
+  }
+  EXPECT_FALSE(registry.add(15, b7{15U}, profile{})) << "The registry is full";
+  EXPECT_EQ(actual_reply(registry, 15, b7{15U}), expected_reply(b7{15U}, enabled, disabled));
+}
+// NOLINTNEXTLINE
+TEST(CIProfileRegistry, InsufficientSpace) {
+  registry_type registry;
+  EXPECT_TRUE(registry.add(0, b7{0U}, pid_a));
+  std::array<std::byte, 19> buffer{};
+  EXPECT_EQ(registry.inquiry_reply(buffer.begin(), buffer.end(), 0, b7{0U}, reply_header(b7{0U})), buffer.end());
+  std::array<std::byte, 23> large{};
+  auto const expected = expected_reply(b7{0U}, {}, std::vector<profile>{pid_a});
+  auto const end = registry.inquiry_reply(large.begin(), large.end(), 0, b7{0U}, reply_header(b7{0U}));
+  EXPECT_THAT(std::span(large.begin(), end), ElementsAreArray(expected));
+}
+// NOLINTNEXTLINE
+TEST(CIProfileRegistry, ThroughDispatcher) {
+  // The dispatcher reports its own device ID, so it is set to that of each message before the message is dispatched.
+  registry_type registry;
+  EXPECT_TRUE(registry.add(2, b7{0U}, pid_a));
+  EXPECT_TRUE(registry.add(2, b7{5U}, pid_a));
+  EXPECT_TRUE(registry.add(2, registry_type::group_destination, pid_b));
+  EXPECT_TRUE(registry.add(2, registry_type::function_block_destination, pid_c));
+
+  constexpr auto group = std::uint8_t{2};
+  std::vector<std::byte> reply;
+  auto dispatcher = midi2::ci::make_function_dispatcher<std::uint8_t, 256>(registry_type::function_block_destination,
+                                                                           group, std::uint8_t{group});
+  auto& config = dispatcher.config();
+  config.system.on_check_muid([](std::uint8_t, std::uint8_t, muid) { return true; });
+  config.profile.on_on([&registry](std::uint8_t const g, midi2::ci::header const& h,
+                                   midi2::ci::profile_configuration::on const& on) {
+    registry.on(g, h.device_id, on);
+  });
+  config.profile.on_off([&registry](std::uint8_t const g, midi2::ci::header const& h,
+                                    midi2::ci::profile_configuration::off const& off) {
+    registry.off(g, h.device_id, off);
+  });
+  config.profile.on_inquiry([&registry, &reply](std::uint8_t const g, midi2::ci::header const& h) {
+    reply.clear();
+    registry.inquiry_reply(std::back_inserter(reply), midi2::ci::trivial_sentinel{}, g, h.device_id,
+                           reply_header(h.device_id));
+  });
+
+  auto const send = [&dispatcher](b7 const destination, auto const& message) {
+    auto const hdr = midi2::ci::header{
+        .device_id = destination, .version = b7{2U}, .remote_muid = muid{0x10U}, .local_muid = muid{0x0123456U}};
+    std::vector<std::byte> bytes;
+    midi2::ci::create_message(std::back_inserter(bytes), midi2::ci::trivial_sentinel{}, hdr, message);
+    dispatcher.reset();
+    dispatcher.set_device_id(destination);
+    dispatcher.dispatch(std::span<std::byte const>{bytes});
+  };
+  send(b7{5U}, midi2::ci::profile_configuration::on{.pid = pid_a, .num_channels = midi2::ci::b14{1U}});
+  send(registry_type::group_destination,
+       midi2::ci::profile_configuration::on{.pid = pid_b, .num_channels = midi2::ci::b14{0U}});
+  EXPECT_FALSE(registry.enabled(group, b7{0U}, pid_a));
+  EXPECT_TRUE(registry.enabled(group, b7{5U}, pid_a));
+  EXPECT_TRUE(registry.enabled(group, registry_type::group_destination, pid_b));
+  EXPECT_FALSE(registry.enabled(group, registry_type::function_block_destination, pid_c));
+
+  send(b7{5U}, midi2::ci::profile_configuration::inquiry{});
+  EXPECT_EQ(reply, expected_reply(b7{5U}, std::vector<profile>{pid_a}, {}));
+  send(b7{0U}, midi2::ci::profile_configuration::inquiry{});
+  EXPECT_EQ(reply, expected_reply(b7{0U}, {}, std::vector<profile>{pid_a}));
+  send(registry_type::function_block_destination, midi2::ci::profile_configuration::inquiry{});
+  EXPECT_EQ(reply, expected_reply(registry_type::function_block_destination, {}, std::vector<profile>{pid_c}));
+
+  send(registry_type::group_destination, midi2::ci::profile_configuration::off{.pid = pid_b});
+  EXPECT_FALSE(registry.enabled(group, registry_type::group_destination, pid_b));
+  EXPECT_TRUE(registry.enabled(group, b7{5U}, pid_a));
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,158 @@
+//===-- CI Property Cache -----------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_property_cache.hpp"
+
+// Standard library
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using midi2::ci::b7;
+using midi2::ci::muid;
+using testing::Optional;
+using namespace std::string_view_literals;
+
+using cache_type = midi2::ci::property_cache<4, 2, 64, 32>;
+
+constexpr midi2::ci::header from(std::uint32_t const remote) {
+  return {.device_id = b7{0x7FU}, .version = b7{2U}, .remote_muid = muid{remote}, .local_muid = muid{0x0123456U}};
+}
+
+std::string_view as_string(std::span<char const> const s) {
+  return std::string_view{s.data(), s.size()};
+}
+
+// NOLINTNEXTLINE
+TEST(CIPropertyCacheHeader, FindHeaderString) {
+  using midi2::ci::details::find_header_string;
+  EXPECT_THAT(find_header_string(R"({"status":200,"subscribeId":"ab12"})", "subscribeId"), Optional("ab12"sv));
+  EXPECT_THAT(find_header_string(R"({ "resource" : "DeviceInfo" })", "resource"), Optional("DeviceInfo"sv));
+  EXPECT_THAT(find_header_string(R"({"resId":"x","resource":"R"})", "res"), std::nullopt);
+  EXPECT_THAT(find_header_string(R"({"xresource":"A","resource":"B"})", "resource"), Optional("B"sv));
+  EXPECT_THAT(find_header_string(R"({"resource":7})", "resource"), std::nullopt);
+  EXPECT_THAT(find_header_string(R"({"resource":"unterminated)", "resource"), std::nullopt);
+}
+
+class CIPropertyCache : public testing::Test {
+protected:
+  cache_type cache_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CIPropertyCache, StoreAndFind) {
+  EXPECT_EQ(cache_.find(muid{1U}, "DeviceInfo", ""), std::nullopt);
+  EXPECT_TRUE(cache_.store(muid{1U}, "DeviceInfo", "", R"({"status":200})"sv, R"({"model":"x"})"sv));
+  EXPECT_TRUE(cache_.store(muid{1U}, "ChCtrlList", "3", R"({"status":200})"sv, "[]"sv));
+  auto const r = cache_.find(muid{1U}, "DeviceInfo", "");
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(as_string(r->header), R"({"status":200})");
+  EXPECT_EQ(as_string(r->data), R"({"model":"x"})");
+  EXPECT_EQ(cache_.find(muid{2U}, "DeviceInfo", ""), std::nullopt) << "A different device";
+  EXPECT_EQ(cache_.find(muid{1U}, "ChCtrlList", ""), std::nullopt) << "A different resId";
+  EXPECT_TRUE(cache_.find(muid{1U}, "ChCtrlList", "3").has_value());
+  EXPECT_EQ(cache_.hits(), 2U);
+  EXPECT_EQ(cache_.misses(), 3U);
+
+  // Storing again replaces the cached reply.
+  EXPECT_TRUE(cache_.store(muid{1U}, "DeviceInfo", "", "{}"sv, "1"sv));
+  EXPECT_EQ(as_string(cache_.find(muid{1U}, "DeviceInfo", "")->data), "1");
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyCache, TooLarge) {
+  EXPECT_FALSE(cache_.store(muid{1U}, "R", "", "{}"sv, std::string(63, 'x')));
+  EXPECT_FALSE(cache_.store(muid{1U}, std::string(40, 'R'), "", "{}"sv, "1"sv));
+  EXPECT_EQ(cache_.find(muid{1U}, "R", ""), std::nullopt);
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyCache, InvalidateMuid) {
+  EXPECT_TRUE(cache_.store(muid{1U}, "A", "", "{}"sv, "1"sv));
+  EXPECT_TRUE(cache_.store(muid{1U}, "B", "", "{}"sv, "2"sv));
+  EXPECT_TRUE(cache_.store(muid{2U}, "A", "", "{}"sv, "3"sv));
+  EXPECT_TRUE(cache_.invalidate(muid{2U}, "A", ""));
+  EXPECT_FALSE(cache_.invalidate(muid{2U}, "A", ""));
+  EXPECT_EQ(cache_.invalidate(from(9U), midi2::ci::invalidate_muid{.target_muid = muid{1U}}), 2U);
+  EXPECT_EQ(cache_.find(muid{1U}, "A", ""), std::nullopt);
+  EXPECT_EQ(cache_.find(muid{1U}, "B", ""), std::nullopt);
+  EXPECT_EQ(cache_.find(muid{2U}, "A", ""), std::nullopt);
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyCache, SubscriptionInvalidates) {
+  EXPECT_TRUE(cache_.store(muid{1U}, "A", "", "{}"sv, "1"sv));
+  EXPECT_TRUE(cache_.store(muid{1U}, "B", "", "{}"sv, "2"sv));
+  EXPECT_FALSE(cache_.subscribe(muid{1U}, "C", "", "s1"));
+  EXPECT_TRUE(cache_.subscribe(muid{1U}, "A", "", "s1"));
+  EXPECT_TRUE(cache_.subscribe(muid{1U}, "B", "", "s2"));
+
+  constexpr auto header = R"({"command":"partial","subscribeId":"s1"})"sv;
+  auto const update = midi2::ci::property_exchange::subscription{
+      .chunk = {.number_of_chunks = midi2::ci::b14{1U}, .chunk_number = midi2::ci::b14{1U}},
+      .request = b7{0U},
+      .header = header,
+      .data = "{}"sv};
+  EXPECT_EQ(cache_.changed(from(2U), update), 0U) << "The same subscribeId from a different device";
+  EXPECT_EQ(cache_.changed(from(1U), update), 1U);
+  EXPECT_EQ(cache_.find(muid{1U}, "A", ""), std::nullopt);
+  EXPECT_TRUE(cache_.find(muid{1U}, "B", "").has_value());
+
+  constexpr auto end = R"({"command":"end","subscribeId":"s2"})"sv;
+  EXPECT_EQ(cache_.changed(from(1U), midi2::ci::property_exchange::notify{
+                                         .chunk = {.number_of_chunks = midi2::ci::b14{1U},
+                                                   .chunk_number = midi2::ci::b14{1U}},
+                                         .request = b7{0U},
+                                         .header = end,
+                                         .data = {}}),
+            1U);
+  EXPECT_EQ(cache_.find(muid{1U}, "B", ""), std::nullopt);
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyCache, RefetchKeepsSubscription) {
+  auto const update = midi2::ci::property_exchange::subscription{
+      .chunk = {.number_of_chunks = midi2::ci::b14{1U}, .chunk_number = midi2::ci::b14{1U}},
+      .request = b7{0U},
+      .header = R"({"command":"partial","subscribeId":"s1"})"sv,
+      .data = "{}"sv};
+  EXPECT_TRUE(cache_.store(muid{1U}, "A", "", "{}"sv, "1"sv));
+  EXPECT_TRUE(cache_.subscribe(muid{1U}, "A", "", "s1"));
+  EXPECT_EQ(cache_.changed(from(1U), update), 1U);
+  // The application fetches the property again. The subscription is still in force so a later update must
+  // invalidate the new reply.
+  EXPECT_TRUE(cache_.store(muid{1U}, "A", "", "{}"sv, "2"sv));
+  EXPECT_EQ(as_string(cache_.find(muid{1U}, "A", "")->data), "2");
+  EXPECT_EQ(cache_.changed(from(1U), update), 1U);
+  EXPECT_EQ(cache_.find(muid{1U}, "A", ""), std::nullopt);
+}
+// NOLINTNEXTLINE
+TEST_F(CIPropertyCache, Eviction) {
+  // Fill the cache well beyond its capacity. Every lookup must return either nothing or the right value.
+  for (auto index = 0U; index < 3U * cache_.max_size(); ++index) {
+    auto const value = std::to_string(index);
+    EXPECT_TRUE(cache_.store(muid{index}, "R", "", "{}"sv, value));
+  }
+  auto found = 0U;
+  for (auto index = 0U; index < 3U * cache_.max_size(); ++index) {
+    if (auto const r = cache_.find(muid{index}, "R", "")) {
+      EXPECT_EQ(as_string(r->data), std::to_string(index));
+      ++found;
+    }
+  }
+  EXPECT_GT(found, 0U);
+  EXPECT_LE(found, cache_.max_size());
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,265 @@
+//===-- CI Property Exchange Assembler ----------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_property_exchange_assembler.hpp"
+
+// Standard library
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+// Test helpers
+#include "fake_clock.hpp"
+
+namespace {
+
+using namespace std::string_view_literals;
+using midi2::test::fake_clock;
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+using context_type = int;
+
+struct reply {
+  bool operator==(reply const&) const = default;
+  midi2::ci::muid muid;
+  std::uint8_t request;
+  std::string header;
+  std::string data;
+};
+
+template <std::size_t Requests = 4, std::size_t PoolSize = 256>
+using assembler = midi2::ci::dispatcher_backend::property_exchange_assembler<
+    context_type, midi2::ci::dispatcher_backend::property_exchange_function<context_type>, Requests, PoolSize,
+    fake_clock>;
+
+template <std::size_t Requests, std::size_t PoolSize>
+class PropertyExchangeAssemblerBase : public midi2::test::fake_clock_test {
+protected:
+  using assembler_type = assembler<Requests, PoolSize>;
+  using error = typename assembler_type::error;
+
+  PropertyExchangeAssemblerBase() {
+    assembler_.timeout(std::chrono::milliseconds{100});
+    assembler_.backend().on_get_reply([this](context_type, midi2::ci::header const& h,
+                                             midi2::ci::property_exchange::get_reply const& r) {
+      EXPECT_EQ(r.chunk.number_of_chunks, midi2::ci::b14{1U});
+      EXPECT_EQ(r.chunk.chunk_number, midi2::ci::b14{1U});
+      replies_.push_back(reply{h.remote_muid, static_cast<std::uint8_t>(r.request.get()),
+                               std::string{r.header.begin(), r.header.end()},
+                               std::string{r.data.begin(), r.data.end()}});
+    });
+    assembler_.on_error([this](midi2::ci::header const& h, midi2::ci::b7 const request, error const err) {
+      errors_.emplace_back(h.remote_muid, static_cast<std::uint8_t>(request.get()), err);
+    });
+  }
+
+  static midi2::ci::header make_header(midi2::ci::muid const muid) {
+    midi2::ci::header h;
+    h.remote_muid = muid;
+    return h;
+  }
+  void chunk(midi2::ci::muid const muid, unsigned const request, unsigned const number_of_chunks,
+             unsigned const chunk_number, std::string_view const header, std::string_view const data) {
+    assembler_.get_reply(0, make_header(muid),
+                         midi2::ci::property_exchange::get_reply::make(
+                             {.number_of_chunks = midi2::ci::b14{number_of_chunks},
+                              .chunk_number = midi2::ci::b14{chunk_number}},
+                             midi2::ci::b7{request}, header, data));
+  }
+
+  assembler_type assembler_;
+  std::vector<reply> replies_;
+  std::vector<std::tuple<midi2::ci::muid, std::uint8_t, error>> errors_;
+};
+
+using PropertyExchangeAssembler = PropertyExchangeAssemblerBase<4, 256>;
+
+constexpr auto muid1 = midi2::ci::muid{0x1234U};
+constexpr auto muid2 = midi2::ci::muid{0x5678U};
+
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, SingleChunkIsForwarded) {
+  this->chunk(muid1, 1, 1, 1, R"({"status":200})"sv, "[]"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid1, 1, R"({"status":200})", "[]"}));
+  EXPECT_THAT(errors_, IsEmpty());
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, MultipleChunks) {
+  this->chunk(muid1, 2, 3, 1, "{}"sv, "[{\"res\""sv);
+  this->chunk(muid1, 2, 3, 2, ""sv, ":\"DeviceInfo\"}"sv);
+  EXPECT_THAT(replies_, IsEmpty());
+  EXPECT_EQ(assembler_.in_flight(), 1U);
+  this->chunk(muid1, 2, 3, 3, ""sv, "]"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid1, 2, "{}", R"([{"res":"DeviceInfo"}])"}));
+  EXPECT_THAT(errors_, IsEmpty());
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, UnknownNumberOfChunks) {
+  // The final chunk is marked by number_of_chunks being equal to its chunk_number.
+  this->chunk(muid1, 2, 0, 1, "{}"sv, "[{\"res\""sv);
+  this->chunk(muid1, 2, 0, 2, ""sv, ":\"DeviceInfo\"}"sv);
+  EXPECT_THAT(replies_, IsEmpty());
+  EXPECT_EQ(assembler_.in_flight(), 1U);
+  this->chunk(muid1, 2, 3, 3, ""sv, "]"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid1, 2, "{}", R"([{"res":"DeviceInfo"}])"}));
+  EXPECT_THAT(errors_, IsEmpty());
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, UnknownNumberOfChunksMissingChunk) {
+  this->chunk(muid1, 1, 0, 1, "{}"sv, "a"sv);
+  this->chunk(muid1, 1, 3, 3, ""sv, "c"sv);
+  EXPECT_THAT(replies_, IsEmpty());
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::missing_chunk}));
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, InterleavedRequests) {
+  // Two devices using the same request ID and a second request from the first device.
+  this->chunk(muid1, 1, 2, 1, "h1"sv, "a"sv);
+  this->chunk(muid2, 1, 3, 1, "h2"sv, "b"sv);
+  this->chunk(muid1, 2, 2, 1, "h3"sv, "c"sv);
+  this->chunk(muid2, 1, 3, 2, ""sv, "d"sv);
+  this->chunk(muid1, 1, 2, 2, ""sv, "e"sv);
+  this->chunk(muid1, 2, 2, 2, ""sv, "f"sv);
+  this->chunk(muid2, 1, 3, 3, ""sv, "g"sv);
+  EXPECT_THAT(replies_,
+              ElementsAre(reply{muid1, 1, "h1", "ae"}, reply{muid1, 2, "h3", "cf"}, reply{muid2, 1, "h2", "bdg"}));
+  EXPECT_THAT(errors_, IsEmpty());
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, MissingChunk) {
+  this->chunk(muid1, 1, 3, 1, "{}"sv, "a"sv);
+  this->chunk(muid1, 1, 3, 3, ""sv, "c"sv);
+  EXPECT_THAT(replies_, IsEmpty());
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::missing_chunk}));
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, ContinuationWithoutStart) {
+  this->chunk(muid1, 1, 3, 2, ""sv, "b"sv);
+  EXPECT_THAT(replies_, IsEmpty());
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::missing_chunk}));
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, RepeatedChunk) {
+  this->chunk(muid1, 1, 3, 1, "{}"sv, "a"sv);
+  this->chunk(muid1, 1, 3, 2, ""sv, "b"sv);
+  this->chunk(muid1, 1, 3, 2, ""sv, "b"sv);
+  EXPECT_THAT(replies_, IsEmpty());
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::out_of_order}));
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, Restart) {
+  this->chunk(muid1, 1, 3, 1, "{}"sv, "a"sv);
+  this->chunk(muid1, 1, 2, 1, "{}"sv, "x"sv);
+  this->chunk(muid1, 1, 2, 2, ""sv, "y"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid1, 1, "{}", "xy"}));
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::out_of_order}));
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, TableFull) {
+  for (auto request = 0U; request < 5U; ++request) {
+    this->chunk(muid1, request, 2, 1, "{}"sv, "a"sv);
+  }
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 4, error::table_full}));
+  EXPECT_EQ(assembler_.in_flight(), 4U);
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, Timeout) {
+  this->chunk(muid1, 1, 2, 1, "{}"sv, "a"sv);
+  fake_clock::current += std::chrono::milliseconds{50};
+  this->chunk(muid2, 1, 2, 1, "{}"sv, "b"sv);
+  fake_clock::current += std::chrono::milliseconds{60};
+  assembler_.expire();
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::timeout}));
+  EXPECT_EQ(assembler_.in_flight(), 1U);
+  this->chunk(muid2, 1, 2, 2, ""sv, "c"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid2, 1, "{}", "bc"}));
+}
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssembler, StaleEntriesAreReclaimedWhenTableIsFull) {
+  for (auto request = 0U; request < 4U; ++request) {
+    this->chunk(muid1, request, 2, 1, "{}"sv, "a"sv);
+  }
+  fake_clock::current += std::chrono::milliseconds{100};
+  this->chunk(muid2, 1, 2, 1, "{}"sv, "b"sv);
+  EXPECT_EQ(errors_.size(), 4U);
+  EXPECT_EQ(assembler_.in_flight(), 1U);
+  this->chunk(muid2, 1, 2, 2, ""sv, "c"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid2, 1, "{}", "bc"}));
+}
+
+using PropertyExchangeAssemblerManyDevices = PropertyExchangeAssemblerBase<8, 8 * 2048>;
+
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssemblerManyDevices, InterleavedReplies) {
+  // Eight devices reply at once. Their chunks arrive in turn and each device's reply has a different number of
+  // chunks so that the replies complete in an order unrelated to that in which they were started.
+  constexpr auto devices = 8U;
+  auto const muid_of = [](unsigned const device) { return midi2::ci::muid{0x100U + device}; };
+  auto const chunks_of = [](unsigned const device) { return 10U + (device * 5U) % 8U; };
+  std::vector<std::string> expected(devices);
+  std::vector<reply> expected_replies;
+  for (auto chunk_number = 1U; chunk_number <= 17U; ++chunk_number) {
+    for (auto device = 0U; device < devices; ++device) {
+      auto const number_of_chunks = chunks_of(device);
+      if (chunk_number > number_of_chunks) {
+        continue;
+      }
+      std::string data;
+      for (auto ctr = 0U; ctr < 90U; ++ctr) {
+        data += static_cast<char>('a' + (device + chunk_number + ctr) % 26U);
+      }
+      expected[device] += data;
+      auto const header = chunk_number == 1U ? std::string{"{\"status\":200}"} : std::string{};
+      this->chunk(muid_of(device), 3, number_of_chunks, chunk_number, header, data);
+      if (chunk_number == number_of_chunks) {
+        expected_replies.push_back(reply{muid_of(device), 3, R"({"status":200})", expected[device]});
+      }
+    }
+  }
+  EXPECT_EQ(replies_, expected_replies);
+  EXPECT_THAT(errors_, IsEmpty());
+  EXPECT_EQ(assembler_.in_flight(), 0U);
+}
+
+// A pool of two 32-character blocks.
+using PropertyExchangeAssemblerSmallPool = PropertyExchangeAssemblerBase<4, 64>;
+
+// NOLINTNEXTLINE
+TEST_F(PropertyExchangeAssemblerSmallPool, Overflow) {
+  this->chunk(muid1, 1, 3, 1, "{}"sv, "0123456"sv);
+  this->chunk(muid2, 1, 2, 1, "{}"sv, "abc"sv);
+  // muid1's message needs a second block but muid2 holds the only other one.
+  this->chunk(muid1, 1, 3, 2, ""sv, "789012345678901234567890"sv);
+  EXPECT_THAT(errors_, ElementsAre(std::tuple{muid1, 1, error::overflow}));
+  // The space used by the abandoned message is available to others.
+  this->chunk(muid1, 1, 3, 3, ""sv, "x"sv);
+  this->chunk(muid2, 1, 2, 2, ""sv, "defghijklmnopqrstuvwxyz0123456"sv);
+  EXPECT_THAT(replies_, ElementsAre(reply{muid2, 1, "{}", "abcdefghijklmnopqrstuvwxyz0123456"}));
+  EXPECT_THAT(errors_,
+              ElementsAre(std::tuple{muid1, 1, error::overflow}, std::tuple{muid1, 1, error::missing_chunk}));
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,294 @@
+//===-- CI Request Tracker ----------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_request_tracker.hpp"
+
+// Standard library
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
+#include <fuzztest/fuzztest.h>
+#endif
+
+// Test helpers
+#include "fake_clock.hpp"
+
+namespace {
+
+using midi2::ci::b7;
+using midi2::ci::message;
+using midi2::ci::muid;
+using midi2::test::fake_clock;
+using testing::ElementsAre;
+using testing::IsEmpty;
+using namespace std::chrono_literals;
+
+using tracker_type = midi2::ci::request_tracker<16, 8, fake_clock>;
+using outcome = tracker_type::outcome;
+
+struct completion {
+  bool operator==(completion const&) const = default;
+  muid remote;
+  b7 id;
+  std::uint32_t cookie;
+  outcome how;
+};
+
+constexpr midi2::ci::header from(std::uint32_t const remote) {
+  return {.device_id = b7{0x7FU}, .version = b7{2U}, .remote_muid = muid{remote}, .local_muid = muid{0x0123456U}};
+}
+
+constexpr midi2::ci::ack make_ack(std::uint8_t const original_id, b7 const detail = b7{}) {
+  return {.original_id = b7{original_id}, .status_code = b7{}, .status_data = b7{}, .details = {detail}, .message = {}};
+}
+constexpr midi2::ci::nak make_nak(std::uint8_t const original_id, b7 const detail = b7{}) {
+  return {.original_id = b7{original_id}, .status_code = b7{}, .status_data = b7{}, .details = {detail}, .message = {}};
+}
+
+class CIRequestTracker : public midi2::test::fake_clock_test {
+protected:
+  void SetUp() override {
+    fake_clock_test::SetUp();
+    // The tracker's epoch is the time at which it is constructed so it is made once the clock has been reset.
+    tracker_ = tracker_type{1ms};
+    tracker_.on_complete([this](muid const remote, b7 const id, std::uint32_t const cookie, outcome const how) {
+      completed_.push_back(completion{remote, id, cookie, how});
+    });
+    tracker_.on_retry([this](muid, b7, message, std::uint32_t const cookie) { retried_.push_back(cookie); });
+  }
+  void advance(fake_clock::duration const d) {
+    fake_clock::current += d;
+    tracker_.expire();
+  }
+
+  tracker_type tracker_;
+  std::vector<completion> completed_;
+  std::vector<std::uint32_t> retried_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, IdsArePerRemoteAndRotate) {
+  EXPECT_EQ(tracker_.issue(muid{1U}, message::pe_get, 0, 100ms), b7{0U});
+  EXPECT_EQ(tracker_.issue(muid{1U}, message::pe_get, 0, 100ms), b7{1U});
+  EXPECT_EQ(tracker_.issue(muid{2U}, message::pe_get, 0, 100ms), b7{0U});
+  EXPECT_TRUE(tracker_.cancel(muid{1U}, b7{0U}));
+  EXPECT_FALSE(tracker_.cancel(muid{1U}, b7{0U}));
+  // The freed ID is not reused immediately.
+  EXPECT_EQ(tracker_.issue(muid{1U}, message::pe_get, 0, 100ms), b7{2U});
+  EXPECT_EQ(tracker_.size(), 3U);
+  EXPECT_THAT(completed_, IsEmpty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, AllIdsInUse) {
+  midi2::ci::request_tracker<200, 8, fake_clock> tracker;
+  for (auto id = 0U; id < 128U; ++id) {
+    EXPECT_EQ(tracker.issue(muid{1U}, message::pe_get, 0, 100ms), b7{static_cast<std::uint8_t>(id)});
+  }
+  EXPECT_EQ(tracker.issue(muid{1U}, message::pe_get, 0, 100ms), std::nullopt);
+  EXPECT_TRUE(tracker.issue(muid{2U}, message::pe_get, 0, 100ms).has_value());
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, TableFull) {
+  for (auto cookie = 0U; cookie < 16U; ++cookie) {
+    EXPECT_TRUE(tracker_.issue(muid{cookie % 4U}, message::profile_details, cookie, 100ms).has_value());
+  }
+  EXPECT_EQ(tracker_.issue(muid{1U}, message::profile_details, 16, 100ms), std::nullopt);
+  // Only six of the eight remote slots may be used.
+  midi2::ci::request_tracker<16, 8, fake_clock> tracker;
+  for (auto remote = 0U; remote < 6U; ++remote) {
+    EXPECT_TRUE(tracker.issue(muid{remote}, message::profile_details, 0, 100ms).has_value());
+  }
+  EXPECT_EQ(tracker.issue(muid{6U}, message::profile_details, 0, 100ms), std::nullopt);
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, AckAndNak) {
+  auto const get = tracker_.issue(muid{1U}, message::pe_get, 10, 100ms);
+  auto const set = tracker_.issue(muid{1U}, message::pe_set, 11, 100ms);
+  ASSERT_TRUE(get && set);
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::profile_set_on, 12, 100ms).has_value());
+
+  // A Property Exchange ACK is matched by the request ID in its details.
+  EXPECT_FALSE(tracker_.ack(from(1U), make_ack(0x34U, b7{0x55U})));
+  EXPECT_TRUE(tracker_.ack(from(1U), make_ack(0x36U, *set)));
+  // Other messages are matched by their type.
+  EXPECT_FALSE(tracker_.nak(from(2U), make_nak(0x22U)));
+  EXPECT_TRUE(tracker_.nak(from(1U), make_nak(0x22U)));
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, *set, 11, outcome::ack},
+                                      completion{muid{1U}, b7{2U}, 12, outcome::nak}));
+  EXPECT_EQ(tracker_.size(), 1U);
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, OldestReplyIsMatched) {
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::profile_details, 1, 100ms).has_value());
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::profile_details, 2, 100ms).has_value());
+  EXPECT_TRUE(tracker_.reply(from(1U), message::profile_details));
+  EXPECT_TRUE(tracker_.reply(from(1U), message::profile_details));
+  EXPECT_FALSE(tracker_.reply(from(1U), message::profile_details));
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, b7{0U}, 1, outcome::reply},
+                                      completion{muid{1U}, b7{1U}, 2, outcome::reply}));
+  EXPECT_TRUE(tracker_.empty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, ChunkedReplyRestartsTimer) {
+  auto const id = tracker_.issue(muid{1U}, message::pe_get, 7, 100ms);
+  ASSERT_TRUE(id.has_value());
+  auto chunk = [&id](std::uint16_t const number) {
+    return midi2::ci::property_exchange::get_reply{
+        .chunk = {.number_of_chunks = midi2::ci::b14{2U}, .chunk_number = midi2::ci::b14{number}},
+        .request = *id,
+        .header = {},
+        .data = {}};
+  };
+  this->advance(90ms);
+  EXPECT_TRUE(tracker_.reply(from(1U), chunk(1)));
+  this->advance(90ms);
+  EXPECT_THAT(completed_, IsEmpty()) << "The first chunk restarted the timer";
+  EXPECT_TRUE(tracker_.reply(from(1U), chunk(2)));
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, *id, 7, outcome::reply}));
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, ChunkedReplyWithUnknownCount) {
+  auto const id = tracker_.issue(muid{1U}, message::pe_get, 7, 100ms);
+  ASSERT_TRUE(id.has_value());
+  auto chunk = [&id](std::uint16_t const number, std::uint16_t const of) {
+    return midi2::ci::property_exchange::get_reply{
+        .chunk = {.number_of_chunks = midi2::ci::b14{of}, .chunk_number = midi2::ci::b14{number}},
+        .request = *id,
+        .header = {},
+        .data = {}};
+  };
+  // A number_of_chunks of zero means that the sender does not yet know how many chunks there will be.
+  EXPECT_TRUE(tracker_.reply(from(1U), chunk(1, 0)));
+  this->advance(90ms);
+  EXPECT_TRUE(tracker_.reply(from(1U), chunk(2, 0)));
+  this->advance(90ms);
+  EXPECT_THAT(completed_, IsEmpty());
+  EXPECT_EQ(tracker_.size(), 1U);
+  EXPECT_TRUE(tracker_.reply(from(1U), chunk(3, 3)));
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, *id, 7, outcome::reply}));
+  EXPECT_TRUE(tracker_.empty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, RetryThenTimeout) {
+  auto const id = tracker_.issue(muid{1U}, message::pe_get, 3, 100ms, 2);
+  ASSERT_TRUE(id.has_value());
+  this->advance(99ms);
+  EXPECT_THAT(retried_, IsEmpty());
+  this->advance(1ms);
+  EXPECT_THAT(retried_, ElementsAre(3U));
+  this->advance(100ms);
+  EXPECT_THAT(retried_, ElementsAre(3U, 3U));
+  EXPECT_THAT(completed_, IsEmpty());
+  this->advance(100ms);
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, *id, 3, outcome::timeout}));
+  EXPECT_TRUE(tracker_.empty());
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, CallbackMayCompleteOtherRequests) {
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::profile_details, 1, 10ms).has_value());
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::pe_get, 2, 10ms).has_value());
+  tracker_.on_complete([this](muid const remote, b7 const id, std::uint32_t const cookie, outcome const how) {
+    completed_.push_back(completion{remote, id, cookie, how});
+    tracker_.reply(from(1U), message::profile_details);
+  });
+  this->advance(10ms);
+  EXPECT_EQ(completed_.size(), 2U);
+  EXPECT_TRUE(tracker_.empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, IssueLongAfterLastExpire) {
+  EXPECT_EQ(tracker_.issue(muid{1U}, message::pe_get, 1, 10ms), b7{0U});
+  // The clock moves on further than the wheel can reach without expire() being called.
+  fake_clock::current += 300000ms;
+  EXPECT_EQ(tracker_.issue(muid{2U}, message::pe_get, 2, 100ms), b7{0U});
+  advance(99ms);
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, b7{0U}, 1, outcome::timeout}));
+  advance(1ms);
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, b7{0U}, 1, outcome::timeout},
+                                      completion{muid{2U}, b7{0U}, 2, outcome::timeout}));
+}
+// NOLINTNEXTLINE
+TEST_F(CIRequestTracker, LateExpireCatchesUp) {
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::pe_get, 1, 5ms).has_value());
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::pe_get, 2, 5000ms).has_value());
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::pe_get, 3, 200000ms).has_value());
+  // A single call long after the last expires all three requests in order.
+  advance(250000ms);
+  EXPECT_THAT(completed_, ElementsAre(completion{muid{1U}, b7{0U}, 1, outcome::timeout},
+                                      completion{muid{1U}, b7{1U}, 2, outcome::timeout},
+                                      completion{muid{1U}, b7{2U}, 3, outcome::timeout}));
+  // The wheel is idle but a new request is still timed from the current tick.
+  EXPECT_TRUE(tracker_.issue(muid{1U}, message::pe_get, 4, 10ms).has_value());
+  advance(9ms);
+  EXPECT_EQ(completed_.size(), 3U);
+  advance(1ms);
+  EXPECT_EQ(completed_.size(), 4U);
+}
+
+/// Issues requests with the given timeouts (in ticks), moving the clock forward by a varying amount between each, and
+/// checks that each times out at exactly the right moment.
+void ExpiresOnTime(std::vector<std::tuple<std::uint16_t, std::uint8_t>> const& requests) {
+  fake_clock::current = fake_clock::time_point{};
+  midi2::ci::request_tracker<64, 64, fake_clock> tracker{1ms};
+  std::set<std::pair<std::int64_t, std::uint32_t>> expected;
+  std::set<std::pair<std::int64_t, std::uint32_t>> actual;
+  tracker.on_complete([&actual](muid, b7, std::uint32_t const cookie, auto) {
+    actual.emplace(fake_clock::current.time_since_epoch().count(), cookie);
+  });
+  auto const step = [&tracker] {
+    fake_clock::current += 1ms;
+    tracker.expire();
+  };
+  auto cookie = std::uint32_t{0};
+  for (auto const& [timeout, gap] : requests) {
+    auto const ticks = std::max(std::uint16_t{1}, timeout);
+    if (tracker.issue(muid{cookie % 8U}, message::profile_details, cookie, std::chrono::milliseconds{ticks})) {
+      expected.emplace(fake_clock::current.time_since_epoch().count() + ticks, cookie);
+    }
+    ++cookie;
+    for (auto ctr = 0U; ctr < gap; ++ctr) {
+      step();
+    }
+  }
+  while (!tracker.empty()) {
+    step();
+  }
+  EXPECT_EQ(actual, expected);
+}
+#if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
+// NOLINTNEXTLINE
+FUZZ_TEST(CIRequestTrackerWheel, ExpiresOnTime);
+#endif
+// NOLINTNEXTLINE
+TEST(CIRequestTrackerWheel, ExpiresOnTime) {
+  std::mt19937 gen{3};
+  // Timeouts which fall in each of the three levels of the wheel.
+  std::uniform_int_distribution<std::uint16_t> timeout{1U, 9000U};
+  std::uniform_int_distribution<std::uint8_t> gap{0U, 100U};
+  std::vector<std::tuple<std::uint16_t, std::uint8_t>> requests;
+  for (auto ctr = 0; ctr < 500; ++ctr) {
+    requests.emplace_back(timeout(gen), gap(gen));
+  }
+  ExpiresOnTime(requests);
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,170 @@
+//===-- CI Subscription Manager -----------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ci/ci_subscription_manager.hpp"
+
+// MIDI2
+#include "midi2/ci/ci_create_message.hpp"
+
+// Standard library
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using midi2::ci::b7;
+using midi2::ci::muid;
+using testing::ElementsAre;
+using testing::IsEmpty;
+using namespace std::string_view_literals;
+
+using manager_type = midi2::ci::subscription_manager<8, 128, 4, 32>;
+
+constexpr auto local_muid = muid{0x0123456U};
+
+/// Builds the message that create_message() would produce for an update sent to \p subscriber.
+std::vector<std::byte> expected_update(muid const subscriber, std::uint8_t const request, std::string_view const json,
+                                       std::string_view const data) {
+  std::vector<std::byte> message;
+  midi2::ci::create_message(
+      std::back_inserter(message), midi2::ci::trivial_sentinel{},
+      midi2::ci::header{
+          .device_id = b7{0x7FU}, .version = b7{2U}, .remote_muid = local_muid, .local_muid = subscriber},
+      midi2::ci::property_exchange::subscription{
+          .chunk = {.number_of_chunks = midi2::ci::b14{1U}, .chunk_number = midi2::ci::b14{1U}},
+          .request = b7{request},
+          .header = json,
+          .data = data});
+  return message;
+}
+
+std::string as_string(manager_type::subscribe_id const& id) {
+  return std::string{id.begin(), id.end()};
+}
+
+class CISubscriptionManager : public testing::Test {
+protected:
+  std::size_t flush() {
+    return manager_.flush(
+        [this](std::span<std::byte const> const bytes) { sent_.emplace_back(bytes.begin(), bytes.end()); });
+  }
+
+  manager_type manager_{local_muid};
+  std::vector<std::vector<std::byte>> sent_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(CISubscriptionManager, FanOut) {
+  auto const a = manager_.subscribe(muid{0x1111U}, "ChCtrlList", "");
+  auto const b = manager_.subscribe(muid{0x2222U}, "ChCtrlList", "");
+  auto const c = manager_.subscribe(muid{0x3333U}, "X-Patch", "1");
+  ASSERT_TRUE(a && b && c);
+  EXPECT_EQ(as_string(*a), "00000000");
+  EXPECT_EQ(as_string(*b), "00000001");
+  EXPECT_EQ(manager_.size(), 3U);
+
+  EXPECT_TRUE(manager_.publish("ChCtrlList", "", R"([{"ctrl":7}])"sv));
+  EXPECT_TRUE(manager_.publish("X-Patch", "1", R"({"name":"P"})"sv, manager_type::update::partial));
+  EXPECT_TRUE(manager_.publish("X-Patch", "2", "{}"sv)) << "A resource with no subscribers";
+  EXPECT_EQ(this->flush(), 3U);
+  EXPECT_THAT(sent_,
+              ElementsAre(expected_update(muid{0x1111U}, 0, R"({"command":"full","subscribeId":"00000000"})",
+                                          R"([{"ctrl":7}])"),
+                          expected_update(muid{0x2222U}, 1, R"({"command":"full","subscribeId":"00000001"})",
+                                          R"([{"ctrl":7}])"),
+                          expected_update(muid{0x3333U}, 2, R"({"command":"partial","subscribeId":"00000002"})",
+                                          R"({"name":"P"})")));
+  EXPECT_EQ(this->flush(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(CISubscriptionManager, Unsubscribe) {
+  auto const a = manager_.subscribe(muid{0x1111U}, "ChCtrlList", "");
+  ASSERT_TRUE(manager_.subscribe(muid{0x2222U}, "ChCtrlList", "").has_value());
+  ASSERT_TRUE(manager_.subscribe(muid{0x2222U}, "X-Patch", "").has_value());
+  ASSERT_TRUE(a.has_value());
+  EXPECT_FALSE(manager_.unsubscribe("zzzzzzzz"sv));
+  EXPECT_FALSE(manager_.unsubscribe("0000000f"sv));
+  EXPECT_TRUE(manager_.unsubscribe(std::string_view{a->data(), a->size()}));
+  EXPECT_EQ(manager_.unsubscribe(muid{0x2222U}), 2U);
+  EXPECT_TRUE(manager_.empty());
+  EXPECT_TRUE(manager_.publish("ChCtrlList", "", "[]"sv));
+  EXPECT_EQ(this->flush(), 0U);
+  EXPECT_THAT(sent_, IsEmpty());
+}
+// NOLINTNEXTLINE
+TEST_F(CISubscriptionManager, ResourceIndexIsUpdatedWhenAResourceIsRemoved) {
+  auto const a = manager_.subscribe(muid{0x1111U}, "A", "");
+  ASSERT_TRUE(manager_.subscribe(muid{0x2222U}, "B", "").has_value());
+  ASSERT_TRUE(a.has_value());
+  // Removing A's only subscriber moves resource B into A's slot.
+  EXPECT_TRUE(manager_.unsubscribe(std::string_view{a->data(), a->size()}));
+  EXPECT_TRUE(manager_.publish("B", "", "1"sv));
+  EXPECT_EQ(this->flush(), 1U);
+  EXPECT_THAT(sent_, ElementsAre(expected_update(muid{0x2222U}, 0, R"({"command":"full","subscribeId":"00000001"})",
+                                                 "1")));
+}
+// NOLINTNEXTLINE
+TEST_F(CISubscriptionManager, Limits) {
+  for (auto index = 0U; index < 8U; ++index) {
+    EXPECT_TRUE(manager_.subscribe(muid{index}, "R", "").has_value());
+  }
+  EXPECT_FALSE(manager_.subscribe(muid{8U}, "R", "").has_value());
+  EXPECT_FALSE(manager_.publish(std::string(40, 'x'), "", "1"sv)) << "Resource name is too long";
+  EXPECT_FALSE(manager_.publish("R", "", std::string(100, 'x'))) << "Message is too large";
+  for (auto index = 0U; index < 4U; ++index) {
+    EXPECT_TRUE(manager_.publish("R", "", "1"sv));
+  }
+  EXPECT_FALSE(manager_.publish("R", "", "1"sv)) << "Queue is full";
+  EXPECT_EQ(this->flush(), 32U);
+  EXPECT_TRUE(manager_.publish("R", "", "1"sv));
+}
+// NOLINTNEXTLINE
+TEST(CISubscriptionManagerThreads, PublishWhileFlushing) {
+  manager_type manager{local_muid};
+  ASSERT_TRUE(manager.subscribe(muid{1U}, "R", "").has_value());
+  ASSERT_TRUE(manager.subscribe(muid{2U}, "R", "").has_value());
+  constexpr auto updates = 1000U;
+  std::thread control{[&manager] {
+    for (auto index = 0U; index < updates;) {
+      auto const value = std::to_string(index);
+      if (manager.publish("R", "", std::span{value})) {
+        ++index;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }};
+  auto received = 0U;
+  auto in_order = true;
+  while (received < updates * 2U) {
+    manager.flush([&received, &in_order](std::span<std::byte const> const bytes) {
+      // The message data is the decimal value of the update's index.
+      auto const value = std::to_string(received / 2U);
+      auto const data = bytes.last(value.size());
+      in_order = in_order && std::ranges::equal(data, value, {}, {}, [](char const c) { return std::byte(c); });
+      ++received;
+    });
+  }
+  control.join();
+  EXPECT_TRUE(in_order);
+}
+
+}  // end anonymous namespace
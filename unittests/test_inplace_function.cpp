@@ -0,0 +1,108 @@
+//===-- Inplace Function ------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/adt/inplace_function.hpp"
+
+// Standard library
+#include <memory>
+#include <utility>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using midi2::adt::inplace_function;
+
+/// A callable which counts the number of live instances.
+class counted {
+public:
+  explicit counted(int* const live) noexcept : live_{live} { ++*live_; }
+  counted(counted const& other) noexcept : live_{other.live_} { ++*live_; }
+  counted(counted&& other) noexcept : live_{other.live_} { ++*live_; }
+  counted& operator=(counted const&) = delete;
+  counted& operator=(counted&&) = delete;
+  ~counted() noexcept { --*live_; }
+
+  int operator()(int const v) const { return v + 1; }
+
+private:
+  int* live_;
+};
+
+// NOLINTNEXTLINE
+TEST(InplaceFunction, Empty) {
+  inplace_function<int(int)> const f;
+  EXPECT_FALSE(f);
+  inplace_function<void()> const g = nullptr;
+  EXPECT_FALSE(g);
+  g();
+  midi2::adt::call(g);
+}
+// NOLINTNEXTLINE
+TEST(InplaceFunction, Invoke) {
+  auto total = 0;
+  inplace_function<void(int)> f = [&total](int const v) { total += v; };
+  EXPECT_TRUE(f);
+  f(2);
+  midi2::adt::call(f, 3);
+  EXPECT_EQ(total, 5);
+}
+// NOLINTNEXTLINE
+TEST(InplaceFunction, DiscardsResult) {
+  // As with std::function<>, a void function may hold a target which returns a value.
+  auto total = 0;
+  inplace_function<void(int)> const f = [&total](int const v) { return total += v; };
+  f(4);
+  EXPECT_EQ(total, 4);
+}
+// NOLINTNEXTLINE
+TEST(InplaceFunction, MutableTarget) {
+  inplace_function<int()> const f = [count = 0]() mutable { return ++count; };
+  EXPECT_EQ(f(), 1);
+  EXPECT_EQ(f(), 2);
+}
+// NOLINTNEXTLINE
+TEST(InplaceFunction, CopyAndMove) {
+  auto live = 0;
+  {
+    inplace_function<int(int)> a = counted{&live};
+    EXPECT_EQ(live, 1);
+    auto b = a;
+    EXPECT_EQ(live, 2);
+    auto c = std::move(a);
+    EXPECT_EQ(live, 2);
+    EXPECT_FALSE(a);  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(c(1), 2);
+    a = b;
+    EXPECT_EQ(live, 3);
+    a = nullptr;
+    EXPECT_EQ(live, 2);
+    b = std::move(c);
+    EXPECT_EQ(live, 1);
+    EXPECT_EQ(b(4), 5);
+    b = b;  // NOLINT(clang-diagnostic-self-assign-overloaded)
+    EXPECT_EQ(b(4), 5);
+  }
+  EXPECT_EQ(live, 0);
+}
+// NOLINTNEXTLINE
+TEST(InplaceFunction, Capacity) {
+  auto const p = std::make_shared<int>(7);
+  inplace_function<int(), sizeof(std::shared_ptr<int>)> f = [p] { return *p; };
+  EXPECT_EQ(f(), 7);
+  EXPECT_EQ(p.use_count(), 2);
+  f = nullptr;
+  EXPECT_EQ(p.use_count(), 1);
+}
+
+}  // end anonymous namespace
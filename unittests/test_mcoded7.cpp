@@ -16,6 +16,7 @@
 #include <array>
 #include <cstdint>
 #include <iterator>
+#include <span>
 #include <vector>
 
 // google mock/test/fuzz
@@ -104,13 +105,77 @@ void Mcoded7RoundTrip(std::vector<std::byte> const& input) {
   EXPECT_THAT(decoded, testing::ContainerEq(input));
 }
 
+/// Checks that the bulk encode() and decode() functions produce the same output as parse_byte(). The input is
+/// supplied in two parts split at \p split so that the bulk functions start partway through a group.
+void BulkMatchesParseByte(std::vector<std::byte> const& input, std::size_t split) {
+  split = input.empty() ? 0U : split % input.size();
+  auto const first = std::span{input}.first(split);
+  auto const second = std::span{input}.subspan(split);
+
+  auto const expected_encoded = Mcoded7::encode(input);
+  std::vector<std::byte> encoded;
+  {
+    midi2::mcoded7::encoder encoder;
+    auto out = encoder.encode(first, std::back_inserter(encoded));
+    out = encoder.encode(second, out);
+    encoder.flush(out);
+  }
+  EXPECT_THAT(encoded, testing::ContainerEq(expected_encoded));
+  {
+    // Encode to a raw pointer.
+    midi2::mcoded7::encoder encoder;
+    std::vector<std::byte> buffer(expected_encoded.size());
+    auto* out = encoder.encode(first, buffer.data());
+    out = encoder.encode(second, out);
+    EXPECT_EQ(encoder.flush(out), buffer.data() + buffer.size());
+    EXPECT_THAT(buffer, testing::ContainerEq(expected_encoded));
+  }
+
+  // Decode the raw input too: it may not be valid mcoded7 so this checks that the good() state matches.
+  for (auto const& source : {expected_encoded, input}) {
+    midi2::mcoded7::decoder expected_decoder;
+    std::vector<std::byte> expected_decoded;
+    auto expected_out = std::back_inserter(expected_decoded);
+    for (auto const b : source) {
+      expected_out = expected_decoder.parse_byte(b, expected_out);
+    }
+
+    midi2::mcoded7::decoder decoder;
+    std::vector<std::byte> decoded;
+    auto const part = std::min(split, source.size());
+    auto out = decoder.decode(std::span{source}.first(part), std::back_inserter(decoded));
+    decoder.decode(std::span{source}.subspan(part), out);
+    EXPECT_THAT(decoded, testing::ContainerEq(expected_decoded));
+    EXPECT_EQ(decoder.good(), expected_decoder.good());
+
+    // Decode to a raw pointer.
+    decoder.reset();
+    std::vector<std::byte> buffer(expected_decoded.size());
+    EXPECT_EQ(decoder.decode(source, buffer.data()), buffer.data() + buffer.size());
+    EXPECT_THAT(buffer, testing::ContainerEq(expected_decoded));
+    EXPECT_EQ(decoder.good(), expected_decoder.good());
+  }
+}
+
 }  // end anonymous namespace
 
 #if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
 // NOLINTNEXTLINE
 FUZZ_TEST(Mcoded7, Mcoded7RoundTrip);
+// NOLINTNEXTLINE
+FUZZ_TEST(Mcoded7, BulkMatchesParseByte);
 #endif
 // NOLINTNEXTLINE
+TEST(Mcoded7, BulkMatchesParseByte) {
+  std::vector<std::byte> input;
+  for (auto length = 0U; length < 40U; ++length) {
+    for (auto split = 0U; split < 9U; ++split) {
+      BulkMatchesParseByte(input, split);
+    }
+    input.push_back(static_cast<std::byte>((length * 0x9DU) ^ 0x5AU));
+  }
+}
+// NOLINTNEXTLINE
 TEST(Mcoded7, EmptyRoundTrip) {
   Mcoded7RoundTrip(std::vector<std::byte>{});
 }
@@ -10,6 +10,11 @@
 #include "midi2/adt/plru_cache.hpp"
 
 // Standard Library
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <numeric>
 #include <tuple>
 #include <vector>
 
@@ -245,6 +250,99 @@ TEST(PlruCacheFuzz, Empty2x8) {
   NeverCrashes<2, 8>({1, 2, 3, 4, 5, 4, 3, 2, 1});
 }
 
+/// The original bit-by-bit tree walk against which the table-driven tree is checked.
+template <std::size_t Ways> class reference_tree {
+public:
+  void touch(std::size_t const way) noexcept {
+    auto node = std::size_t{0};
+    auto start = std::size_t{0};
+    auto end = Ways;
+    while (node < Ways - 1U) {
+      auto const mid = std::midpoint(start, end);
+      auto const is_less = way < mid;
+      if (is_less) {
+        end = mid;
+      } else {
+        start = mid;
+      }
+      bits_[node] = is_less;
+      node = 2U * node + 1U + static_cast<unsigned>(!is_less);
+    }
+  }
+  [[nodiscard]] std::size_t oldest() const noexcept {
+    auto node = std::size_t{0};
+    while (node < Ways - 1U) {
+      node = 2U * node + 1U + static_cast<unsigned>(bits_[node]);
+    }
+    return node - (Ways - 1U);
+  }
+
+private:
+  std::bitset<Ways - 1U> bits_{};
+};
+
+template <std::size_t Ways> void check_tree() {
+  midi2::adt::details::tree<Ways> tree;
+  reference_tree<Ways> expected;
+  EXPECT_EQ(tree.oldest(), expected.oldest());
+  // Touch the ways in a scrambled order so that every path through the tree is exercised.
+  for (auto ctr = std::size_t{0}; ctr < Ways * 8U; ++ctr) {
+    auto const way = (ctr * 7U + ctr / Ways) % Ways;
+    tree.touch(way);
+    expected.touch(way);
+    EXPECT_EQ(tree.oldest(), expected.oldest()) << "Ways=" << Ways << " ctr=" << ctr;
+  }
+  tree.reset();
+  EXPECT_EQ(tree.oldest(), 0U);
+}
+
+// The tree of each set must have a whole number of levels.
+template <std::size_t Ways>
+concept valid_ways = requires { typename midi2::adt::plru_cache<unsigned, int, 4, Ways>; };
+static_assert(valid_ways<4> && valid_ways<16> && valid_ways<32>);
+static_assert(!valid_ways<3> && !valid_ways<6> && !valid_ways<12> && !valid_ways<24>);
+
+TEST(PlruTree, MatchesReference) {
+  check_tree<2>();
+  check_tree<4>();
+  check_tree<8>();
+  check_tree<16>();
+  check_tree<32>();
+}
+
+template <std::unsigned_integral Key, unsigned SetBits, unsigned Ways> void check_match_finder() {
+  using tagged_key_type = midi2::adt::details::tagged_key<Key, SetBits>;
+  using finder = midi2::adt::details::match_finder<Key, SetBits, Ways>;
+  std::array<tagged_key_type, Ways> keys{};
+  for (auto way = 0U; way < Ways; ++way) {
+    keys[way] = tagged_key_type{static_cast<Key>((way + 1U) << SetBits)};
+  }
+  for (auto way = 0U; way < Ways; ++way) {
+    EXPECT_EQ(finder::find(keys[way], keys), way) << "Ways=" << Ways << " SetBits=" << SetBits;
+  }
+  // A key which is not present and an empty (invalid) key.
+  EXPECT_EQ(finder::find(tagged_key_type{static_cast<Key>((Ways + 1U) << SetBits)}, keys), Ways);
+  EXPECT_EQ(finder::find(tagged_key_type{}, keys), Ways);
+  // The largest key exercises the lanes' most significant bits.
+  keys[Ways - 1U] = tagged_key_type{std::numeric_limits<Key>::max()};
+  EXPECT_EQ(finder::find(tagged_key_type{std::numeric_limits<Key>::max()}, keys), Ways - 1U);
+}
+
+TEST(PlruMatchFinder, Uint16) {
+  check_match_finder<std::uint16_t, 2, 4>();
+  check_match_finder<std::uint16_t, 2, 8>();
+  check_match_finder<std::uint16_t, 2, 16>();
+}
+TEST(PlruMatchFinder, Uint32) {
+  check_match_finder<std::uint32_t, 2, 4>();
+  check_match_finder<std::uint32_t, 2, 8>();
+  check_match_finder<std::uint32_t, 2, 16>();
+}
+TEST(PlruMatchFinder, Uint64) {
+  check_match_finder<std::uint64_t, 2, 4>();
+  check_match_finder<std::uint64_t, 2, 8>();
+}
+
 TEST(PlruCache, OverFill) {
   plru_cache<unsigned, unsigned, 4, 2> cache;
 
@@ -0,0 +1,136 @@
+//===-- spsc_fifo -------------------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/adt/spsc_fifo.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using testing::ElementsAre;
+
+// NOLINTNEXTLINE
+TEST(SpscFifo, Empty) {
+  midi2::adt::spsc_fifo<std::uint32_t, 4> fifo;
+  EXPECT_TRUE(fifo.empty());
+  EXPECT_FALSE(fifo.full());
+  EXPECT_EQ(fifo.size(), 0U);
+  EXPECT_EQ(fifo.max_size(), 4U);
+  EXPECT_EQ(fifo.pop_front(), std::nullopt);
+}
+// NOLINTNEXTLINE
+TEST(SpscFifo, PushPop) {
+  midi2::adt::spsc_fifo<std::uint32_t, 4> fifo;
+  EXPECT_TRUE(fifo.push_back(1U));
+  EXPECT_TRUE(fifo.push_back(2U));
+  EXPECT_EQ(fifo.size(), 2U);
+  EXPECT_EQ(fifo.pop_front(), 1U);
+  EXPECT_EQ(fifo.pop_front(), 2U);
+  EXPECT_TRUE(fifo.empty());
+}
+// NOLINTNEXTLINE
+TEST(SpscFifo, Full) {
+  midi2::adt::spsc_fifo<std::uint32_t, 4> fifo;
+  for (auto ctr = 0U; ctr < fifo.max_size(); ++ctr) {
+    EXPECT_TRUE(fifo.push_back(ctr));
+  }
+  EXPECT_TRUE(fifo.full());
+  EXPECT_FALSE(fifo.push_back(23U));
+  EXPECT_EQ(fifo.size(), 4U);
+  EXPECT_EQ(fifo.pop_front(), 0U);
+  EXPECT_FALSE(fifo.full());
+  EXPECT_TRUE(fifo.push_back(4U));
+  EXPECT_TRUE(fifo.full());
+}
+// NOLINTNEXTLINE
+TEST(SpscFifo, BulkPushIsTruncated) {
+  midi2::adt::spsc_fifo<std::uint32_t, 4> fifo;
+  constexpr auto values = std::array{1U, 2U, 3U, 4U, 5U, 6U};
+  EXPECT_EQ(fifo.push_back(std::span<std::uint32_t const>{values}), 4U);
+  std::array<std::uint32_t, 6> out{};
+  EXPECT_EQ(fifo.pop_front(std::span{out}), 4U);
+  EXPECT_THAT(std::span{out}.first(4), ElementsAre(1U, 2U, 3U, 4U));
+  EXPECT_EQ(fifo.pop_front(std::span{out}), 0U);
+}
+// NOLINTNEXTLINE
+TEST(SpscFifo, BulkWrapsAround) {
+  midi2::adt::spsc_fifo<std::uint32_t, 8> fifo;
+  std::array<std::uint32_t, 8> out{};
+  auto next = std::uint32_t{0};
+  auto expected = std::uint32_t{0};
+  // Repeatedly push five values and pop five so that the indices wrap at a different position on each iteration.
+  for (auto iteration = 0U; iteration < 20U; ++iteration) {
+    std::array<std::uint32_t, 5> in{};
+    std::iota(in.begin(), in.end(), next);
+    next += static_cast<std::uint32_t>(in.size());
+    ASSERT_EQ(fifo.push_back(std::span<std::uint32_t const>{in}), in.size());
+    EXPECT_EQ(fifo.size(), in.size());
+    ASSERT_EQ(fifo.pop_front(std::span{out}), in.size());
+    for (auto const v : std::span{out}.first(in.size())) {
+      EXPECT_EQ(v, expected);
+      ++expected;
+    }
+  }
+  EXPECT_TRUE(fifo.empty());
+}
+// NOLINTNEXTLINE
+TEST(SpscFifo, ProducerConsumerThreads) {
+  constexpr auto total = std::uint32_t{100'000};
+  midi2::adt::spsc_fifo<std::uint32_t, 64> fifo;
+
+  std::thread producer{[&fifo] {
+    std::array<std::uint32_t, 7> in{};
+    for (auto next = std::uint32_t{0}; next < total;) {
+      auto const n = std::min(static_cast<std::uint32_t>(in.size()), total - next);
+      std::iota(in.begin(), in.begin() + n, next);
+      auto span = std::span<std::uint32_t const>{in}.first(n);
+      while (!span.empty()) {
+        auto const pushed = fifo.push_back(span);
+        if (pushed == 0U) {
+          std::this_thread::yield();
+        }
+        span = span.subspan(pushed);
+      }
+      next += n;
+    }
+  }};
+
+  std::vector<std::uint32_t> received;
+  received.reserve(total);
+  std::array<std::uint32_t, 11> out{};
+  while (received.size() < total) {
+    auto const n = fifo.pop_front(std::span{out});
+    if (n == 0U) {
+      std::this_thread::yield();
+    }
+    received.insert(received.end(), out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n));
+  }
+  producer.join();
+
+  std::vector<std::uint32_t> expected(total);
+  std::iota(expected.begin(), expected.end(), std::uint32_t{0});
+  EXPECT_EQ(received, expected);
+  EXPECT_TRUE(fifo.empty());
+}
+
+}  // end anonymous namespace
@@ -0,0 +1,282 @@
+//===-- UMP MIDI-CI Demultiplexer ---------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ump/ump_ci_demultiplexer.hpp"
+
+// MIDI2
+#include "midi2/ci/ci_buffer_pool.hpp"
+#include "midi2/ci/ci_create_message.hpp"
+#include "midi2/ci/ci_dispatcher.hpp"
+#include "midi2/ump/ump_dispatcher.hpp"
+#include "midi2/ump/ump_sysex7_packetizer.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+using context_type = int;
+using ci_dispatcher_type = midi2::ci::ci_dispatcher<midi2::ci::function_config<std::uint8_t, 64>>;
+using demultiplexer_type = midi2::ump::dispatcher_backend::ci_demultiplexer<context_type, ci_dispatcher_type>;
+
+static_assert(midi2::ump::dispatcher_backend::data64<demultiplexer_type, context_type>,
+              "ci_demultiplexer must implement the data64 concept");
+
+constexpr midi2::ci::header make_header(std::uint32_t const muid) {
+  return {.device_id = midi2::ci::b7{0x7FU},
+          .version = midi2::ci::b7{2U},
+          .remote_muid = midi2::ci::muid{muid},
+          .local_muid = midi2::ci::broadcast_muid};
+}
+
+constexpr midi2::ci::discovery make_discovery(std::uint8_t const output_path_id) {
+  using midi2::ci::b7;
+  return {.manufacturer = {b7{0x12U}, b7{0x23U}, b7{0x34U}},
+          .family = midi2::ci::b14{0x1779U},
+          .model = midi2::ci::b14{0x2B5DU},
+          .version = {b7{0x4EU}, b7{0x3CU}, b7{0x2AU}, b7{0x18U}},
+          .capability = b7{0x7FU},
+          .max_sysex_size = midi2::ci::b28{512U},
+          .output_path_id = b7{output_path_id}};
+}
+
+template <typename Content> std::vector<std::byte> make_message(midi2::ci::header const& hdr, Content const& content) {
+  std::vector<std::byte> message;
+  midi2::ci::create_message(std::back_inserter(message), midi2::ci::trivial_sentinel{}, hdr, content);
+  return message;
+}
+
+std::vector<std::uint8_t> to_u8(std::span<std::byte const> const bytes) {
+  std::vector<std::uint8_t> result;
+  result.reserve(bytes.size());
+  std::ranges::transform(bytes, std::back_inserter(result),
+                         [](std::byte const b) { return std::to_integer<std::uint8_t>(b); });
+  return result;
+}
+
+struct discovery_record {
+  bool operator==(discovery_record const&) const = default;
+  std::uint8_t group;
+  midi2::ci::muid muid;
+  std::uint8_t output_path_id;
+};
+
+class UMPCIDemultiplexer : public testing::Test {
+protected:
+  UMPCIDemultiplexer()
+      : demux_{[](std::uint8_t const group) {
+          // The group number doubles as the CI dispatcher's context.
+          return midi2::ci::make_function_dispatcher<std::uint8_t, 64>(midi2::ci::b7{0x7FU}, group,
+                                                                       std::uint8_t{group});
+        }} {
+    for (auto group = std::uint8_t{0}; group < demultiplexer_type::groups; ++group) {
+      auto& config = demux_.dispatcher(group).config();
+      config.management.on_discovery(
+          [this](std::uint8_t const g, midi2::ci::header const& h, midi2::ci::discovery const& d) {
+            received_.push_back(discovery_record{g, h.remote_muid, static_cast<std::uint8_t>(d.output_path_id.get())});
+          });
+      config.system.on_unknown([this](std::uint8_t, midi2::ci::header const&) { ++unknown_; });
+    }
+  }
+
+  /// Sends \p bytes to the demultiplexer as a message on \p group, putting \p per_packet bytes in each packet.
+  void send(std::uint8_t const group, std::span<std::byte const> bytes, std::size_t const per_packet = 6) {
+    auto const next = [&bytes, per_packet] {
+      auto const n = std::min(per_packet, bytes.size());
+      auto const result = to_u8(bytes.first(n));
+      bytes = bytes.subspan(n);
+      return result;
+    };
+    if (bytes.size() <= per_packet) {
+      demux_.sysex7_in_1(0, midi2::ump::data64::sysex7_in_1{}.group(group).data(next()));
+      return;
+    }
+    demux_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(group).data(next()));
+    while (bytes.size() > per_packet) {
+      demux_.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(next()));
+    }
+    demux_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(group).data(next()));
+  }
+
+  demultiplexer_type demux_;
+  std::vector<discovery_record> received_;
+  unsigned unknown_ = 0;
+};
+
+// NOLINTNEXTLINE
+TEST_F(UMPCIDemultiplexer, Discovery) {
+  this->send(5, make_message(make_header(0x1234U), make_discovery(0x71U)));
+  EXPECT_THAT(received_, ElementsAre(discovery_record{5, midi2::ci::muid{0x1234U}, 0x71}));
+}
+// NOLINTNEXTLINE
+TEST_F(UMPCIDemultiplexer, ConsecutiveMessages) {
+  this->send(2, make_message(make_header(0x1111U), make_discovery(1)));
+  this->send(2, make_message(make_header(0x2222U), make_discovery(2)));
+  EXPECT_THAT(received_, ElementsAre(discovery_record{2, midi2::ci::muid{0x1111U}, 1},
+                                     discovery_record{2, midi2::ci::muid{0x2222U}, 2}));
+}
+// NOLINTNEXTLINE
+TEST_F(UMPCIDemultiplexer, PacketSizes) {
+  // Includes packets too small to hold the three bytes needed to recognize a MIDI-CI message.
+  auto const message = make_message(make_header(0x1234U), make_discovery(0x10U));
+  for (auto per_packet = std::size_t{1}; per_packet <= 6U; ++per_packet) {
+    this->send(0, message, per_packet);
+  }
+  EXPECT_EQ(received_.size(), 6U);
+  EXPECT_TRUE(std::ranges::all_of(
+      received_, [](discovery_record const& r) { return r == discovery_record{0, midi2::ci::muid{0x1234U}, 0x10}; }));
+}
+// NOLINTNEXTLINE
+TEST_F(UMPCIDemultiplexer, TruncatedMessageIsAbandoned) {
+  auto const message = make_message(make_header(0x1111U), make_discovery(1));
+  demux_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(3).data(to_u8(std::span{message}.first(6))));
+  demux_.sysex7_continue(0,
+                         midi2::ump::data64::sysex7_continue{}.group(3).data(to_u8(std::span{message}.subspan(6, 6))));
+  this->send(3, make_message(make_header(0x2222U), make_discovery(2)));
+  EXPECT_THAT(received_, ElementsAre(discovery_record{3, midi2::ci::muid{0x2222U}, 2}));
+}
+// NOLINTNEXTLINE
+TEST_F(UMPCIDemultiplexer, InterleavedGroups) {
+  auto const first = make_message(make_header(0x1111U), make_discovery(1));
+  auto const second = make_message(make_header(0x2222U), make_discovery(2));
+  std::vector<std::uint32_t> words;
+  midi2::ump::sysex7_packetizer p1{std::back_inserter(words), 1};
+  std::ranges::copy(first, p1.inserter());
+  p1.flush();
+  std::vector<std::uint32_t> words2;
+  midi2::ump::sysex7_packetizer p2{std::back_inserter(words2), 9};
+  std::ranges::copy(second, p2.inserter());
+  p2.flush();
+
+  // Feed the packets through a UMP dispatcher, alternating between the two groups.
+  struct config {
+    context_type context = 0;
+    midi2::ump::dispatcher_backend::utility_null<context_type> utility{};
+    midi2::ump::dispatcher_backend::system_null<context_type> system{};
+    midi2::ump::dispatcher_backend::m1cvm_null<context_type> m1cvm{};
+    demultiplexer_type& data64;
+    midi2::ump::dispatcher_backend::m2cvm_null<context_type> m2cvm{};
+    midi2::ump::dispatcher_backend::data128_null<context_type> data128{};
+    midi2::ump::dispatcher_backend::stream_null<context_type> stream{};
+    midi2::ump::dispatcher_backend::flex_data_null<context_type> flex{};
+  };
+  config c{.data64 = demux_};
+  midi2::ump::ump_dispatcher dispatcher{std::ref(c)};
+  for (auto index = std::size_t{0}; index < std::max(words.size(), words2.size()); index += 2) {
+    if (index < words.size()) {
+      dispatcher.dispatch(std::span{words}.subspan(index, 2));
+    }
+    if (index < words2.size()) {
+      dispatcher.dispatch(std::span{words2}.subspan(index, 2));
+    }
+  }
+  EXPECT_THAT(received_, ElementsAre(discovery_record{1, midi2::ci::muid{0x1111U}, 1},
+                                     discovery_record{9, midi2::ci::muid{0x2222U}, 2}));
+}
+// NOLINTNEXTLINE
+TEST_F(UMPCIDemultiplexer, NonCIMessagesAreIgnored) {
+  // A universal non-real-time General MIDI message (sub-ID #1 = 0x09) and a manufacturer-specific message.
+  constexpr auto gm_on = std::array{std::byte{0x7E}, std::byte{0x7F}, std::byte{0x09}, std::byte{0x01}};
+  constexpr auto manufacturer = std::array{std::byte{0x41}, std::byte{0x10}, std::byte{0x0D}, std::byte{0x70},
+                                           std::byte{0x02}, std::byte{0x00}, std::byte{0x00}, std::byte{0x00}};
+  this->send(0, gm_on);
+  this->send(0, manufacturer);
+  EXPECT_THAT(received_, IsEmpty());
+  EXPECT_EQ(unknown_, 0U);
+  // Packets which continue a message that was never started are ignored too.
+  demux_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(0).data({0x7E, 0x7F, 0x0D}));
+  EXPECT_EQ(unknown_, 0U);
+  this->send(0, make_message(make_header(0x1234U), make_discovery(3)));
+  EXPECT_THAT(received_, ElementsAre(discovery_record{0, midi2::ci::muid{0x1234U}, 3}));
+}
+
+using pool_type = midi2::ci::buffer_pool<64, 2>;
+using pool_base_config = midi2::ci::function_config<std::uint8_t, pool_type::buffer_size>;
+struct pooled_config : pool_base_config {
+  pool_type* buffer_pool = nullptr;
+};
+static_assert(midi2::ci::ci_dispatcher_pool_config<pooled_config>);
+using pooled_dispatcher = midi2::ci::ci_dispatcher<pooled_config>;
+using pooled_demultiplexer = midi2::ump::dispatcher_backend::ci_demultiplexer<context_type, pooled_dispatcher>;
+
+/// Creates a demultiplexer whose dispatchers share \p pool and record the group of each discovery message received.
+pooled_demultiplexer make_pooled_demultiplexer(pool_type& pool, std::vector<std::uint8_t>& received) {
+  return pooled_demultiplexer{[&pool, &received](std::uint8_t const group) {
+    pooled_config config{pool_base_config{group}};
+    config.buffer_pool = &pool;
+    config.management.on_discovery([&received](std::uint8_t const g, midi2::ci::header const&,
+                                               midi2::ci::discovery const&) { received.push_back(g); });
+    return pooled_dispatcher{midi2::ci::b7{0x7FU}, group, std::move(config)};
+  }};
+}
+
+// NOLINTNEXTLINE
+TEST(UMPCIDemultiplexerPool, TruncatedMessagesReleaseBuffers) {
+  pool_type pool;
+  std::vector<std::uint8_t> received;
+  auto demux = make_pooled_demultiplexer(pool, received);
+  auto const message = make_message(make_header(0x1111U), make_discovery(1));
+  auto const packet = [&message](std::size_t const index) { return to_u8(std::span{message}.subspan(index * 6U, 6)); };
+  // Each message ends after its header has been accepted (and a buffer taken) but before its body is complete.
+  for (auto group = std::uint8_t{0}; group < 4U; ++group) {
+    demux.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(group).data(packet(0)));
+    demux.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(packet(1)));
+    demux.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(packet(2)));
+    EXPECT_EQ(pool.in_use(), 1U);
+    demux.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(group).data(packet(3)));
+    EXPECT_EQ(pool.in_use(), 0U);
+  }
+  EXPECT_EQ(pool.exhausted(), 0U);
+  EXPECT_THAT(received, IsEmpty());
+}
+// NOLINTNEXTLINE
+TEST(UMPCIDemultiplexerPool, InterruptedMessagesReleaseBuffers) {
+  pool_type pool;
+  std::vector<std::uint8_t> received;
+  auto demux = make_pooled_demultiplexer(pool, received);
+  auto const message = make_message(make_header(0x1111U), make_discovery(1));
+  auto const packet = [&message](std::size_t const index) { return to_u8(std::span{message}.subspan(index * 6U, 6)); };
+  constexpr auto group = std::uint8_t{2};
+  // A MIDI-CI message whose header has been accepted is interrupted by a new message which is not MIDI-CI: first
+  // by a start packet, then by a complete single packet message.
+  demux.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(group).data(packet(0)));
+  demux.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(packet(1)));
+  demux.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(packet(2)));
+  EXPECT_EQ(pool.in_use(), 1U);
+  demux.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(group).data({0x7E, 0x7F, 0x09, 0x01}));
+  EXPECT_EQ(pool.in_use(), 0U);
+  demux.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(group).data({0x02}));
+
+  demux.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(group).data(packet(0)));
+  demux.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(packet(1)));
+  demux.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(group).data(packet(2)));
+  EXPECT_EQ(pool.in_use(), 1U);
+  demux.sysex7_in_1(0, midi2::ump::data64::sysex7_in_1{}.group(group).data({0x7E, 0x7F, 0x09, 0x01}));
+  EXPECT_EQ(pool.in_use(), 0U);
+  EXPECT_THAT(received, IsEmpty());
+}
+
+}  // end anonymous namespace
@@ -17,10 +17,15 @@
 
 // Standard library
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <functional>
+#include <iterator>
 #include <numeric>
+#include <span>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 // google mock/test/fuzz
 #include <gmock/gmock.h>
@@ -657,6 +662,50 @@ TEST_F(UMPDispatcher, PartialMessageThenClear) {
   dispatcher_.dispatch(std::uint32_t{get<0>(m1on)});
 }
 
+// NOLINTNEXTLINE
+TEST_F(UMPDispatcher, SpanOfMessages) {
+  constexpr auto m1on = midi2::ump::m1cvm::note_on{}.group(0).channel(1).note(60).velocity(0x43);
+  constexpr auto m2on = midi2::ump::m2cvm::note_on{}.group(0).channel(3).note(62).velocity(0x432);
+  constexpr auto sx = midi2::ump::data64::sysex7_in_1{}.group(0).number_of_bytes(2).data0(2).data1(3);
+  {
+    InSequence _;
+    EXPECT_CALL(config_.m1cvm, note_on(config_.context, m1on)).Times(1);
+    EXPECT_CALL(config_.m2cvm, note_on(config_.context, m2on)).Times(1);
+    EXPECT_CALL(config_.data64, sysex7_in_1(config_.context, sx)).Times(1);
+    EXPECT_CALL(config_.m1cvm, note_on(config_.context, m1on)).Times(1);
+  }
+  std::array const input{std::uint32_t{get<0>(m1on)}, std::uint32_t{get<0>(m2on)}, std::uint32_t{get<1>(m2on)},
+                         std::uint32_t{get<0>(sx)},   std::uint32_t{get<1>(sx)},   std::uint32_t{get<0>(m1on)}};
+  dispatcher_.dispatch(std::span{input});
+}
+
+// NOLINTNEXTLINE
+TEST_F(UMPDispatcher, SpanMessageSplitAcrossCalls) {
+  constexpr auto m2on = midi2::ump::m2cvm::note_on{}.group(0).channel(3).note(62).velocity(0x432);
+  constexpr auto m2off = midi2::ump::m2cvm::note_off{}.group(0).channel(3).note(62).velocity(0x1);
+  {
+    InSequence _;
+    EXPECT_CALL(config_.m2cvm, note_on(config_.context, m2on)).Times(1);
+    EXPECT_CALL(config_.m2cvm, note_off(config_.context, m2off)).Times(1);
+  }
+  std::array const input{std::uint32_t{get<0>(m2on)}, std::uint32_t{get<1>(m2on)}, std::uint32_t{get<0>(m2off)},
+                         std::uint32_t{get<1>(m2off)}};
+  // Split the input such that the second message straddles the two calls.
+  dispatcher_.dispatch(std::span{input}.first(3));
+  dispatcher_.dispatch(std::span{input}.subspan(3));
+  // An empty span does nothing.
+  dispatcher_.dispatch(std::span<std::uint32_t const>{});
+}
+
+// NOLINTNEXTLINE
+TEST_F(UMPDispatcher, SpanBadMessage) {
+  constexpr std::uint32_t message =
+      (std::to_underlying(midi2::ump::message_type::utility) << 28) | (std::uint32_t{0xF} << 20);
+  EXPECT_CALL(config_.utility, unknown(config_.context, ElementsAre(message)));
+  std::array const input{message};
+  dispatcher_.dispatch(std::span{input});
+}
+
 //*  _   _ __  __ ___   ___ _                       *
 //* | | | |  \/  | _ \ / __| |_ _ _ ___ __ _ _ __   *
 //* | |_| | |\/| |  _/ \__ \  _| '_/ -_) _` | '  \  *
@@ -961,15 +1010,28 @@ void UMPDispatcherNeverCrashes(std::vector<std::uint32_t> const& in) {
   midi2::ump::ump_dispatcher p{default_config{}};
   std::ranges::for_each(in, [&p](std::uint32_t ump) { p.dispatch(ump); });
 }
+void UMPDispatcherSpanNeverCrashes(std::vector<std::uint32_t> const& in, std::size_t split) {
+  midi2::ump::ump_dispatcher p{default_config{}};
+  auto const span = std::span{in};
+  split = std::min(split, span.size());
+  p.dispatch(span.first(split));
+  p.dispatch(span.subspan(split));
+}
 
 #if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
 // NOLINTNEXTLINE
 FUZZ_TEST(UMPDispatcherFuzz, UMPDispatcherNeverCrashes);
+// NOLINTNEXTLINE
+FUZZ_TEST(UMPDispatcherFuzz, UMPDispatcherSpanNeverCrashes);
 #endif
 // NOLINTNEXTLINE
 TEST(UMPDispatcherFuzz, Empty) {
   UMPDispatcherNeverCrashes({});
 }
+// NOLINTNEXTLINE
+TEST(UMPDispatcherFuzz, SpanEmpty) {
+  UMPDispatcherSpanNeverCrashes({}, 0);
+}
 
 template <midi2::ump::message_type MessageType> void process_message(std::span<std::uint32_t> message) {
   if (message.size() == midi2::ump::message_size<MessageType>::value) {
@@ -1028,6 +1090,271 @@ FUZZ_TEST(UMPDispatcherFuzz, stream);
 TEST(UMPDispatcherFuzz, UtilityMessage) {
   utility({});
 }
+/// Passes the words of \p message to \p dispatcher one at a time.
+template <typename Dispatcher, typename Message> void dispatch_words(Dispatcher& dispatcher, Message const& message) {
+  midi2::ump::apply(message, [&dispatcher](std::uint32_t const v) {
+    dispatcher.dispatch(v);
+    return false;
+  });
+}
+/// Appends the words of \p message to \p words.
+template <typename Message> void append(std::vector<std::uint32_t>& words, Message const& message) {
+  midi2::ump::apply(message, [&words](std::uint32_t const v) {
+    words.push_back(v);
+    return false;
+  });
+}
+
+// NOLINTNEXTLINE
+TEST(UMPDispatcherCompact, CallsInstalledCallbacks) {
+  auto dispatcher = midi2::ump::make_ump_compact_dispatcher<int>(3);
+  std::vector<std::pair<int, std::uint8_t>> notes;
+  dispatcher.config().m1cvm.on_note_on([&notes](int const context, midi2::ump::m1cvm::note_on const& on) {
+    notes.emplace_back(context, on.note());
+  });
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_on{}.note(60));
+  // A message with no installed callback is ignored.
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_off{}.note(60));
+  EXPECT_THAT(notes, ElementsAre(std::pair{3, std::uint8_t{60}}));
+}
+
+// NOLINTNEXTLINE
+TEST(UMPDispatcherOverload, CallsMatchingHandler) {
+  struct context_type {
+    std::vector<std::uint8_t> m2_notes;
+    std::vector<std::uint8_t> m1_notes;
+  } context;
+  auto dispatcher = midi2::ump::make_ump_dispatcher(
+      context, midi2::overloaded{
+                   [](context_type& c, midi2::ump::m2cvm::note_on const& on) { c.m2_notes.push_back(on.note()); },
+                   [](context_type& c, midi2::ump::m1cvm::note_off const& off) { c.m1_notes.push_back(off.note()); },
+               });
+  static_assert(sizeof(dispatcher.config()) == sizeof(context_type*));
+  // Only the categories for which the overload set has a handler are decoded.
+  static_assert(decltype(dispatcher)::handled_message_types ==
+                midi2::ump::message_type_mask(midi2::ump::message_type::m1cvm, midi2::ump::message_type::m2cvm));
+  dispatch_words(dispatcher, midi2::ump::m2cvm::note_on{}.note(60));
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_off{}.note(61));
+  // Messages without a matching handler are ignored.
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_on{}.note(62));
+  dispatch_words(dispatcher, midi2::ump::utility::noop{});
+  EXPECT_THAT(context.m2_notes, ElementsAre(60));
+  EXPECT_THAT(context.m1_notes, ElementsAre(61));
+}
+// NOLINTNEXTLINE
+TEST(UMPDispatcherOverload, ContextHeldByValue) {
+  // A context passed as an rvalue is owned by the dispatcher. Each handler must update that object, not a copy.
+  auto dispatcher = midi2::ump::make_ump_dispatcher(
+      std::vector<std::uint8_t>{},
+      midi2::overloaded{[](std::vector<std::uint8_t>& notes, midi2::ump::m2cvm::note_on const& on) {
+        notes.push_back(on.note());
+      }});
+  dispatch_words(dispatcher, midi2::ump::m2cvm::note_on{}.note(60));
+  dispatch_words(dispatcher, midi2::ump::m2cvm::note_on{}.note(61));
+  EXPECT_THAT(dispatcher.config().context, ElementsAre(60, 61));
+}
+// NOLINTNEXTLINE
+TEST(UMPDispatcherOverload, GenericHandlerSeesEveryMessage) {
+  auto count = 0;
+  auto dispatcher = midi2::ump::make_ump_dispatcher(&count, midi2::overloaded{[](int* c, auto const&) { ++*c; }});
+  static_assert(decltype(dispatcher)::handled_message_types == 0xFFFF);
+  dispatch_words(dispatcher, midi2::ump::utility::noop{});
+  dispatch_words(dispatcher, midi2::ump::system::timing_clock{});
+  dispatch_words(dispatcher, midi2::ump::m2cvm::pitch_bend{});
+  dispatch_words(dispatcher, midi2::ump::stream::end_of_clip{});
+  EXPECT_EQ(count, 4);
+}
+
+// NOLINTNEXTLINE
+TEST(UMPDispatcherBatch, ConsecutiveMessagesOfOneType) {
+  struct context_type {
+    std::vector<std::vector<std::uint8_t>> note_batches;
+    std::vector<std::uint8_t> controllers;
+  } context;
+  auto dispatcher = midi2::ump::make_ump_dispatcher(
+      context, midi2::overloaded{
+                   [](context_type& c, std::span<midi2::ump::m2cvm::note_on const> const notes) {
+                     auto& batch = c.note_batches.emplace_back();
+                     std::ranges::transform(notes, std::back_inserter(batch), [](auto const& on) { return on.note(); });
+                   },
+                   [](context_type& c, midi2::ump::m2cvm::control_change const& cc) {
+                     c.controllers.push_back(cc.controller());
+                   },
+               });
+  std::vector<std::uint32_t> words;
+  // A chord of ten notes, each on its own channel.
+  for (auto note = std::uint8_t{60}; note < 70U; ++note) {
+    append(words, midi2::ump::m2cvm::note_on{}.channel(note % 16U).note(note));
+  }
+  append(words, midi2::ump::m2cvm::control_change{}.controller(7));
+  append(words, midi2::ump::m2cvm::control_change{}.controller(10));
+  append(words, midi2::ump::m2cvm::note_on{}.note(72));
+  append(words, midi2::ump::m2cvm::note_on{}.note(76));
+  dispatcher.dispatch(std::span<std::uint32_t const>{words});
+  EXPECT_THAT(context.note_batches,
+              ElementsAre(ElementsAre(60, 61, 62, 63, 64, 65, 66, 67, 68, 69), ElementsAre(72, 76)));
+  EXPECT_THAT(context.controllers, ElementsAre(7, 10));
+
+  // Dispatching one word at a time passes each note in a batch of one.
+  context.note_batches.clear();
+  std::ranges::for_each(std::span{words}.last(4), [&dispatcher](std::uint32_t const w) { dispatcher.dispatch(w); });
+  EXPECT_THAT(context.note_batches, ElementsAre(ElementsAre(72), ElementsAre(76)));
+}
+// NOLINTNEXTLINE
+TEST(UMPDispatcherBatch, LongRunIsSplit) {
+  std::vector<std::size_t> sizes;
+  auto dispatcher = midi2::ump::make_ump_dispatcher(
+      &sizes, midi2::overloaded{[](std::vector<std::size_t>* const s,
+                                   std::span<midi2::ump::m1cvm::note_off const> const offs) {
+        s->push_back(offs.size());
+      }});
+  using dispatcher_type = decltype(dispatcher);
+  std::vector<std::uint32_t> words;
+  for (auto ctr = 0U; ctr < dispatcher_type::batch_size + 4U; ++ctr) {
+    append(words, midi2::ump::m1cvm::note_off{}.note(static_cast<std::uint8_t>(ctr)));
+  }
+  // The final message is incomplete and is held until the next call.
+  words.push_back(std::uint32_t{0x40900000});
+  dispatcher.dispatch(std::span<std::uint32_t const>{words});
+  EXPECT_THAT(sizes, ElementsAre(dispatcher_type::batch_size, 4U));
+}
+// NOLINTNEXTLINE
+TEST(UMPDispatcherBatch, GenericHandlerSeesEveryMessage) {
+  struct context_type {
+    int messages = 0;
+    int batches = 0;
+  } context;
+  // A catch-all would also accept a span: it must see each message rather than a batch.
+  auto dispatcher = midi2::ump::make_ump_dispatcher(
+      context, midi2::overloaded{
+                   [](context_type& c, auto const&) { ++c.messages; },
+                   [](context_type& c, std::span<midi2::ump::m2cvm::note_on const>) { ++c.batches; },
+               });
+  std::vector<std::uint32_t> words;
+  append(words, midi2::ump::m2cvm::note_on{}.note(60));
+  append(words, midi2::ump::m2cvm::note_on{}.note(64));
+  append(words, midi2::ump::m2cvm::note_on{}.note(67));
+  dispatcher.dispatch(std::span<std::uint32_t const>{words});
+  EXPECT_EQ(context.messages, 3);
+  EXPECT_EQ(context.batches, 0);
+}
+// NOLINTNEXTLINE
+TEST(UMPDispatcherBatch, LoneMessageIsDeliveredOnItsOwn) {
+  struct context_type {
+    std::vector<std::size_t> sizes;
+    int offs = 0;
+  } context;
+  auto dispatcher = midi2::ump::make_ump_dispatcher(
+      context, midi2::overloaded{
+                   [](context_type& c, std::span<midi2::ump::m2cvm::note_on const> const ons) {
+                     c.sizes.push_back(ons.size());
+                   },
+                   [](context_type& c, midi2::ump::m2cvm::note_off const&) { ++c.offs; },
+               });
+  std::vector<std::uint32_t> words;
+  append(words, midi2::ump::m2cvm::note_on{}.note(60));
+  append(words, midi2::ump::m2cvm::note_off{}.note(60));
+  append(words, midi2::ump::m2cvm::note_on{}.note(62));
+  dispatcher.dispatch(std::span<std::uint32_t const>{words});
+  EXPECT_THAT(context.sizes, ElementsAre(1U, 1U));
+  EXPECT_EQ(context.offs, 1);
+}
+
+/// A configuration which handles only the MIDI 2.0 channel voice messages: every other category is null.
+struct m2cvm_only_config {
+  explicit m2cvm_only_config(std::vector<std::uint8_t>* const c) : context{c} {}
+
+  std::vector<std::uint8_t>* context;
+  midi2::ump::dispatcher_backend::utility_null<decltype(context)> utility;
+  midi2::ump::dispatcher_backend::system_null<decltype(context)> system;
+  midi2::ump::dispatcher_backend::m1cvm_null<decltype(context)> m1cvm;
+  midi2::ump::dispatcher_backend::data64_null<decltype(context)> data64;
+  midi2::ump::dispatcher_backend::m2cvm_function<decltype(context)> m2cvm;
+  midi2::ump::dispatcher_backend::data128_null<decltype(context)> data128;
+  midi2::ump::dispatcher_backend::stream_null<decltype(context)> stream;
+  midi2::ump::dispatcher_backend::flex_data_null<decltype(context)> flex;
+};
+
+// NOLINTNEXTLINE
+TEST(UMPDispatcherMask, NullBackendsAreSkipped) {
+  using midi2::ump::message_type;
+  using dispatcher_type = midi2::ump::ump_dispatcher<m2cvm_only_config>;
+  static_assert(dispatcher_type::handled_message_types == midi2::ump::message_type_mask(message_type::m2cvm));
+  static_assert(dispatcher_type::handles(message_type::m2cvm));
+  static_assert(!dispatcher_type::handles(message_type::m1cvm));
+  static_assert(!dispatcher_type::handles(message_type::reserved32_06));
+  static_assert(midi2::ump::ump_dispatcher<midi2::ump::function_config<int>>::handled_message_types == 0xFFFF);
+
+  std::vector<std::uint8_t> notes;
+  dispatcher_type dispatcher{m2cvm_only_config{&notes}};
+  dispatcher.config().m2cvm.on_note_on(
+      [](std::vector<std::uint8_t>* const n, midi2::ump::m2cvm::note_on const& on) { n->push_back(on.note()); });
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_on{}.note(59));
+  dispatch_words(dispatcher, midi2::ump::m2cvm::note_on{}.note(60));
+  dispatch_words(dispatcher, midi2::ump::stream::end_of_clip{});
+  dispatch_words(dispatcher, midi2::ump::m2cvm::note_on{}.note(61));
+  // Ignored messages are still consumed: a reserved 64-bit message followed by a note.
+  std::array<std::uint32_t, 4> const words{0x80000000U, 0x00000000U, 0x40903E00U, 0x80000000U};
+  dispatcher.dispatch(std::span{words});
+  EXPECT_THAT(notes, ElementsAre(60, 61, 62));
+}
+/// A configuration with live utility and MIDI 2.0 channel voice backends: every other category is null.
+struct utility_m2cvm_config {
+  explicit utility_m2cvm_config(std::vector<std::uint32_t>* const c) : context{c} {}
+
+  std::vector<std::uint32_t>* context;
+  midi2::ump::dispatcher_backend::utility_function<decltype(context)> utility;
+  midi2::ump::dispatcher_backend::system_null<decltype(context)> system;
+  midi2::ump::dispatcher_backend::m1cvm_null<decltype(context)> m1cvm;
+  midi2::ump::dispatcher_backend::data64_null<decltype(context)> data64;
+  midi2::ump::dispatcher_backend::m2cvm_function<decltype(context)> m2cvm;
+  midi2::ump::dispatcher_backend::data128_null<decltype(context)> data128;
+  midi2::ump::dispatcher_backend::stream_null<decltype(context)> stream;
+  midi2::ump::dispatcher_backend::flex_data_null<decltype(context)> flex;
+};
+
+// NOLINTNEXTLINE
+TEST(UMPDispatcherMask, UnknownMessagesReachLiveUtility) {
+  using dispatcher_type = midi2::ump::ump_dispatcher<utility_m2cvm_config>;
+  // A live utility backend must see unknown messages of every category, so nothing is skipped.
+  static_assert(dispatcher_type::handled_message_types == 0xFFFF);
+
+  std::vector<std::uint32_t> unknown;
+  dispatcher_type dispatcher{utility_m2cvm_config{&unknown}};
+  dispatcher.config().utility.on_unknown(
+      [](std::vector<std::uint32_t>* const u, std::span<std::uint32_t> const m) { u->push_back(m[0]); });
+  // A MIDI 1.0 channel voice message with a known status goes to the null backend.
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_on{}.note(59));
+  // A MIDI 1.0 channel voice message with an undefined status, a system message with an undefined status, and a
+  // reserved 32-bit message.
+  std::array<std::uint32_t, 3> const words{0x20000000U, 0x10F40000U, 0x60000000U};
+  dispatcher.dispatch(std::span{words});
+  EXPECT_THAT(unknown, ElementsAre(0x20000000U, 0x10F40000U, 0x60000000U));
+}
+/// A function_config whose explicit mask limits delivery to MIDI 1.0 channel voice messages.
+struct m1cvm_mask_config : midi2::ump::function_config<int> {
+  using function_config::function_config;
+  static constexpr auto handled_message_types = midi2::ump::message_type_mask(midi2::ump::message_type::m1cvm);
+};
+
+// NOLINTNEXTLINE
+TEST(UMPDispatcherMask, ExplicitMask) {
+  using midi2::ump::message_type;
+  using dispatcher_type = midi2::ump::ump_dispatcher<m1cvm_mask_config>;
+  static_assert(dispatcher_type::handles(message_type::m1cvm));
+  static_assert(!dispatcher_type::handles(message_type::m2cvm));
+
+  std::vector<std::uint8_t> notes;
+  dispatcher_type dispatcher{m1cvm_mask_config{0}};
+  dispatcher.config().m1cvm.on_note_on(
+      [&notes](int, midi2::ump::m1cvm::note_on const& on) { notes.push_back(on.note()); });
+  dispatcher.config().m2cvm.on_note_on(
+      [&notes](int, midi2::ump::m2cvm::note_on const& on) { notes.push_back(on.note()); });
+  dispatch_words(dispatcher, midi2::ump::m1cvm::note_on{}.note(60));
+  dispatch_words(dispatcher, midi2::ump::m2cvm::note_on{}.note(61));
+  EXPECT_THAT(notes, ElementsAre(60));
+}
+
 // NOLINTNEXTLINE
 TEST(UMPDispatcherFuzz, SystemMessage) {
   system({});
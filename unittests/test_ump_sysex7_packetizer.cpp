@@ -0,0 +1,140 @@
+//===-- UMP Sysex7 Packetizer -------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ump/ump_sysex7_packetizer.hpp"
+
+// MIDI2
+#include "midi2/bytestream/bytestream_to_ump.hpp"
+#include "midi2/ci/ci_create_message.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
+#include <fuzztest/fuzztest.h>
+#endif
+
+namespace {
+
+using testing::ElementsAreArray;
+
+static_assert(std::output_iterator<midi2::ump::sysex7_packetizer<std::uint32_t*>::iterator, std::byte>);
+
+/// Converts the body of a system exclusive message to UMP using the bytestream translator.
+std::vector<std::uint32_t> via_bytestream(std::span<std::byte const> const body, std::uint8_t const group) {
+  midi2::bytestream::to_ump bs2ump{group};
+  std::vector<std::uint32_t> result;
+  auto const push = [&](std::byte const b) {
+    bs2ump.push(b);
+    while (!bs2ump.empty()) {
+      result.push_back(bs2ump.pop());
+    }
+  };
+  push(std::byte{0xF0});
+  for (auto const b : body) {
+    push(b);
+  }
+  push(std::byte{0xF7});
+  return result;
+}
+
+std::vector<std::uint32_t> via_packetizer(std::span<std::byte const> const body, std::uint8_t const group) {
+  std::vector<std::uint32_t> result;
+  midi2::ump::sysex7_packetizer packetizer{std::back_inserter(result), group};
+  std::ranges::copy(body, packetizer.inserter());
+  packetizer.flush();
+  return result;
+}
+
+void MatchesBytestreamToUmp(std::vector<std::uint8_t> const& input, std::uint8_t const group) {
+  std::vector<std::byte> body;
+  body.reserve(input.size());
+  std::ranges::transform(input, std::back_inserter(body),
+                         [](std::uint8_t const v) { return std::byte{v} & std::byte{0x7F}; });
+  EXPECT_THAT(via_packetizer(body, group & 0x0FU), ElementsAreArray(via_bytestream(body, group & 0x0FU)));
+}
+#if defined(MIDI2_FUZZTEST) && MIDI2_FUZZTEST
+// NOLINTNEXTLINE
+FUZZ_TEST(UMPSysex7Packetizer, MatchesBytestreamToUmp);
+#endif
+// NOLINTNEXTLINE
+TEST(UMPSysex7Packetizer, MatchesBytestreamToUmp) {
+  std::vector<std::uint8_t> input;
+  for (auto length = 0U; length <= 19U; ++length) {
+    MatchesBytestreamToUmp(input, static_cast<std::uint8_t>(length % 16U));
+    input.push_back(static_cast<std::uint8_t>(length + 1U));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(UMPSysex7Packetizer, EmptyMessage) {
+  std::vector<std::uint32_t> output;
+  midi2::ump::sysex7_packetizer packetizer{std::back_inserter(output)};
+  packetizer.flush();
+  EXPECT_THAT(output, ElementsAreArray(via_bytestream({}, 0)));
+}
+
+// NOLINTNEXTLINE
+TEST(UMPSysex7Packetizer, ConsecutiveMessages) {
+  std::vector<std::uint32_t> output;
+  midi2::ump::sysex7_packetizer packetizer{std::back_inserter(output), 3};
+  constexpr auto first = std::array{std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5},
+                                    std::byte{6}, std::byte{7}};
+  constexpr auto second = std::array{std::byte{8}, std::byte{9}};
+  std::ranges::copy(first, packetizer.inserter());
+  packetizer.flush();
+  std::ranges::copy(second, packetizer.inserter());
+  packetizer.flush();
+
+  auto expected = via_bytestream(first, 3);
+  auto const expected2 = via_bytestream(second, 3);
+  expected.insert(expected.end(), expected2.begin(), expected2.end());
+  EXPECT_THAT(output, ElementsAreArray(expected));
+}
+
+// NOLINTNEXTLINE
+TEST(UMPSysex7Packetizer, CreateMessage) {
+  constexpr midi2::ci::header hdr{.device_id = midi2::ci::b7{0x7FU},
+                                  .version = midi2::ci::b7{2U},
+                                  .remote_muid = midi2::ci::muid{0x01234567U},
+                                  .local_muid = midi2::ci::broadcast_muid};
+  using midi2::ci::b7;
+  constexpr midi2::ci::discovery discovery{.manufacturer = {b7{0x12U}, b7{0x23U}, b7{0x34U}},
+                                           .family = midi2::ci::b14{0x1779U},
+                                           .model = midi2::ci::b14{0x2B5DU},
+                                           .version = {b7{0x4EU}, b7{0x3CU}, b7{0x2AU}, b7{0x18U}},
+                                           .capability = b7{0x7FU},
+                                           .max_sysex_size = midi2::ci::b28{512U},
+                                           .output_path_id = b7{0x71U}};
+
+  // Write the message to a byte buffer and then convert it with the bytestream translator.
+  std::vector<std::byte> bytes;
+  midi2::ci::create_message(std::back_inserter(bytes), midi2::ci::trivial_sentinel{}, hdr, discovery);
+  auto const expected = via_bytestream(bytes, 0);
+
+  // Write the message directly to the packetizer.
+  std::vector<std::uint32_t> output;
+  midi2::ump::sysex7_packetizer packetizer{std::back_inserter(output)};
+  midi2::ci::create_message(packetizer.inserter(), midi2::ci::trivial_sentinel{}, hdr, discovery);
+  packetizer.flush();
+  EXPECT_THAT(output, ElementsAreArray(expected));
+}
+
+}  // end anonymous namespace
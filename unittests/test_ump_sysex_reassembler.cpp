@@ -0,0 +1,278 @@
+//===-- UMP Sysex Reassembler -------------------------------------------------*- C++ -*-===//
+//
+// midi2 library under the MIT license.
+// See https://github.com/paulhuggett/AM_MIDI2.0Lib/blob/main/LICENSE for license information.
+//
+// SPDX-FileCopyrightText: Copyright © 2025 Paul Bowen-Huggett
+// SPDX-License-Identifier: MIT
+//
+//===------------------------------------------------------------------------------------===//
+
+// DUT
+#include "midi2/ump/ump_sysex_reassembler.hpp"
+
+#include "midi2/ump/ump_dispatcher.hpp"
+
+// Standard library
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Google Test/Mock
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+using context_type = int;
+
+std::vector<std::uint8_t> to_vector(std::span<std::byte const> const message) {
+  std::vector<std::uint8_t> result;
+  result.reserve(message.size());
+  std::ranges::transform(message, std::back_inserter(result),
+                         [](std::byte const b) { return std::to_integer<std::uint8_t>(b); });
+  return result;
+}
+
+class Sysex7Reassembler : public testing::Test {
+protected:
+  Sysex7Reassembler() {
+    reassembler_.on_message([this](context_type, std::uint8_t const group, std::span<std::byte const> message) {
+      received_.emplace_back(group, to_vector(message));
+    });
+  }
+  midi2::ump::dispatcher_backend::sysex7_reassembler<context_type, 32> reassembler_;
+  std::vector<std::pair<std::uint8_t, std::vector<std::uint8_t>>> received_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(Sysex7Reassembler, InOne) {
+  reassembler_.sysex7_in_1(0, midi2::ump::data64::sysex7_in_1{}.group(3).data({1, 2, 3}));
+  ASSERT_EQ(received_.size(), 1U);
+  EXPECT_EQ(received_[0].first, 3U);
+  EXPECT_THAT(received_[0].second, ElementsAre(1, 2, 3));
+  EXPECT_EQ(reassembler_.overflows(), 0U);
+  EXPECT_EQ(reassembler_.truncations(), 0U);
+}
+// NOLINTNEXTLINE
+TEST_F(Sysex7Reassembler, StartContinueEnd) {
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(1).data({1, 2, 3, 4, 5, 6}));
+  reassembler_.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(1).data({7, 8, 9, 10, 11, 12}));
+  EXPECT_THAT(received_, IsEmpty());
+  reassembler_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(1).data({13, 14}));
+  ASSERT_EQ(received_.size(), 1U);
+  EXPECT_EQ(received_[0].first, 1U);
+  EXPECT_THAT(received_[0].second, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14));
+}
+// NOLINTNEXTLINE
+TEST_F(Sysex7Reassembler, InterleavedGroups) {
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(0).data({1, 2, 3}));
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(15).data({4, 5, 6}));
+  reassembler_.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(0).data({7, 8}));
+  reassembler_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(15).data({9}));
+  reassembler_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(0).data({10}));
+  ASSERT_EQ(received_.size(), 2U);
+  EXPECT_EQ(received_[0].first, 15U);
+  EXPECT_THAT(received_[0].second, ElementsAre(4, 5, 6, 9));
+  EXPECT_EQ(received_[1].first, 0U);
+  EXPECT_THAT(received_[1].second, ElementsAre(1, 2, 3, 7, 8, 10));
+}
+// NOLINTNEXTLINE
+TEST(Sysex7ReassemblerLong, InterleavedLongMessages) {
+  // Sixteen long messages whose packets alternate between the groups so that none is ever the most recently
+  // extended for more than one packet.
+  constexpr auto groups = 16U;
+  constexpr auto packets = 500U;
+  std::map<std::uint8_t, std::vector<std::uint8_t>> received;
+  // Allow for the last block of each message being partly used.
+  midi2::ump::dispatcher_backend::sysex7_reassembler<context_type, groups * (packets * 6 + 16)> reassembler;
+  reassembler.on_message([&received](context_type, std::uint8_t const group, std::span<std::byte const> message) {
+    received[group] = to_vector(message);
+  });
+  auto const value = [](unsigned group, unsigned packet, unsigned index) {
+    return static_cast<std::uint8_t>((group * 13U + packet * 6U + index) % 128U);
+  };
+  std::map<std::uint8_t, std::vector<std::uint8_t>> expected;
+  for (auto packet = 0U; packet < packets; ++packet) {
+    for (auto group = 0U; group < groups; ++group) {
+      std::array<std::uint8_t, 6> payload{};
+      for (auto index = 0U; index < payload.size(); ++index) {
+        payload[index] = value(group, packet, index);
+      }
+      auto const g = static_cast<std::uint8_t>(group);
+      if (packet == 0U) {
+        reassembler.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(g).data(payload));
+      } else if (packet == packets - 1U) {
+        reassembler.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(g).data(payload));
+      } else {
+        reassembler.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(g).data(payload));
+      }
+      auto& e = expected[g];
+      e.insert(e.end(), payload.begin(), payload.end());
+    }
+  }
+  EXPECT_EQ(reassembler.overflows(), 0U);
+  EXPECT_EQ(reassembler.truncations(), 0U);
+  EXPECT_EQ(received, expected);
+}
+// NOLINTNEXTLINE
+TEST_F(Sysex7Reassembler, Overflow) {
+  // The arena holds 32 bytes: a 37 byte message must be dropped.
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(0).data({1, 2, 3, 4, 5, 6}));
+  for (auto ctr = 0; ctr < 5; ++ctr) {
+    reassembler_.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(0).data({1, 2, 3, 4, 5, 6}));
+  }
+  reassembler_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(0).data({1}));
+  EXPECT_THAT(received_, IsEmpty());
+  EXPECT_EQ(reassembler_.overflows(), 1U);
+  EXPECT_EQ(reassembler_.truncations(), 0U);
+
+  // The space is recovered for the next message.
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(0).data({1, 2, 3, 4, 5, 6}));
+  reassembler_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(0).data({7, 8, 9, 10, 11, 12}));
+  ASSERT_EQ(received_.size(), 1U);
+  EXPECT_THAT(received_[0].second, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12));
+}
+// NOLINTNEXTLINE
+TEST_F(Sysex7Reassembler, Truncation) {
+  // A continue and an end without a start.
+  reassembler_.sysex7_continue(0, midi2::ump::data64::sysex7_continue{}.group(0).data({1}));
+  reassembler_.sysex7_end(0, midi2::ump::data64::sysex7_end{}.group(0).data({2}));
+  EXPECT_EQ(reassembler_.truncations(), 2U);
+  // A start interrupted by a second start and then by a complete message.
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(0).data({3}));
+  reassembler_.sysex7_start(0, midi2::ump::data64::sysex7_start{}.group(0).data({4}));
+  EXPECT_EQ(reassembler_.truncations(), 3U);
+  reassembler_.sysex7_in_1(0, midi2::ump::data64::sysex7_in_1{}.group(0).data({5}));
+  EXPECT_EQ(reassembler_.truncations(), 4U);
+  EXPECT_EQ(reassembler_.overflows(), 0U);
+  ASSERT_EQ(received_.size(), 1U);
+  EXPECT_THAT(received_[0].second, ElementsAre(5));
+}
+
+// NOLINTNEXTLINE
+TEST(Sysex8Reassembler, AllStreamsConcurrently) {
+  using key = std::pair<std::uint8_t, std::uint8_t>;
+  std::map<key, std::vector<std::uint8_t>> received;
+  // Each message in progress occupies at least one block of the arena.
+  midi2::ump::dispatcher_backend::sysex8_reassembler<context_type, 16 * 256 * 16> reassembler;
+  reassembler.on_message(
+      [&received](context_type, std::uint8_t const group, std::uint8_t const stream_id,
+                  std::span<std::byte const> message) { received[key{group, stream_id}] = to_vector(message); });
+
+  auto const value = [](unsigned group, unsigned stream_id, unsigned index) {
+    return static_cast<std::uint8_t>(group * 31U + stream_id * 7U + index);
+  };
+  for (auto part = 0U; part < 3U; ++part) {
+    for (auto group = 0U; group < 16U; ++group) {
+      for (auto stream_id = 0U; stream_id < 256U; ++stream_id) {
+        auto const v = value(group, stream_id, part);
+        auto const g = static_cast<std::uint8_t>(group);
+        auto const s = static_cast<std::uint8_t>(stream_id);
+        switch (part) {
+        case 0: reassembler.sysex8_start(0, midi2::ump::data128::sysex8_start{}.group(g).stream_id(s).data({v})); break;
+        case 1:
+          reassembler.sysex8_continue(0, midi2::ump::data128::sysex8_continue{}.group(g).stream_id(s).data({v}));
+          break;
+        default: reassembler.sysex8_end(0, midi2::ump::data128::sysex8_end{}.group(g).stream_id(s).data({v})); break;
+        }
+      }
+    }
+  }
+  EXPECT_EQ(reassembler.overflows(), 0U);
+  EXPECT_EQ(reassembler.truncations(), 0U);
+  ASSERT_EQ(received.size(), 16U * 256U);
+  for (auto const& [k, message] : received) {
+    EXPECT_THAT(message, ElementsAre(value(k.first, k.second, 0), value(k.first, k.second, 1),
+                                     value(k.first, k.second, 2)));
+  }
+}
+// NOLINTNEXTLINE
+TEST(Sysex8Reassembler, InterleavedWhenFull) {
+  // Four streams whose messages grow at different rates in an arena that is only just big enough to hold them. Each
+  // message needs three 16-byte blocks.
+  constexpr auto streams = 4U;
+  constexpr auto max_parts = 3U;
+  std::map<std::uint8_t, std::vector<std::uint8_t>> received;
+  midi2::ump::dispatcher_backend::sysex8_reassembler<context_type, streams * max_parts * 16> reassembler;
+  reassembler.on_message([&received](context_type, std::uint8_t, std::uint8_t const stream_id,
+                                     std::span<std::byte const> message) {
+    EXPECT_FALSE(received.contains(stream_id));
+    received[stream_id] = to_vector(message);
+  });
+
+  std::map<std::uint8_t, std::vector<std::uint8_t>> expected;
+  std::array<unsigned, streams> parts{};
+  auto next = std::uint8_t{0};
+  for (auto round = 0U; round < 200U; ++round) {
+    auto const stream_id = static_cast<std::uint8_t>((round * 7U + round / 5U) % streams);
+    auto const final = parts[stream_id] == max_parts - 1U;
+    std::array<std::uint8_t, 13> payload{};
+    for (auto& p : payload) {
+      p = next++;
+    }
+    auto& e = expected[stream_id];
+    if (parts[stream_id] == 0U) {
+      e.clear();
+      reassembler.sysex8_start(0, midi2::ump::data128::sysex8_start{}.stream_id(stream_id).data(payload));
+    } else if (final) {
+      reassembler.sysex8_end(0, midi2::ump::data128::sysex8_end{}.stream_id(stream_id).data(payload));
+    } else {
+      reassembler.sysex8_continue(0, midi2::ump::data128::sysex8_continue{}.stream_id(stream_id).data(payload));
+    }
+    e.insert(e.end(), payload.begin(), payload.end());
+    if (final) {
+      ASSERT_TRUE(received.contains(stream_id));
+      EXPECT_EQ(received[stream_id], e);
+      received.erase(stream_id);
+      parts[stream_id] = 0;
+    } else {
+      ++parts[stream_id];
+    }
+  }
+  EXPECT_EQ(reassembler.overflows(), 0U);
+  EXPECT_EQ(reassembler.truncations(), 0U);
+}
+
+// NOLINTNEXTLINE
+TEST(Sysex8Reassembler, Dispatcher) {
+  struct config {
+    context_type context = 0;
+    midi2::ump::dispatcher_backend::utility_null<context_type> utility;
+    midi2::ump::dispatcher_backend::system_null<context_type> system;
+    midi2::ump::dispatcher_backend::m1cvm_null<context_type> m1cvm;
+    midi2::ump::dispatcher_backend::sysex7_reassembler<context_type> data64;
+    midi2::ump::dispatcher_backend::m2cvm_null<context_type> m2cvm;
+    midi2::ump::dispatcher_backend::sysex8_reassembler<context_type> data128;
+    midi2::ump::dispatcher_backend::stream_null<context_type> stream;
+    midi2::ump::dispatcher_backend::flex_data_null<context_type> flex;
+  };
+  std::vector<std::uint8_t> received;
+  config c;
+  c.data128.on_message([&received](context_type, std::uint8_t, std::uint8_t, std::span<std::byte const> message) {
+    received = to_vector(message);
+  });
+  midi2::ump::ump_dispatcher<std::reference_wrapper<config>> dispatcher{std::ref(c)};
+
+  auto const dispatch = [&dispatcher](auto const& message) {
+    midi2::ump::apply(message, [&dispatcher](std::uint32_t const v) {
+      dispatcher.dispatch(v);
+      return false;
+    });
+  };
+  dispatch(midi2::ump::data128::sysex8_start{}.stream_id(1).data({1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13}));
+  dispatch(midi2::ump::data128::sysex8_end{}.stream_id(1).data({14, 15}));
+  EXPECT_THAT(received, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+}  // end anonymous namespace
@@ -14,7 +14,9 @@
 // Standard library
 #include <array>
 #include <cstdint>
+#include <iterator>
 #include <ranges>
+#include <span>
 #include <vector>
 
 // Google test
@@ -340,4 +342,35 @@ TEST(UMPToBytestream, Sysex) {
                   std::byte{0x00}, std::byte{0xF7}));
 }
 
+// NOLINTNEXTLINE
+TEST(UMPToBytestream, BulkTranslate) {
+  constexpr std::array input{std::uint32_t{0x20906040}, std::uint32_t{0x30167E7F}, std::uint32_t{0x0D70024B},
+                             std::uint32_t{0x3026607A}, std::uint32_t{0x737F7F7F}, std::uint32_t{0x30267F7D},
+                             std::uint32_t{0x00000000}, std::uint32_t{0x30360000}, std::uint32_t{0x10000000},
+                             std::uint32_t{0x20C64000}, std::uint32_t{0x10F80000}};
+  auto const expected = convert(input);
+
+  // Output to a span that is too small to hold the bytes produced by a single sysex7 packet.
+  midi2::bytestream::to_bytestream ump2bs;
+  std::vector<std::byte> actual;
+  std::array<std::byte, 2> buffer{};
+  std::span<std::uint32_t const> in{input};
+  do {
+    auto const result = midi2::translate(ump2bs, in, std::span{buffer});
+    auto const produced = std::span{buffer}.first(result.produced);
+    EXPECT_EQ(result.out, std::end(produced));
+    actual.insert(std::end(actual), std::begin(produced), std::end(produced));
+    in = in.subspan(result.consumed);
+  } while (!in.empty() || !ump2bs.empty());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+
+  // Output via an iterator.
+  midi2::bytestream::to_bytestream ump2bs2;
+  actual.clear();
+  auto const result = midi2::translate(ump2bs2, std::span{input}, std::back_inserter(actual));
+  EXPECT_EQ(result.consumed, input.size());
+  EXPECT_EQ(result.produced, expected.size());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+}
+
 }  // end anonymous namespace
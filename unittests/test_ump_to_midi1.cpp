@@ -9,6 +9,7 @@
 //===------------------------------------------------------------------------------------===//
 
 // DUT
+#include "midi2/translator.hpp"
 #include "midi2/ump/ump_to_midi1.hpp"
 #include "midi2/ump/ump_utils.hpp"
 
@@ -16,7 +17,9 @@
 #include <algorithm>
 #include <any>
 #include <array>
+#include <iterator>
 #include <ranges>
+#include <span>
 #include <vector>
 
 // Google Test/Mock
@@ -444,4 +447,42 @@ TEST(UMPToMIDI1, SystemMessagePassThrough) {
   EXPECT_THAT(input, ContainerEq(output));
 }
 
+// NOLINTNEXTLINE
+TEST(UMPToMIDI1, BulkTranslate) {
+  auto const [n0, n1] =
+      midi2::ump::m2cvm::note_on{}.group(0).channel(0).note(64).attribute_type(0).velocity(0xC104).attribute(0);
+  auto const [pc0, pc1] = midi2::ump::m2cvm::program_change{}
+                              .group(1)
+                              .channel(2)
+                              .option_flags(0)
+                              .bank_valid(true)
+                              .program(42)
+                              .bank_msb(3)
+                              .bank_lsb(4);
+  std::array const input{std::uint32_t{0x30167E7F}, std::uint32_t{0x0D70024B}, std::uint32_t{n0},
+                         std::uint32_t{n1},         std::uint32_t{0x10F80000}, std::uint32_t{pc0},
+                         std::uint32_t{pc1},        std::uint32_t{0x20816050}};
+  auto const expected = convert(input);
+
+  // Output to a span that is too small to hold the result of the program-change message in one go.
+  midi2::ump::to_midi1 ump2m1;
+  std::vector<std::uint32_t> actual;
+  std::array<std::uint32_t, 2> buffer{};
+  std::span<std::uint32_t const> in{input};
+  do {
+    auto const result = midi2::translate(ump2m1, in, std::span{buffer});
+    auto const produced = std::span{buffer}.first(result.produced);
+    actual.insert(std::end(actual), std::begin(produced), std::end(produced));
+    in = in.subspan(result.consumed);
+  } while (!in.empty() || !ump2m1.empty());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+
+  // Output via an iterator.
+  actual.clear();
+  auto const result = midi2::translate(ump2m1, std::span{input}, std::back_inserter(actual));
+  EXPECT_EQ(result.consumed, input.size());
+  EXPECT_EQ(result.produced, expected.size());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+}
+
 }  // end anonymous namespace
@@ -14,7 +14,9 @@
 
 // Standard Library
 #include <array>
+#include <iterator>
 #include <ranges>
+#include <span>
 #include <vector>
 
 // Google Test/Mock/Fuzz
@@ -431,6 +433,49 @@ TEST(UMPToMidi2PassThroughExtras, Text) {
   EXPECT_THAT(output, ElementsAreArray(input));
 }
 
+// NOLINTNEXTLINE
+TEST(UMPToMidi2, BulkTranslate) {
+  constexpr auto group = std::uint8_t{0x1};
+  constexpr auto channel = std::uint8_t{0xF};
+  std::vector<std::uint32_t> input;
+  auto const append = [&input](std::uint32_t v) {
+    input.push_back(v);
+    return false;
+  };
+  auto const cc = [] constexpr { return midi2::ump::m1cvm::control_change{}.group(group).channel(channel); };
+  midi2::ump::apply(midi2::ump::m1cvm::note_on{}.group(group).channel(channel).note(60).velocity(0x40), append);
+  midi2::ump::apply(cc().controller(midi2::ump::control::bank_select).value(0x71), append);
+  midi2::ump::apply(cc().controller(midi2::ump::control::bank_select_lsb).value(0x4E), append);
+  midi2::ump::apply(midi2::ump::m1cvm::program_change{}.group(group).channel(channel).program(0x55), append);
+  midi2::ump::apply(midi2::ump::m1cvm::pitch_bend{}.group(group).channel(channel).lsb_data(0x12).msb_data(0x34),
+                    append);
+  input.push_back(std::uint32_t{0x30167E7F});  // Sysex7 messages are passed through.
+  input.push_back(std::uint32_t{0x0D70024B});
+  auto const expected = convert(input);
+
+  // Output to a span that is too small to hold the two words of a single MIDI 2.0 message.
+  midi2::ump::ump_to_midi2 ump2m2{group};
+  std::vector<std::uint32_t> actual;
+  std::array<std::uint32_t, 1> buffer{};
+  std::span<std::uint32_t const> in{input};
+  do {
+    auto const result = midi2::translate(ump2m2, in, std::span{buffer});
+    auto const produced = std::span{buffer}.first(result.produced);
+    EXPECT_EQ(result.out, std::end(produced));
+    actual.insert(std::end(actual), std::begin(produced), std::end(produced));
+    in = in.subspan(result.consumed);
+  } while (!in.empty() || !ump2m2.empty());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+
+  // Output via an iterator.
+  midi2::ump::ump_to_midi2 ump2m2b{group};
+  actual.clear();
+  auto const result = midi2::translate(ump2m2b, std::span{input}, std::back_inserter(actual));
+  EXPECT_EQ(result.consumed, input.size());
+  EXPECT_EQ(result.produced, expected.size());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+}
+
 void NeverCrashes(std::uint8_t group, std::vector<std::uint32_t> const& packets) {
   if (group > 0xF) {
     return;
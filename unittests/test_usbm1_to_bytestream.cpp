@@ -15,7 +15,9 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <ranges>
+#include <span>
 #include <vector>
 
 // Google Test/Mock
@@ -23,6 +25,7 @@
 #include <gtest/gtest.h>
 
 using testing::ElementsAre;
+using testing::ElementsAreArray;
 using testing::IsEmpty;
 
 namespace {
@@ -143,4 +146,40 @@ TEST(USBM1ToByteStream, SysExThreeBytes) {
   EXPECT_THAT(actual, ElementsAre(std::byte{0xF0}, std::byte{0x7F}, std::byte{0xF7}));
 }
 
+// NOLINTNEXTLINE
+TEST(USBM1ToByteStream, BulkTranslate) {
+  constexpr auto cable = 0x3U;
+  constexpr auto events = std::array{
+      std::uint32_t{(cable << 28) | (9U << 24) | (0x90 << 16) | (0x46 << 8) | 0x3F},
+      std::uint32_t{(0x1U << 28) | (9U << 24) | (0x90 << 16) | (0x40 << 8) | 0x7F},  // Another cable: filtered.
+      std::uint32_t{(cable << 28) | (0x4U << 24) | (0xF0 << 16) | (0x00 << 8) | 0x01},
+      std::uint32_t{(cable << 28) | (0x7U << 24) | (0x02 << 16) | (0x03 << 8) | 0xF7},
+      std::uint32_t{(cable << 28) | (0xFU << 24) | (0xF8 << 16)},
+      std::uint32_t{(cable << 28) | (0xBU << 24) | (0xB0 << 16) | (0x07 << 8) | 0x64},
+  };
+  auto const expected = convert(cable, events);
+
+  // Output to a span that is too small to hold the three bytes of a single event.
+  midi2::bytestream::usbm1_to_bytestream m1_to_bs{cable};
+  std::vector<std::byte> actual;
+  std::array<std::byte, 2> buffer{};
+  std::span<std::uint32_t const> in{events};
+  do {
+    auto const result = midi2::translate(m1_to_bs, in, std::span{buffer});
+    auto const produced = std::span{buffer}.first(result.produced);
+    EXPECT_EQ(result.out, std::end(produced));
+    actual.insert(std::end(actual), std::begin(produced), std::end(produced));
+    in = in.subspan(result.consumed);
+  } while (!in.empty() || !m1_to_bs.empty());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+
+  // Output via an iterator.
+  midi2::bytestream::usbm1_to_bytestream m1_to_bs2{cable};
+  actual.clear();
+  auto const result = midi2::translate(m1_to_bs2, std::span{events}, std::back_inserter(actual));
+  EXPECT_EQ(result.consumed, events.size());
+  EXPECT_EQ(result.produced, expected.size());
+  EXPECT_THAT(actual, ElementsAreArray(expected));
+}
+
 }  // end anonymous namespace